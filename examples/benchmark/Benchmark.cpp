@@ -0,0 +1,267 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int width  = 1280;
+    const unsigned int height = 720;
+    const int          frames = 100;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Wait until the GPU has finished drawing, so that the
+/// measured time includes the rendering and not only the
+/// submission of the commands
+///
+////////////////////////////////////////////////////////////
+void finish(sf::RenderTexture& target)
+{
+    target.display();
+    target.getTexture().copyToImage();
+}
+
+
+////////////////////////////////////////////////////////////
+/// Print the number of items processed per second
+///
+////////////////////////////////////////////////////////////
+void report(const std::string& name, const std::string& unit, double count, sf::Time time)
+{
+    std::cout << std::setw(24) << name
+              << std::setw(14) << std::fixed << std::setprecision(0) << count / time.asSeconds() << " " << unit << "/s"
+              << std::setw(12) << std::setprecision(2) << time.asSeconds() * 1000.f << " ms" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Draw many individual sprites each frame
+///
+////////////////////////////////////////////////////////////
+void benchmarkSprites(sf::RenderTexture& target, const sf::Texture& texture)
+{
+    const int count = 2000;
+
+    sf::Sprite sprite(texture, sf::IntRect(0, 0, 32, 32));
+    sprite.setOrigin(16.f, 16.f);
+
+    finish(target);
+    sf::Clock clock;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        target.clear();
+        for (int i = 0; i < count; ++i)
+        {
+            sprite.setPosition(static_cast<float>((i * 37 + frame) % width), static_cast<float>((i * 53) % height));
+            sprite.setRotation(static_cast<float>(i + frame));
+            target.draw(sprite);
+        }
+    }
+    finish(target);
+
+    report("sprites", "sprites", static_cast<double>(count) * frames, clock.getElapsedTime());
+}
+
+
+////////////////////////////////////////////////////////////
+/// Draw lines of text each frame
+///
+////////////////////////////////////////////////////////////
+void benchmarkText(sf::RenderTexture& target, const sf::Font& font)
+{
+    const int lines = 30;
+    const std::string string = "The quick brown fox jumps over the lazy dog. 0123456789 PACK MY BOX WITH FIVE DOZEN JUGS";
+
+    sf::Text text(string, font, 20);
+    std::size_t glyphs = 0;
+    for (std::size_t i = 0; i < string.size(); ++i)
+    {
+        if (string[i] != ' ')
+            ++glyphs;
+    }
+
+    // Render the glyphs once, so that the benchmark doesn't measure the rasterization by FreeType
+    target.clear();
+    target.draw(text);
+    finish(target);
+
+    sf::Clock clock;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        target.clear();
+        for (int i = 0; i < lines; ++i)
+        {
+            // Changing the string forces the geometry of the text to be rebuilt, as in a HUD
+            text.setString(string.substr(i % 4));
+            text.setPosition(0.f, i * 24.f);
+            target.draw(text);
+        }
+    }
+    finish(target);
+
+    report("text", "glyphs", static_cast<double>(glyphs) * lines * frames, clock.getElapsedTime());
+}
+
+
+////////////////////////////////////////////////////////////
+/// Draw outlined circles, rectangles and convex shapes each frame
+///
+////////////////////////////////////////////////////////////
+void benchmarkShapes(sf::RenderTexture& target)
+{
+    const int count = 1000;
+
+    sf::CircleShape circle(12.f, 30);
+    circle.setFillColor(sf::Color(200, 100, 50));
+    circle.setOutlineThickness(2.f);
+    circle.setOutlineColor(sf::Color::White);
+
+    sf::RectangleShape rectangle(sf::Vector2f(24.f, 16.f));
+    rectangle.setFillColor(sf::Color(50, 100, 200));
+    rectangle.setOutlineThickness(1.f);
+
+    sf::ConvexShape convex(5);
+    convex.setPoint(0, sf::Vector2f(0.f, 0.f));
+    convex.setPoint(1, sf::Vector2f(20.f, 4.f));
+    convex.setPoint(2, sf::Vector2f(24.f, 18.f));
+    convex.setPoint(3, sf::Vector2f(10.f, 26.f));
+    convex.setPoint(4, sf::Vector2f(-4.f, 14.f));
+    convex.setFillColor(sf::Color(50, 200, 100, 192));
+
+    sf::Shape* shapes[] = {&circle, &rectangle, &convex};
+
+    finish(target);
+    sf::Clock clock;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        target.clear();
+        for (int i = 0; i < count; ++i)
+        {
+            sf::Shape& shape = *shapes[i % 3];
+            shape.setPosition(static_cast<float>((i * 41 + frame) % width), static_cast<float>((i * 29) % height));
+            target.draw(shape);
+        }
+    }
+    finish(target);
+
+    report("shapes", "shapes", static_cast<double>(count) * frames, clock.getElapsedTime());
+}
+
+
+////////////////////////////////////////////////////////////
+/// Upload pixels to textures, as done when streaming video
+/// frames or updating a texture atlas
+///
+////////////////////////////////////////////////////////////
+void benchmarkUploads(sf::RenderTexture& target, unsigned int size)
+{
+    const int count = 200;
+
+    std::vector<sf::Uint8> pixels(size * size * 4);
+    for (std::size_t i = 0; i < pixels.size(); ++i)
+        pixels[i] = static_cast<sf::Uint8>(i * 7);
+
+    sf::Texture texture;
+    if (!texture.create(size, size))
+        return;
+
+    // Draw the texture after each upload, so that the driver can't skip the uploads
+    sf::Sprite sprite(texture, sf::IntRect(0, 0, 1, 1));
+
+    finish(target);
+    sf::Clock clock;
+    for (int i = 0; i < count; ++i)
+    {
+        pixels[i] = static_cast<sf::Uint8>(i);
+        texture.update(&pixels[0]);
+        target.draw(sprite);
+    }
+    finish(target);
+
+    std::ostringstream name;
+    name << "texture uploads " << size << "x" << size;
+    report(name.str(), "uploads", count, clock.getElapsedTime());
+}
+
+
+////////////////////////////////////////////////////////////
+/// Alternate between two render textures, as done when
+/// rendering layers or effects in separate targets
+///
+////////////////////////////////////////////////////////////
+void benchmarkSwitches(sf::RenderTexture& target)
+{
+    const int count = 1000;
+
+    sf::RenderTexture layers[2];
+    if (!layers[0].create(256, 256) || !layers[1].create(256, 256))
+        return;
+
+    sf::RectangleShape rectangle(sf::Vector2f(16.f, 16.f));
+
+    finish(target);
+    sf::Clock clock;
+    for (int i = 0; i < count; ++i)
+    {
+        sf::RenderTexture& layer = layers[i % 2];
+        rectangle.setPosition(static_cast<float>(i % 240), 0.f);
+        layer.draw(rectangle);
+        layer.display();
+    }
+    finish(layers[0]);
+    finish(layers[1]);
+
+    report("render texture switches", "switches", count, clock.getElapsedTime());
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Everything is drawn off-screen, so that the results aren't limited
+    // by v-sync; set SFML_HEADLESS=1 to run without a display
+    sf::RenderTexture target;
+    if (!target.create(width, height))
+        return EXIT_FAILURE;
+
+    sf::Font font;
+    if (!font.loadFromFile("resources/sansation.ttf"))
+        return EXIT_FAILURE;
+
+    // A texture with a few 32x32 tiles for the sprites
+    sf::Image image;
+    image.create(128, 32, sf::Color::Transparent);
+    for (unsigned int y = 2; y < 30; ++y)
+        for (unsigned int x = 2; x < 126; ++x)
+            image.setPixel(x, y, sf::Color(x * 2, y * 8, 255 - x * 2));
+
+    sf::Texture texture;
+    if (!texture.loadFromImage(image))
+        return EXIT_FAILURE;
+
+    std::cout << "Rendering to a " << width << "x" << height << " render texture" << std::endl << std::endl;
+
+    benchmarkSprites(target, texture);
+    benchmarkText(target, font);
+    benchmarkShapes(target);
+    benchmarkUploads(target, 256);
+    benchmarkUploads(target, 1024);
+    benchmarkSwitches(target);
+
+    return EXIT_SUCCESS;
+}
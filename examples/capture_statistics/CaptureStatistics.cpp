@@ -0,0 +1,120 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+/// Recorder that only counts the samples it receives, so that
+/// the statistics measure the capture thread and not the
+/// processing done on the samples
+///
+////////////////////////////////////////////////////////////
+class CountingRecorder : public sf::SoundRecorder
+{
+public:
+
+    CountingRecorder(sf::Time interval) :
+    m_sampleCount(0)
+    {
+        setProcessingInterval(interval);
+    }
+
+    sf::Uint64 getSampleCount() const
+    {
+        return m_sampleCount;
+    }
+
+private:
+
+    virtual bool onProcessSamples(const sf::Int16*, std::size_t sampleCount)
+    {
+        m_sampleCount += sampleCount;
+        return true;
+    }
+
+    sf::Uint64 m_sampleCount;
+};
+
+
+////////////////////////////////////////////////////////////
+/// Print a millisecond value with a fixed width
+///
+////////////////////////////////////////////////////////////
+void printTime(const char* name, sf::Time time)
+{
+    std::cout << std::setw(14) << name << std::setw(10) << std::fixed << std::setprecision(2)
+              << time.asSeconds() * 1000.f << " ms" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Usage: capture-statistics [device [interval_ms [seconds]]]
+///
+/// Without a device name, the default capture device is used.
+/// On a machine without a microphone, OpenAL Soft can capture
+/// from a virtual source instead, for example the monitor of a
+/// PulseAudio null sink:
+///     pactl load-module module-null-sink sink_name=null
+///     ALSOFT_DRIVERS=pulse ./capture-statistics "Monitor of Null Output"
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    if (!sf::SoundRecorder::isAvailable())
+    {
+        std::cout << "Sorry, audio capture is not supported by your system" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string device = (argc > 1) ? argv[1] : sf::SoundRecorder::getDefaultDevice();
+    int intervalMs = (argc > 2) ? std::atoi(argv[2]) : 5;
+    float seconds = (argc > 3) ? static_cast<float>(std::atof(argv[3])) : 5.f;
+    if (intervalMs <= 0)
+        intervalMs = 5;
+    if (seconds <= 0.f)
+        seconds = 5.f;
+
+    std::vector<std::string> devices = sf::SoundRecorder::getAvailableDevices();
+    std::cout << "Capture devices:" << std::endl;
+    for (std::size_t i = 0; i < devices.size(); ++i)
+        std::cout << (devices[i] == device ? "  * " : "    ") << devices[i] << std::endl;
+    std::cout << std::endl;
+
+    CountingRecorder recorder(sf::milliseconds(intervalMs));
+    if (!recorder.setDevice(device))
+        return EXIT_FAILURE;
+
+    std::cout << "Capturing from \"" << device << "\" for " << seconds << " seconds, processed every "
+              << intervalMs << " ms" << std::endl << std::endl;
+
+    if (!recorder.start(44100))
+        return EXIT_FAILURE;
+
+    sf::sleep(sf::seconds(seconds));
+    recorder.stop();
+
+    sf::SoundRecorder::Statistics statistics = recorder.getStatistics();
+
+    std::cout << std::setw(14) << "samples"   << std::setw(10) << recorder.getSampleCount() << std::endl;
+    std::cout << std::setw(14) << "chunks"    << std::setw(10) << statistics.processedChunkCount << std::endl;
+    std::cout << std::setw(14) << "chunks/s"  << std::setw(10) << std::fixed << std::setprecision(1)
+              << statistics.processedChunkCount / seconds << std::endl;
+    std::cout << std::setw(14) << "overruns"  << std::setw(10) << statistics.overrunCount << std::endl;
+    printTime("latency", statistics.latency);
+    printTime("max latency", statistics.maxLatency);
+    printTime("jitter", statistics.jitter);
+    printTime("max jitter", statistics.maxJitter);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,304 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+
+namespace
+{
+    const unsigned int size = 256;
+    sf::Font           font;
+    sf::Texture        texture;
+}
+
+
+////////////////////////////////////////////////////////////
+// The reference scenes; each one covers a part of the renderer
+////////////////////////////////////////////////////////////
+void drawShapes(sf::RenderTarget& target)
+{
+    sf::CircleShape circle(50.f);
+    circle.setPosition(20.f, 20.f);
+    circle.setFillColor(sf::Color(200, 100, 50));
+    circle.setOutlineThickness(6.f);
+    circle.setOutlineColor(sf::Color::White);
+    target.draw(circle);
+
+    sf::RectangleShape rectangle(sf::Vector2f(100.f, 60.f));
+    rectangle.setPosition(180.f, 60.f);
+    rectangle.setOrigin(50.f, 30.f);
+    rectangle.setRotation(30.f);
+    rectangle.setFillColor(sf::Color(50, 100, 200));
+    target.draw(rectangle);
+
+    sf::ConvexShape convex(5);
+    convex.setPoint(0, sf::Vector2f(0.f, 0.f));
+    convex.setPoint(1, sf::Vector2f(120.f, 20.f));
+    convex.setPoint(2, sf::Vector2f(140.f, 90.f));
+    convex.setPoint(3, sf::Vector2f(60.f, 110.f));
+    convex.setPoint(4, sf::Vector2f(-20.f, 70.f));
+    convex.setPosition(60.f, 130.f);
+    convex.setFillColor(sf::Color(50, 200, 100, 160));
+    convex.setOutlineThickness(-3.f);
+    convex.setOutlineColor(sf::Color::Yellow);
+    target.draw(convex);
+}
+
+void drawSprites(sf::RenderTarget& target)
+{
+    sf::Sprite sprite(texture);
+    sprite.setPosition(10.f, 10.f);
+    target.draw(sprite);
+
+    sprite.setTextureRect(sf::IntRect(16, 16, 32, 32));
+    sprite.setPosition(150.f, 60.f);
+    sprite.setOrigin(16.f, 16.f);
+    sprite.setRotation(45.f);
+    sprite.setScale(2.f, 1.5f);
+    sprite.setColor(sf::Color(255, 128, 128, 200));
+    target.draw(sprite);
+
+    sprite.setTextureRect(sf::IntRect(64, 0, -64, 64));
+    sprite.setRotation(0.f);
+    sprite.setScale(1.f, 1.f);
+    sprite.setColor(sf::Color::White);
+    sprite.setPosition(190.f, 190.f);
+    target.draw(sprite);
+}
+
+void drawText(sf::RenderTarget& target)
+{
+    sf::Text text("Golden\nimages", font, 40);
+    text.setPosition(10.f, 10.f);
+    target.draw(text);
+
+    text.setString("Styled text");
+    text.setCharacterSize(24);
+    text.setStyle(sf::Text::Bold | sf::Text::Underlined);
+    text.setFillColor(sf::Color::Cyan);
+    text.setOutlineColor(sf::Color::Blue);
+    text.setOutlineThickness(2.f);
+    text.setPosition(10.f, 130.f);
+    target.draw(text);
+
+    text.setString("Rotated");
+    text.setStyle(sf::Text::Italic);
+    text.setOutlineThickness(0.f);
+    text.setRotation(-20.f);
+    text.setPosition(60.f, 230.f);
+    target.draw(text);
+}
+
+void drawVertices(sf::RenderTarget& target)
+{
+    sf::VertexArray triangles(sf::Triangles, 3);
+    triangles[0] = sf::Vertex(sf::Vector2f(20.f, 20.f), sf::Color::Red);
+    triangles[1] = sf::Vertex(sf::Vector2f(230.f, 40.f), sf::Color::Green);
+    triangles[2] = sf::Vertex(sf::Vector2f(100.f, 200.f), sf::Color::Blue);
+    target.draw(triangles);
+
+    sf::VertexArray strip(sf::LineStrip, 5);
+    for (std::size_t i = 0; i < strip.getVertexCount(); ++i)
+        strip[i] = sf::Vertex(sf::Vector2f(20.f + i * 50.f, (i % 2) ? 220.f : 240.f), sf::Color::White);
+    target.draw(strip);
+
+    sf::VertexArray points(sf::Points, 16);
+    for (std::size_t i = 0; i < points.getVertexCount(); ++i)
+        points[i] = sf::Vertex(sf::Vector2f(200.5f + (i % 4) * 10.f, 150.5f + (i / 4) * 10.f), sf::Color::Yellow);
+    target.draw(points);
+}
+
+void drawBlending(sf::RenderTarget& target)
+{
+    const sf::BlendMode modes[] = {sf::BlendAlpha, sf::BlendAdd, sf::BlendMultiply, sf::BlendNone};
+
+    sf::RectangleShape background(sf::Vector2f(size, size / 2.f));
+    background.setFillColor(sf::Color(100, 150, 200));
+    target.draw(background);
+
+    sf::CircleShape circle(28.f);
+    circle.setFillColor(sf::Color(255, 100, 0, 128));
+    for (std::size_t i = 0; i < sizeof(modes) / sizeof(*modes); ++i)
+    {
+        circle.setPosition(i * 64.f + 4.f, 100.f);
+        target.draw(circle, modes[i]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Render a scene to an image
+///
+////////////////////////////////////////////////////////////
+bool render(void (*scene)(sf::RenderTarget&), sf::Image& image)
+{
+    sf::RenderTexture target;
+    if (!target.create(size, size))
+        return false;
+
+    target.clear(sf::Color(32, 32, 32));
+    scene(target);
+    target.display();
+
+    image = target.getTexture().copyToImage();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Compare an image with its reference
+///
+/// Renderers don't all rasterize the edges of the primitives
+/// exactly the same way, so a pixel only differs when one of
+/// its components differs by more than \a tolerance, and the
+/// images only differ when more than 0.5% of their pixels do.
+///
+/// \return True if the images match
+///
+////////////////////////////////////////////////////////////
+bool compare(const sf::Image& image, const sf::Image& reference, int tolerance, sf::Image& difference)
+{
+    if (image.getSize() != reference.getSize())
+    {
+        std::cout << "size " << image.getSize().x << "x" << image.getSize().y << " instead of "
+                  << reference.getSize().x << "x" << reference.getSize().y;
+        difference = image;
+        return false;
+    }
+
+    difference.create(image.getSize().x, image.getSize().y, sf::Color::Black);
+
+    const sf::Uint8* pixels = image.getPixelsPtr();
+    const sf::Uint8* expected = reference.getPixelsPtr();
+    unsigned int count = image.getSize().x * image.getSize().y;
+    unsigned int mismatches = 0;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            if (std::abs(pixels[i * 4 + c] - expected[i * 4 + c]) > tolerance)
+            {
+                difference.setPixel(i % image.getSize().x, i / image.getSize().x, sf::Color::Red);
+                ++mismatches;
+                break;
+            }
+        }
+    }
+
+    std::cout << mismatches << " pixels differ";
+    return mismatches * 200 <= count;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // --update stores the rendered images as the new references,
+    // --tolerance N sets the largest accepted difference per component
+    bool update = false;
+    int tolerance = 8;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        if (argument == "--update")
+        {
+            update = true;
+        }
+        else if ((argument == "--tolerance") && (i + 1 < argc))
+        {
+            tolerance = std::atoi(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--update] [--tolerance N]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!font.loadFromFile("resources/sansation.ttf"))
+        return EXIT_FAILURE;
+
+    // A checkerboard with a transparent border, to check filtering and alpha
+    sf::Image image;
+    image.create(64, 64, sf::Color::Transparent);
+    for (unsigned int y = 4; y < 60; ++y)
+        for (unsigned int x = 4; x < 60; ++x)
+            image.setPixel(x, y, ((x / 8 + y / 8) % 2) ? sf::Color(240, 200, 40) : sf::Color(40, 80, 240, 192));
+
+    if (!texture.loadFromImage(image))
+        return EXIT_FAILURE;
+
+    struct Scene
+    {
+        const char* name;
+        void (*draw)(sf::RenderTarget&);
+    };
+
+    const Scene scenes[] =
+    {
+        {"shapes",   drawShapes},
+        {"sprites",  drawSprites},
+        {"text",     drawText},
+        {"vertices", drawVertices},
+        {"blending", drawBlending}
+    };
+
+    int failures = 0;
+    for (std::size_t i = 0; i < sizeof(scenes) / sizeof(*scenes); ++i)
+    {
+        std::string name = scenes[i].name;
+        std::string referencePath = "resources/" + name + ".png";
+
+        std::cout << name << ": ";
+
+        sf::Image rendered;
+        if (!render(scenes[i].draw, rendered))
+        {
+            std::cout << "FAILED (can't create the render texture)" << std::endl;
+            ++failures;
+            continue;
+        }
+
+        if (update)
+        {
+            bool saved = rendered.saveToFile(referencePath);
+            std::cout << (saved ? "reference updated" : "FAILED (can't save the reference)") << std::endl;
+            failures += saved ? 0 : 1;
+            continue;
+        }
+
+        sf::Image reference;
+        if (!reference.loadFromFile(referencePath))
+        {
+            std::cout << "FAILED (no reference, run with --update to create it)" << std::endl;
+            ++failures;
+            continue;
+        }
+
+        sf::Image difference;
+        if (compare(rendered, reference, tolerance, difference))
+        {
+            std::cout << ", passed" << std::endl;
+        }
+        else
+        {
+            // Keep the rendered image and the differences, to inspect them
+            rendered.saveToFile(name + "-actual.png");
+            difference.saveToFile(name + "-difference.png");
+            std::cout << ", FAILED (see " << name << "-actual.png and " << name << "-difference.png)" << std::endl;
+            ++failures;
+        }
+    }
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int width  = 3840;
+    const unsigned int height = 2160;
+
+    sf::Image                overlay;
+    std::vector<sf::Uint8>   bgraPixels(width * height * 4);
+    std::vector<sf::Uint16>  rgb565Pixels(width * height);
+    std::vector<sf::Image>   mipLevels;
+}
+
+
+////////////////////////////////////////////////////////////
+// The operations to measure; each one receives a fresh copy
+// of the source image
+////////////////////////////////////////////////////////////
+void copyOpaque(sf::Image& image)       {image.copy(overlay, 0, 0);}
+void copyBlended(sf::Image& image)      {image.copy(overlay, 0, 0, sf::IntRect(0, 0, 0, 0), true);}
+void createMask(sf::Image& image)       {image.createMaskFromColor(sf::Color(255, 0, 255));}
+void flipHorizontally(sf::Image& image) {image.flipHorizontally();}
+void flipVertically(sf::Image& image)   {image.flipVertically();}
+void premultiply(sf::Image& image)      {image.premultiplyAlpha();}
+void unpremultiply(sf::Image& image)    {image.unpremultiplyAlpha();}
+void toBgra(sf::Image& image)           {image.copyToBgra(&bgraPixels[0]);}
+void fromBgra(sf::Image& image)         {image.createFromBgra(width, height, &bgraPixels[0]);}
+void toRgb565(sf::Image& image)         {image.copyToRgb565(&rgb565Pixels[0]);}
+void fromRgb565(sf::Image& image)       {image.createFromRgb565(width, height, &rgb565Pixels[0]);}
+void resizeBox(sf::Image& image)        {image.resize(width / 2, height / 2, sf::Image::Box);}
+void resizeBilinear(sf::Image& image)   {image.resize(width / 2, height / 2, sf::Image::Bilinear);}
+void resizeLanczos(sf::Image& image)    {image.resize(width / 2, height / 2, sf::Image::Lanczos);}
+void buildMipChain(sf::Image& image)    {image.buildMipChain(mipLevels);}
+
+
+////////////////////////////////////////////////////////////
+/// Run an operation several times and print its average
+/// duration and the number of source pixels processed per second
+///
+////////////////////////////////////////////////////////////
+void benchmark(const char* name, void (*operation)(sf::Image&), const sf::Image& source, int runs)
+{
+    sf::Time total;
+
+    for (int i = 0; i < runs; ++i)
+    {
+        sf::Image image = source;
+
+        sf::Clock clock;
+        operation(image);
+        total += clock.getElapsedTime();
+    }
+
+    float seconds = total.asSeconds() / runs;
+
+    std::cout << std::setw(20) << name
+              << std::setw(10) << std::fixed << std::setprecision(2) << seconds * 1000.f << " ms"
+              << std::setw(10) << std::setprecision(1) << width * height / seconds / 1000000.f << " Mpixels/s" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // The number of runs of each operation can be given on the command line
+    int runs = (argc > 1) ? std::atoi(argv[1]) : 0;
+    if (runs <= 0)
+        runs = 10;
+
+    // A source image with a gradient and some transparency, and a
+    // semi-transparent overlay of the same size to blend onto it
+    std::vector<sf::Uint8> pixels(width * height * 4);
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            sf::Uint8* pixel = &pixels[(x + y * width) * 4];
+            pixel[0] = static_cast<sf::Uint8>(x);
+            pixel[1] = static_cast<sf::Uint8>(y);
+            pixel[2] = static_cast<sf::Uint8>(x + y);
+            pixel[3] = static_cast<sf::Uint8>((x / 16) % 2 ? 255 : x * y);
+        }
+    }
+
+    sf::Image source;
+    source.create(width, height, &pixels[0]);
+    overlay.create(width, height, sf::Color(255, 0, 255, 128));
+
+    std::cout << "Processing " << width << "x" << height << " images, average of " << runs << " runs" << std::endl;
+
+    std::cout << std::endl << "Pixel operations" << std::endl;
+    benchmark("copy",                copyOpaque,       source, runs);
+    benchmark("copy (alpha)",        copyBlended,      source, runs);
+    benchmark("createMaskFromColor", createMask,       source, runs);
+    benchmark("flipHorizontally",    flipHorizontally, source, runs);
+    benchmark("flipVertically",      flipVertically,   source, runs);
+    benchmark("premultiplyAlpha",    premultiply,      source, runs);
+    benchmark("unpremultiplyAlpha",  unpremultiply,    source, runs);
+    benchmark("copyToBgra",          toBgra,           source, runs);
+    benchmark("createFromBgra",      fromBgra,         source, runs);
+    benchmark("copyToRgb565",        toRgb565,         source, runs);
+    benchmark("createFromRgb565",    fromRgb565,       source, runs);
+
+    // Resampling is spread over the thread pool, so measure it with
+    // a single thread and with the default number of threads
+    unsigned int threadCount = sf::Image::getThreadCount();
+    unsigned int counts[] = {1, threadCount};
+    for (std::size_t i = 0; i < (threadCount > 1 ? 2u : 1u); ++i)
+    {
+        sf::Image::setThreadCount(counts[i]);
+
+        std::cout << std::endl << "Resampling, " << counts[i] << " thread(s)" << std::endl;
+        benchmark("resize (Box)",      resizeBox,      source, runs);
+        benchmark("resize (Bilinear)", resizeBilinear, source, runs);
+        benchmark("resize (Lanczos)",  resizeLanczos,  source, runs);
+        benchmark("buildMipChain",     buildMipChain,  source, runs);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+/// Build the data of a typical game state packet: entity
+/// records with small, repetitive values, which compress well
+///
+////////////////////////////////////////////////////////////
+std::vector<char> makeGameState(std::size_t size)
+{
+    sf::Packet packet;
+    for (sf::Uint32 entity = 0; packet.getDataSize() < size; ++entity)
+        packet << entity << static_cast<float>(entity % 64) * 16.f << 240.f << sf::Uint8(entity % 4) << "idle";
+
+    const char* data = static_cast<const char*>(packet.getData());
+    return std::vector<char>(data, data + size);
+}
+
+
+////////////////////////////////////////////////////////////
+/// Build random data, which can't be compressed (like data
+/// that is already compressed, such as images or sounds)
+///
+////////////////////////////////////////////////////////////
+std::vector<char> makeRandom(std::size_t size)
+{
+    std::vector<char> data(size);
+    for (std::size_t i = 0; i < size; ++i)
+        data[i] = static_cast<char>(std::rand());
+
+    return data;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Encode and decode the data many times with a pipeline, and
+/// print the time per packet and the bytes saved on the wire
+///
+////////////////////////////////////////////////////////////
+void benchmark(const std::string& name, sf::PacketPipeline& pipeline, const std::vector<char>& data)
+{
+    const int runs = 20000;
+    std::vector<char> encoded;
+
+    sf::Clock clock;
+    for (int i = 0; i < runs; ++i)
+        pipeline.encode(&data[0], data.size(), encoded);
+    sf::Time encodeTime = clock.getElapsedTime();
+
+    const char* decoded = NULL;
+    std::size_t decodedSize = 0;
+    bool valid = true;
+    clock.restart();
+    for (int i = 0; i < runs; ++i)
+        valid = pipeline.decode(&encoded[0], encoded.size(), decoded, decodedSize) && valid;
+    sf::Time decodeTime = clock.getElapsedTime();
+
+    long saved = static_cast<long>(data.size()) - static_cast<long>(encoded.size());
+
+    std::cout << std::setw(26) << name
+              << std::setw(8) << data.size()
+              << std::setw(8) << encoded.size()
+              << std::setw(8) << saved
+              << std::setw(10) << std::fixed << std::setprecision(2) << encodeTime.asMicroseconds() / static_cast<float>(runs)
+              << std::setw(10) << decodeTime.asMicroseconds() / static_cast<float>(runs);
+
+    if (!valid || (decodedSize != data.size()) || !std::equal(data.begin(), data.end(), decoded))
+        std::cout << "  (decoded data doesn't match)";
+
+    std::cout << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // The key would normally be exchanged or derived when the peers connect
+    char key[sf::PacketCipher::KeySize];
+    for (std::size_t i = 0; i < sizeof(key); ++i)
+        key[i] = static_cast<char>(i * 13 + 7);
+
+    sf::PacketCompressor compressor;
+    sf::PacketCipher cipher(key);
+
+    sf::PacketPipeline compression;
+    compression.add(compressor);
+
+    sf::PacketPipeline encryption;
+    encryption.add(cipher);
+
+    sf::PacketPipeline both;
+    both.add(compressor);
+    both.add(cipher);
+
+    const std::size_t sizes[] = {32, 256, 1400, 16384};
+
+    std::cout << std::setw(26) << "pipeline" << "    size encoded   saved encode us decode us" << std::endl;
+
+    for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+    {
+        std::vector<char> gameState = makeGameState(sizes[i]);
+        std::vector<char> random = makeRandom(sizes[i]);
+
+        benchmark("LZ4, game state",          compression, gameState);
+        benchmark("LZ4, random",              compression, random);
+        benchmark("cipher",                   encryption,  gameState);
+        benchmark("LZ4 + cipher, game state", both,        gameState);
+        std::cout << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
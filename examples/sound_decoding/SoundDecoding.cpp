@@ -0,0 +1,357 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int sampleRate   = 48000;
+    const unsigned int channelCount = 2;
+    const std::size_t  chunkSize    = 4096;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Append a little-endian integer to a byte array
+///
+////////////////////////////////////////////////////////////
+void appendInteger(std::vector<char>& data, sf::Uint32 value, std::size_t bytes)
+{
+    for (std::size_t i = 0; i < bytes; ++i)
+        data.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+}
+
+
+////////////////////////////////////////////////////////////
+/// Build a PCM WAV file in memory, with a tone encoded with
+/// the given number of bits per sample
+///
+////////////////////////////////////////////////////////////
+std::vector<char> makeWav(unsigned int bitsPerSample, float seconds)
+{
+    std::size_t sampleCount = static_cast<std::size_t>(seconds * sampleRate) * channelCount;
+    std::size_t bytesPerSample = bitsPerSample / 8;
+    std::size_t dataSize = sampleCount * bytesPerSample;
+
+    std::vector<char> data;
+    data.reserve(44 + dataSize);
+
+    // RIFF header and format chunk
+    data.insert(data.end(), "RIFF", "RIFF" + 4);
+    appendInteger(data, static_cast<sf::Uint32>(36 + dataSize), 4);
+    data.insert(data.end(), "WAVEfmt ", "WAVEfmt " + 8);
+    appendInteger(data, 16, 4);
+    appendInteger(data, 1, 2);
+    appendInteger(data, channelCount, 2);
+    appendInteger(data, sampleRate, 4);
+    appendInteger(data, static_cast<sf::Uint32>(sampleRate * channelCount * bytesPerSample), 4);
+    appendInteger(data, static_cast<sf::Uint32>(channelCount * bytesPerSample), 2);
+    appendInteger(data, bitsPerSample, 2);
+
+    // Samples; 8-bit samples are unsigned, the others are signed
+    data.insert(data.end(), "data", "data" + 4);
+    appendInteger(data, static_cast<sf::Uint32>(dataSize), 4);
+    for (std::size_t i = 0; i < sampleCount; ++i)
+    {
+        double value = 0.8 * std::sin(2.0 * 3.141592654 * 440.0 * (i / channelCount) / sampleRate);
+        double scale = std::pow(2.0, static_cast<double>(bitsPerSample - 1)) - 1.0;
+        sf::Int32 sample = static_cast<sf::Int32>(value * scale);
+        appendInteger(data, static_cast<sf::Uint32>(bitsPerSample == 8 ? sample + 128 : sample), bytesPerSample);
+    }
+
+    return data;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Decode a whole file several times, and return the time
+/// spent per decoding
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+sf::Time decode(const std::vector<char>& file, int runs)
+{
+    std::vector<T> samples(chunkSize);
+    sf::Time total;
+
+    for (int i = 0; i < runs; ++i)
+    {
+        sf::InputSoundFile input;
+        if (!input.openFromMemory(&file[0], file.size()))
+            return sf::Time::Zero;
+
+        sf::Clock clock;
+        while (input.read(&samples[0], samples.size()) > 0)
+        {
+        }
+        total += clock.getElapsedTime();
+    }
+
+    return total / static_cast<sf::Int64>(runs);
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the speed of the WAV reader for each sample size
+///
+////////////////////////////////////////////////////////////
+void benchmarkWav(float seconds, int runs)
+{
+    std::cout << "Decoding " << seconds << " seconds of " << channelCount << " channels WAV at "
+              << sampleRate << " Hz to 16-bit samples" << std::endl << std::endl;
+    std::cout << "  bits      MB/s     realtime" << std::endl;
+
+    const unsigned int bitDepths[] = {8, 16, 24, 32};
+    for (std::size_t i = 0; i < sizeof(bitDepths) / sizeof(*bitDepths); ++i)
+    {
+        std::vector<char> file = makeWav(bitDepths[i], seconds);
+        float time = decode<sf::Int16>(file, runs).asSeconds();
+
+        std::cout << std::setw(6) << bitDepths[i]
+                  << std::setw(10) << std::fixed << std::setprecision(0) << (file.size() - 44) / time / (1024.f * 1024.f)
+                  << std::setw(12) << seconds / time << "x" << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Decode a whole file to 16-bit samples and convert them to
+/// floats, as a floating point DSP chain had to do before
+/// the readers could decode to floats directly
+///
+////////////////////////////////////////////////////////////
+sf::Time decodeAndConvert(const std::vector<char>& file, int runs)
+{
+    std::vector<sf::Int16> samples(chunkSize);
+    std::vector<float> converted(chunkSize);
+    sf::Time total;
+
+    for (int i = 0; i < runs; ++i)
+    {
+        sf::InputSoundFile input;
+        if (!input.openFromMemory(&file[0], file.size()))
+            return sf::Time::Zero;
+
+        sf::Clock clock;
+        while (sf::Uint64 count = input.read(&samples[0], samples.size()))
+        {
+            for (std::size_t j = 0; j < count; ++j)
+                converted[j] = samples[j] / 32768.f;
+        }
+        total += clock.getElapsedTime();
+    }
+
+    return total / static_cast<sf::Int64>(runs);
+}
+
+
+////////////////////////////////////////////////////////////
+/// Compare the cost of getting float samples through the
+/// 16-bit path and through the float path
+///
+////////////////////////////////////////////////////////////
+void benchmarkFloat(float seconds, int runs)
+{
+    std::cout << "Decoding " << seconds << " seconds of " << channelCount << " channels WAV at "
+              << sampleRate << " Hz to float samples" << std::endl << std::endl;
+    std::cout << "  bits   Int16 + convert   read(float)     saved" << std::endl;
+
+    const unsigned int bitDepths[] = {8, 16, 24, 32};
+    for (std::size_t i = 0; i < sizeof(bitDepths) / sizeof(*bitDepths); ++i)
+    {
+        std::vector<char> file = makeWav(bitDepths[i], seconds);
+        float converted = decodeAndConvert(file, runs).asSeconds() * 1000.f;
+        float direct = decode<float>(file, runs).asSeconds() * 1000.f;
+
+        std::cout << std::setw(6) << bitDepths[i]
+                  << std::setw(15) << std::fixed << std::setprecision(2) << converted << " ms"
+                  << std::setw(11) << direct << " ms"
+                  << std::setw(9) << std::setprecision(0) << (converted - direct) * 100.f / converted << "%" << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Write a tone with some noise to a compressed file
+///
+////////////////////////////////////////////////////////////
+bool writeFile(const std::string& filename, float seconds)
+{
+    sf::OutputSoundFile output;
+    if (!output.openFromFile(filename, sampleRate, channelCount))
+        return false;
+
+    std::vector<sf::Int16> samples(chunkSize);
+    std::size_t total = static_cast<std::size_t>(seconds * sampleRate) * channelCount;
+    for (std::size_t offset = 0; offset < total; offset += samples.size())
+    {
+        for (std::size_t i = 0; i < samples.size(); ++i)
+        {
+            double time = static_cast<double>((offset + i) / channelCount) / sampleRate;
+            double value = 0.5 * std::sin(2.0 * 3.141592654 * 440.0 * time) + 0.1 * (std::rand() / static_cast<double>(RAND_MAX) - 0.5);
+            samples[i] = static_cast<sf::Int16>(value * 32767.0);
+        }
+        output.write(&samples[0], std::min(samples.size(), total - offset));
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Seek to random positions and read a few samples there,
+/// and return the samples read after each seek
+///
+////////////////////////////////////////////////////////////
+std::vector<sf::Int16> seekRandomly(sf::InputSoundFile& input, int seeks, sf::Time& average, sf::Time& longest)
+{
+    const std::size_t readSize = 1024;
+    std::vector<sf::Int16> samples(seeks * readSize);
+    sf::Time total;
+    longest = sf::Time::Zero;
+
+    // Always the same positions, so that the runs with and without index can be compared
+    std::srand(42);
+
+    for (int i = 0; i < seeks; ++i)
+    {
+        sf::Uint64 frame = static_cast<sf::Uint64>(std::rand() / (RAND_MAX + 1.0) * (input.getSampleCount() / channelCount - readSize));
+
+        sf::Clock clock;
+        input.seek(frame * channelCount);
+        input.read(&samples[i * readSize], readSize);
+        sf::Time elapsed = clock.getElapsedTime();
+
+        total += elapsed;
+        longest = std::max(longest, elapsed);
+    }
+
+    average = total / static_cast<sf::Int64>(seeks);
+    return samples;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Print the latency of seeks in a file, and the time spent
+/// building or loading the seek index
+///
+////////////////////////////////////////////////////////////
+void report(const std::string& format, const std::string& index, sf::Time average, sf::Time longest, sf::Time indexTime)
+{
+    std::cout << std::setw(6) << format << std::setw(10) << index
+              << std::setw(10) << std::fixed << std::setprecision(3) << average.asSeconds() * 1000.f << " ms"
+              << std::setw(10) << longest.asSeconds() * 1000.f << " ms";
+
+    if (indexTime > sf::Time::Zero)
+        std::cout << std::setw(10) << indexTime.asSeconds() * 1000.f << " ms";
+
+    std::cout << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the latency of random seeks in a file without
+/// index, with an index built by scanning the file, and with
+/// an index loaded from its cache file
+///
+////////////////////////////////////////////////////////////
+void benchmarkSeekFile(const std::string& filename, const std::string& format, const std::string& cacheFilename, int seeks)
+{
+    sf::InputSoundFile input;
+    if (!input.openFromFile(filename))
+        return;
+
+    sf::Time average;
+    sf::Time longest;
+    std::vector<sf::Int16> reference = seekRandomly(input, seeks, average, longest);
+    report(format, "no", average, longest, sf::Time::Zero);
+
+    sf::Clock clock;
+    bool indexed = input.buildSeekIndex(cacheFilename);
+    sf::Time indexTime = clock.getElapsedTime();
+
+    std::vector<sf::Int16> samples = seekRandomly(input, seeks, average, longest);
+    report(format, indexed ? "scanned" : "failed", average, longest, indexTime);
+
+    // Seeking must be sample accurate in both cases
+    if (samples != reference)
+        std::cout << "(the samples read after seeking with the index don't match)" << std::endl;
+
+    // Open the file again, as a game would when it starts again later
+    sf::InputSoundFile cached;
+    if (!cached.openFromFile(filename))
+        return;
+
+    clock.restart();
+    indexed = cached.buildSeekIndex(cacheFilename);
+    indexTime = clock.getElapsedTime();
+
+    seekRandomly(cached, seeks, average, longest);
+    report(format, indexed ? "cached" : "failed", average, longest, indexTime);
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the latency of random seeks in compressed files
+///
+////////////////////////////////////////////////////////////
+void benchmarkSeek(float seconds, int seeks)
+{
+    std::cout << "Seeking to " << seeks << " random positions in " << seconds << " seconds of "
+              << channelCount << " channels audio at " << sampleRate << " Hz" << std::endl << std::endl;
+    std::cout << "format     index      average      longest    index time" << std::endl;
+
+    const char* formats[] = {"ogg", "flac"};
+    for (std::size_t i = 0; i < sizeof(formats) / sizeof(*formats); ++i)
+    {
+        std::string filename = std::string("benchmark.") + formats[i];
+        std::string cacheFilename = filename + ".sfsi";
+
+        if (writeFile(filename, seconds))
+            benchmarkSeekFile(filename, formats[i], cacheFilename, seeks);
+
+        std::remove(cacheFilename.c_str());
+        std::remove(filename.c_str());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::string mode = (argc > 1) ? argv[1] : "wav";
+    if (mode == "wav")
+    {
+        benchmarkWav(10.f, 20);
+    }
+    else if (mode == "float")
+    {
+        benchmarkFloat(10.f, 20);
+    }
+    else if (mode == "seek")
+    {
+        benchmarkSeek(300.f, 200);
+    }
+    else
+    {
+        std::cerr << "Usage: " << argv[0] << " [wav|float|seek]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
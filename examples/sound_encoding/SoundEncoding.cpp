@@ -0,0 +1,127 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int sampleRate   = 44100;
+    const unsigned int channelCount = 2;
+    const std::size_t  chunkSize    = 1024 * channelCount; // about 23 ms, the size of a typical game frame of audio
+}
+
+
+////////////////////////////////////////////////////////////
+/// Generate a test signal: two tones and some noise, which
+/// is harder to compress than silence and closer to a game mix
+///
+////////////////////////////////////////////////////////////
+std::vector<sf::Int16> generateSignal(float seconds)
+{
+    std::vector<sf::Int16> samples(static_cast<std::size_t>(seconds * sampleRate) * channelCount);
+
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        float time = static_cast<float>(i / channelCount) / sampleRate;
+        float value = 0.4f * std::sin(2.f * 3.141592654f * 440.f * time) +
+                      0.2f * std::sin(2.f * 3.141592654f * 660.f * time) +
+                      0.1f * (static_cast<float>(std::rand()) / RAND_MAX - 0.5f);
+        samples[i] = static_cast<sf::Int16>(value * 32767.f);
+    }
+
+    return samples;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Write the signal to a file, chunk by chunk as a game would,
+/// and print the encoding speed and the time spent in write()
+///
+////////////////////////////////////////////////////////////
+void benchmark(const std::vector<sf::Int16>& samples, const std::string& extension, std::size_t bufferSize)
+{
+    std::string filename = "benchmark." + extension;
+    sf::Clock clock;
+    sf::Time writeTime;
+    sf::Time longestWrite;
+    sf::Uint64 droppedSamples = 0;
+
+    {
+        sf::OutputSoundFile file;
+        file.setAsynchronous(bufferSize, sf::OutputSoundFile::Block);
+        if (!file.openFromFile(filename, sampleRate, channelCount))
+            return;
+
+        for (std::size_t offset = 0; offset < samples.size(); offset += chunkSize)
+        {
+            sf::Clock writeClock;
+            file.write(&samples[offset], std::min(chunkSize, samples.size() - offset));
+
+            sf::Time elapsed = writeClock.getElapsedTime();
+            writeTime += elapsed;
+            longestWrite = std::max(longestWrite, elapsed);
+        }
+
+        droppedSamples = file.getDroppedSampleCount();
+
+        // The file is closed (and the pending samples written) here
+    }
+
+    float totalSeconds = clock.getElapsedTime().asSeconds();
+    float audioSeconds = static_cast<float>(samples.size() / channelCount) / sampleRate;
+
+    std::cout << std::setw(6)  << extension
+              << std::setw(8)  << (bufferSize > 0 ? "async" : "sync")
+              << std::setw(12) << std::fixed << std::setprecision(1) << audioSeconds / totalSeconds << "x"
+              << std::setw(12) << std::setprecision(2) << samples.size() * sizeof(sf::Int16) / totalSeconds / (1024.f * 1024.f) << " MB/s"
+              << std::setw(12) << std::setprecision(3) << writeTime.asSeconds() * 1000.f / (samples.size() / chunkSize) << " ms"
+              << std::setw(12) << longestWrite.asSeconds() * 1000.f << " ms";
+
+    if (droppedSamples > 0)
+        std::cout << " (" << droppedSamples << " samples dropped)";
+
+    std::cout << std::endl;
+
+    std::remove(filename.c_str());
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // The duration of the test signal can be given on the command line
+    float seconds = (argc > 1) ? static_cast<float>(std::atof(argv[1])) : 30.f;
+    if (seconds <= 0.f)
+        seconds = 30.f;
+
+    std::cout << "Encoding " << seconds << " seconds of " << channelCount << " channels audio at "
+              << sampleRate << " Hz, written by chunks of " << chunkSize << " samples" << std::endl << std::endl;
+
+    std::vector<sf::Int16> samples = generateSignal(seconds);
+
+    std::cout << "format    mode    realtime  throughput  write() avg  write() max" << std::endl;
+
+    const char* formats[] = {"wav", "ogg", "flac"};
+    for (std::size_t i = 0; i < sizeof(formats) / sizeof(*formats); ++i)
+    {
+        benchmark(samples, formats[i], 0);
+        benchmark(samples, formats[i], sampleRate * channelCount);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int width       = 1280;
+    const unsigned int height      = 720;
+    const unsigned int tileSize    = 32;
+    const unsigned int tileCount   = 4;
+
+    // State of a moving sprite, shared by both rendering methods
+    struct Mover
+    {
+        sf::Vector2f position;
+        sf::Vector2f velocity;
+        float        rotation;
+        int          tile;
+    };
+}
+
+
+////////////////////////////////////////////////////////////
+/// Move the sprites, bouncing on the borders of the target
+///
+////////////////////////////////////////////////////////////
+void update(std::vector<Mover>& movers, float delta)
+{
+    for (std::size_t i = 0; i < movers.size(); ++i)
+    {
+        Mover& mover = movers[i];
+        mover.position += mover.velocity * delta;
+        mover.rotation += 90.f * delta;
+
+        if ((mover.position.x < 0) || (mover.position.x > width))
+            mover.velocity.x = -mover.velocity.x;
+        if ((mover.position.y < 0) || (mover.position.y > height))
+            mover.velocity.y = -mover.velocity.y;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Print the duration of a frame and the sprites drawn per second
+///
+////////////////////////////////////////////////////////////
+void report(const char* name, std::size_t sprites, int frames, sf::Time time)
+{
+    float frameTime = time.asSeconds() / frames;
+
+    std::cout << std::setw(12) << name
+              << std::setw(10) << std::fixed << std::setprecision(2) << frameTime * 1000.f << " ms/frame"
+              << std::setw(10) << std::setprecision(1) << 1.f / frameTime << " fps"
+              << std::setw(10) << sprites / frameTime / 1000000.f << " M sprites/s" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // The number of sprites can be given on the command line
+    std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 0;
+    if (count == 0)
+        count = 10000;
+
+    const int frames = 200;
+    const float delta = 1.f / 60.f;
+
+    // Render off-screen, so that the benchmark also runs without
+    // a display (set SFML_HEADLESS=1) and isn't limited by v-sync
+    sf::RenderTexture target;
+    if (!target.create(width, height))
+        return EXIT_FAILURE;
+
+    // Build a small atlas of differently colored tiles
+    sf::Image atlasImage;
+    atlasImage.create(tileSize * tileCount, tileSize, sf::Color::Transparent);
+    for (unsigned int tile = 0; tile < tileCount; ++tile)
+    {
+        sf::Color color(tile & 1 ? 255 : 64, tile & 2 ? 255 : 64, 128 + tile * 32);
+        for (unsigned int y = 4; y < tileSize - 4; ++y)
+            for (unsigned int x = 4; x < tileSize - 4; ++x)
+                atlasImage.setPixel(tile * tileSize + x, y, color);
+    }
+
+    sf::Texture atlas;
+    if (!atlas.loadFromImage(atlasImage))
+        return EXIT_FAILURE;
+
+    // Scatter the sprites
+    std::vector<Mover> movers(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float angle = static_cast<float>(std::rand()) / RAND_MAX * 2.f * 3.141592654f;
+        float speed = 50.f + static_cast<float>(std::rand() % 200);
+
+        movers[i].position = sf::Vector2f(static_cast<float>(std::rand() % width), static_cast<float>(std::rand() % height));
+        movers[i].velocity = sf::Vector2f(std::cos(angle) * speed, std::sin(angle) * speed);
+        movers[i].rotation = static_cast<float>(std::rand() % 360);
+        movers[i].tile     = static_cast<int>(i % tileCount);
+    }
+
+    std::cout << "Drawing " << count << " moving sprites for " << frames << " frames ("
+              << width << "x" << height << ")" << std::endl << std::endl;
+
+    // One sf::Sprite per entity, drawn one by one
+    std::vector<sf::Sprite> sprites(count, sf::Sprite(atlas));
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        sprites[i].setTextureRect(sf::IntRect(movers[i].tile * tileSize, 0, tileSize, tileSize));
+        sprites[i].setOrigin(tileSize / 2.f, tileSize / 2.f);
+    }
+
+    std::vector<Mover> spriteMovers = movers;
+    sf::Clock clock;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        update(spriteMovers, delta);
+
+        target.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sprites[i].setPosition(spriteMovers[i].position);
+            sprites[i].setRotation(spriteMovers[i].rotation);
+            target.draw(sprites[i]);
+        }
+        target.display();
+    }
+
+    // Wait until the GPU has finished drawing
+    target.getTexture().copyToImage();
+    report("sf::Sprite", count, frames, clock.getElapsedTime());
+
+    // The same sprites in a single sf::SpriteBatch
+    sf::SpriteBatch batch(atlas);
+    batch.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t index = batch.add(sf::IntRect(movers[i].tile * tileSize, 0, tileSize, tileSize));
+        batch.setOrigin(index, sf::Vector2f(tileSize / 2.f, tileSize / 2.f));
+    }
+
+    std::vector<Mover> batchMovers = movers;
+    clock.restart();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        update(batchMovers, delta);
+
+        target.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            batch.setPosition(i, batchMovers[i].position);
+            batch.setRotation(i, batchMovers[i].rotation);
+        }
+        target.draw(batch);
+        target.display();
+    }
+
+    target.getTexture().copyToImage();
+    report("SpriteBatch", count, frames, clock.getElapsedTime());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+/// Print the number of vertices transformed per second
+///
+////////////////////////////////////////////////////////////
+void report(const char* name, std::size_t vertices, sf::Time time)
+{
+    std::cout << std::setw(20) << name
+              << std::setw(12) << std::fixed << std::setprecision(1)
+              << vertices / time.asSeconds() / 1000000.f << " M vertices/s" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // The number of vertices can be given on the command line
+    std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 0;
+    if (count == 0)
+        count = 1000000;
+
+    const int passes = 20;
+
+    std::vector<sf::Vector2f> points(count);
+    std::vector<sf::Vector2f> result(count);
+    for (std::size_t i = 0; i < count; ++i)
+        points[i] = sf::Vector2f(static_cast<float>(i % 1920), static_cast<float>(i / 1920));
+
+    sf::Transform transform;
+    transform.translate(100.f, 50.f).rotate(30.f).scale(1.5f, 0.75f);
+
+    std::cout << "Transforming " << count << " vertices, " << passes << " passes" << std::endl << std::endl;
+
+    // One point at a time, as the entities of a game usually do
+    sf::Clock clock;
+    for (int pass = 0; pass < passes; ++pass)
+        for (std::size_t i = 0; i < count; ++i)
+            result[i] = transform.transformPoint(points[i]);
+    report("transformPoint", count * passes, clock.getElapsedTime());
+
+    // Check a value so that the compiler can't discard the loop
+    sf::Vector2f expected = result[count / 2];
+
+    // The whole array at once
+    clock.restart();
+    for (int pass = 0; pass < passes; ++pass)
+        transform.transformPoints(&points[0], &result[0], count);
+    report("transformPoints", count * passes, clock.getElapsedTime());
+
+    if (result[count / 2] != expected)
+    {
+        std::cerr << "transformPoints doesn't give the same result as transformPoint" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Bounding rectangles, as getGlobalBounds() computes them for shapes, sprites and texts
+    std::vector<sf::FloatRect> rects(count / 4);
+    std::vector<sf::FloatRect> bounds(count / 4);
+    for (std::size_t i = 0; i < rects.size(); ++i)
+        rects[i] = sf::FloatRect(points[i * 4], sf::Vector2f(32.f, 16.f));
+
+    clock.restart();
+    for (int pass = 0; pass < passes; ++pass)
+        for (std::size_t i = 0; i < rects.size(); ++i)
+            bounds[i] = transform.transformRect(rects[i]);
+    report("transformRect", rects.size() * 4 * passes, clock.getElapsedTime());
+
+    // The bounds must be those of the 4 corners transformed one at a time
+    const sf::FloatRect& rect = rects[rects.size() / 2];
+    const sf::Vector2f corners[] =
+    {
+        transform.transformPoint(rect.left, rect.top),
+        transform.transformPoint(rect.left, rect.top + rect.height),
+        transform.transformPoint(rect.left + rect.width, rect.top),
+        transform.transformPoint(rect.left + rect.width, rect.top + rect.height)
+    };
+    sf::Vector2f min = corners[0];
+    sf::Vector2f max = corners[0];
+    for (int i = 1; i < 4; ++i)
+    {
+        min = sf::Vector2f(std::min(min.x, corners[i].x), std::min(min.y, corners[i].y));
+        max = sf::Vector2f(std::max(max.x, corners[i].x), std::max(max.y, corners[i].y));
+    }
+    if (bounds[rects.size() / 2] != sf::FloatRect(min, max - min))
+    {
+        std::cerr << "transformRect doesn't give the bounds of the transformed corners" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
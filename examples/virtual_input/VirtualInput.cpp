@@ -0,0 +1,677 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <linux/uinput.h>
+
+
+////////////////////////////////////////////////////////////
+/// Send an input event through a uinput device
+///
+////////////////////////////////////////////////////////////
+void emit(int fd, int type, int code, int value)
+{
+    struct input_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.type = type;
+    event.code = code;
+    event.value = value;
+
+    if (write(fd, &event, sizeof(event)) != sizeof(event))
+        std::cerr << "Failed to write to the virtual device" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Create a virtual keyboard with uinput
+///
+/// \return File descriptor of the device, or -1 on failure
+///
+////////////////////////////////////////////////////////////
+int createKeyboard()
+{
+    int fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+    if (fd < 0)
+    {
+        std::cerr << "Failed to open /dev/uinput (is the uinput module loaded, and do you have write access?)" << std::endl;
+        return -1;
+    }
+
+    ioctl(fd, UI_SET_EVBIT, EV_KEY);
+    for (int code = KEY_ESC; code <= KEY_SPACE; ++code)
+        ioctl(fd, UI_SET_KEYBIT, code);
+
+    // The legacy setup structure is used, so that this also works on kernels older than 4.5
+    struct uinput_user_dev device;
+    std::memset(&device, 0, sizeof(device));
+    std::strncpy(device.name, "SFML virtual keyboard", UINPUT_MAX_NAME_SIZE - 1);
+    device.id.bustype = BUS_VIRTUAL;
+    device.id.vendor  = 0x5346;
+    device.id.product = 0x0001;
+
+    if ((write(fd, &device, sizeof(device)) != sizeof(device)) || (ioctl(fd, UI_DEV_CREATE) < 0))
+    {
+        std::cerr << "Failed to create the virtual keyboard" << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Create a virtual gamepad with uinput
+///
+/// Its sticks range from -512 to 512, with a dead zone of 64
+/// around the center, and it has rumble motors.
+///
+/// \return File descriptor of the device, or -1 on failure
+///
+////////////////////////////////////////////////////////////
+int createGamepad()
+{
+    int fd = open("/dev/uinput", O_RDWR | O_NONBLOCK);
+    if (fd < 0)
+    {
+        std::cerr << "Failed to open /dev/uinput (is the uinput module loaded, and do you have write access?)" << std::endl;
+        return -1;
+    }
+
+    struct uinput_user_dev device;
+    std::memset(&device, 0, sizeof(device));
+    std::strncpy(device.name, "SFML virtual gamepad", UINPUT_MAX_NAME_SIZE - 1);
+    device.id.bustype = BUS_VIRTUAL;
+    device.id.vendor  = 0x5346;
+    device.id.product = 0x0002;
+
+    ioctl(fd, UI_SET_EVBIT, EV_KEY);
+    for (int code = BTN_SOUTH; code <= BTN_THUMBR; ++code)
+        ioctl(fd, UI_SET_KEYBIT, code);
+
+    const int axes[] = {ABS_X, ABS_Y, ABS_RX, ABS_RY};
+    ioctl(fd, UI_SET_EVBIT, EV_ABS);
+    for (std::size_t i = 0; i < sizeof(axes) / sizeof(*axes); ++i)
+    {
+        ioctl(fd, UI_SET_ABSBIT, axes[i]);
+        device.absmin[axes[i]]  = -512;
+        device.absmax[axes[i]]  = 512;
+        device.absflat[axes[i]] = 64;
+    }
+
+    ioctl(fd, UI_SET_EVBIT, EV_FF);
+    ioctl(fd, UI_SET_FFBIT, FF_RUMBLE);
+    device.ff_effects_max = 4;
+
+    if ((write(fd, &device, sizeof(device)) != sizeof(device)) || (ioctl(fd, UI_DEV_CREATE) < 0))
+    {
+        std::cerr << "Failed to create the virtual gamepad" << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Press and release keys of the virtual keyboard
+///
+/// \return Number of SFML events expected
+///
+////////////////////////////////////////////////////////////
+int typeKeys(int fd, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        int code = KEY_A + i % 10;
+        emit(fd, EV_KEY, code, 1);
+        emit(fd, EV_SYN, SYN_REPORT, 0);
+        emit(fd, EV_KEY, code, 0);
+        emit(fd, EV_SYN, SYN_REPORT, 0);
+    }
+
+    return count * 2;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Wait until the window receives the events of the virtual
+/// keyboard, which happens once the input backend found it
+///
+/// \return True if the keyboard is working
+///
+////////////////////////////////////////////////////////////
+bool waitForKeyboard(sf::Window& window, int fd)
+{
+    sf::Clock clock;
+    while (clock.getElapsedTime() < sf::seconds(5))
+    {
+        typeKeys(fd, 1);
+        sf::sleep(sf::milliseconds(100));
+
+        sf::Event event;
+        bool received = false;
+        while (window.pollEvent(event))
+            received = received || (event.type == sf::Event::KeyPressed);
+
+        if (received)
+            return true;
+    }
+
+    std::cerr << "The window didn't receive the events of the virtual keyboard" << std::endl;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the cost of pollEvent, with no pending input and
+/// with batches of 100 pending input events
+///
+////////////////////////////////////////////////////////////
+void benchmarkPoll(sf::Window& window, int fd)
+{
+    const int calls = 100000;
+    const int batches = 50;
+    sf::Event event;
+
+    // Idle: the input queue is empty
+    sf::Clock clock;
+    for (int i = 0; i < calls; ++i)
+        window.pollEvent(event);
+    sf::Time idleTime = clock.getElapsedTime();
+
+    std::cout << "pollEvent, no pending event:    " << std::setw(8) << std::fixed << std::setprecision(2)
+              << idleTime.asMicroseconds() / static_cast<float>(calls) << " us/call" << std::endl;
+
+    // Busy: 100 input events are waiting in the device when polling starts
+    sf::Time busyTime;
+    int received = 0;
+    int expected = 0;
+    for (int batch = 0; batch < batches; ++batch)
+    {
+        expected += typeKeys(fd, 50);
+        sf::sleep(sf::milliseconds(20));
+
+        clock.restart();
+        while (window.pollEvent(event))
+        {
+            if ((event.type == sf::Event::KeyPressed) || (event.type == sf::Event::KeyReleased))
+                ++received;
+        }
+        busyTime += clock.getElapsedTime();
+    }
+
+    std::cout << "pollEvent, 100 pending events:  " << std::setw(8) << std::fixed << std::setprecision(2)
+              << busyTime.asMicroseconds() / static_cast<float>(batches) << " us/batch, "
+              << busyTime.asMicroseconds() / static_cast<float>(received > 0 ? received : 1) << " us/event" << std::endl;
+
+    if (received != expected)
+        std::cout << "(" << expected - received << " of " << expected << " key events were lost)" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Wait until the virtual gamepad is connected
+///
+/// \return Index of the joystick, or Joystick::Count if it wasn't found
+///
+////////////////////////////////////////////////////////////
+unsigned int waitForGamepad(sf::Window& window)
+{
+    sf::Clock clock;
+    while (clock.getElapsedTime() < sf::seconds(5))
+    {
+        sf::Event event;
+        while (window.pollEvent(event))
+        {
+        }
+
+        for (unsigned int i = 0; i < sf::Joystick::Count; ++i)
+        {
+            sf::Joystick::Identification identification = sf::Joystick::getIdentification(i);
+            if (sf::Joystick::isConnected(i) && (identification.vendorId == 0x5346) && (identification.productId == 0x0002))
+                return i;
+        }
+
+        sf::sleep(sf::milliseconds(100));
+    }
+
+    std::cerr << "The virtual gamepad wasn't detected" << std::endl;
+    return sf::Joystick::Count;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the cost of pollEvent with a connected gamepad,
+/// when it is idle and when its stick moves
+///
+////////////////////////////////////////////////////////////
+void benchmarkJoystick(sf::Window& window, int fd)
+{
+    const int calls = 100000;
+    const int batches = 50;
+    sf::Event event;
+
+    // Idle: the gamepad is connected but nothing changes
+    sf::Clock clock;
+    for (int i = 0; i < calls; ++i)
+        window.pollEvent(event);
+    sf::Time idleTime = clock.getElapsedTime();
+
+    std::cout << "pollEvent, idle gamepad:        " << std::setw(8) << std::fixed << std::setprecision(2)
+              << idleTime.asMicroseconds() / static_cast<float>(calls) << " us/call" << std::endl;
+
+    // Busy: 100 stick moves are waiting in the device when polling starts
+    sf::Time busyTime;
+    int moves = 0;
+    for (int batch = 0; batch < batches; ++batch)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            emit(fd, EV_ABS, (i % 2) ? ABS_Y : ABS_X, (i * 37) % 1024 - 512);
+            emit(fd, EV_SYN, SYN_REPORT, 0);
+        }
+        sf::sleep(sf::milliseconds(20));
+
+        clock.restart();
+        while (window.pollEvent(event))
+        {
+            if (event.type == sf::Event::JoystickMoved)
+                ++moves;
+        }
+        busyTime += clock.getElapsedTime();
+    }
+
+    std::cout << "pollEvent, 100 pending moves:   " << std::setw(8) << std::fixed << std::setprecision(2)
+              << busyTime.asMicroseconds() / static_cast<float>(batches) << " us/batch ("
+              << moves / batches << " JoystickMoved events/batch)" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Force feedback side of the virtual gamepad
+///
+/// Uploading an effect to a uinput device blocks until the
+/// process that created the device answers the request, so
+/// this must run in its own thread.
+///
+////////////////////////////////////////////////////////////
+struct ForceFeedback
+{
+    int              fd;        ///< Virtual gamepad
+    sf::Mutex        mutex;     ///< Protects the members below
+    bool             running;   ///< Must the thread keep answering the requests?
+    ff_rumble_effect rumble;    ///< Last rumble effect uploaded
+    int              length;    ///< Duration of the last effect uploaded, in milliseconds
+    int              playCount; ///< Number of times an effect was started
+    int              stopCount; ///< Number of times an effect was stopped
+
+    bool isRunning()
+    {
+        sf::Lock lock(mutex);
+        return running;
+    }
+
+    void run()
+    {
+        while (isRunning())
+        {
+            struct pollfd request = {fd, POLLIN, 0};
+            if (poll(&request, 1, 10) <= 0)
+                continue;
+
+            struct input_event event;
+            while (read(fd, &event, sizeof(event)) == sizeof(event))
+            {
+                if ((event.type == EV_UINPUT) && (event.code == UI_FF_UPLOAD))
+                {
+                    struct uinput_ff_upload upload;
+                    std::memset(&upload, 0, sizeof(upload));
+                    upload.request_id = event.value;
+                    ioctl(fd, UI_BEGIN_FF_UPLOAD, &upload);
+
+                    {
+                        sf::Lock lock(mutex);
+                        if (upload.effect.type == FF_RUMBLE)
+                            rumble = upload.effect.u.rumble;
+                        length = upload.effect.replay.length;
+                    }
+
+                    upload.retval = 0;
+                    ioctl(fd, UI_END_FF_UPLOAD, &upload);
+                }
+                else if ((event.type == EV_UINPUT) && (event.code == UI_FF_ERASE))
+                {
+                    struct uinput_ff_erase erase;
+                    std::memset(&erase, 0, sizeof(erase));
+                    erase.request_id = event.value;
+                    ioctl(fd, UI_BEGIN_FF_ERASE, &erase);
+                    erase.retval = 0;
+                    ioctl(fd, UI_END_FF_ERASE, &erase);
+                }
+                else if (event.type == EV_FF)
+                {
+                    sf::Lock lock(mutex);
+                    if (event.value > 0)
+                        ++playCount;
+                    else
+                        ++stopCount;
+                }
+            }
+        }
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+/// Print the result of a check of the gamepad test
+///
+/// \return True if the check passed
+///
+////////////////////////////////////////////////////////////
+bool check(bool passed, const std::string& description)
+{
+    std::cout << (passed ? "[PASS] " : "[FAIL] ") << description << std::endl;
+    return passed;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Let the window process the events sent to the gamepad
+///
+////////////////////////////////////////////////////////////
+std::vector<sf::Event> settle(sf::Window& window)
+{
+    sf::sleep(sf::milliseconds(20));
+
+    std::vector<sf::Event> events;
+    sf::Event event;
+    while (window.pollEvent(event))
+        events.push_back(event);
+
+    return events;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Move a stick of the virtual gamepad, and check the
+/// position reported by SFML
+///
+/// \return True if the position is the expected one
+///
+////////////////////////////////////////////////////////////
+bool checkAxis(sf::Window& window, int fd, unsigned int joystick, int value, float expected)
+{
+    emit(fd, EV_ABS, ABS_X, value);
+    emit(fd, EV_SYN, SYN_REPORT, 0);
+    settle(window);
+
+    float position = sf::Joystick::getAxisPosition(joystick, sf::Joystick::X);
+
+    std::ostringstream description;
+    description << "ABS_X = " << value << " gives position " << position << " (expected " << expected << ")";
+    return check(std::fabs(position - expected) < 0.5f, description.str());
+}
+
+
+////////////////////////////////////////////////////////////
+/// Check the evdev joystick backend against the virtual gamepad
+///
+/// \return True if all the checks passed
+///
+////////////////////////////////////////////////////////////
+bool testGamepad(sf::Window& window, int fd, unsigned int joystick)
+{
+    bool passed = true;
+
+    // Capabilities
+    passed &= check(sf::Joystick::hasAxis(joystick, sf::Joystick::X) && sf::Joystick::hasAxis(joystick, sf::Joystick::Y),
+                    "the sticks are reported as axes");
+    passed &= check(sf::Joystick::getButtonCount(joystick) == BTN_THUMBR - BTN_SOUTH + 1,
+                    "all the buttons are reported");
+
+    // Ranges and dead zone: the range of the sticks is [-512, 512]
+    // and the 64 units around the center are ignored; the rest
+    // of the range is stretched to [-100, 100]
+    passed &= checkAxis(window, fd, joystick, 512, 100.f);
+    passed &= checkAxis(window, fd, joystick, -512, -100.f);
+    passed &= checkAxis(window, fd, joystick, 32, 0.f);
+    passed &= checkAxis(window, fd, joystick, -64, 0.f);
+    passed &= checkAxis(window, fd, joystick, 288, 50.f);
+    passed &= checkAxis(window, fd, joystick, -288, -50.f);
+
+    // Buttons and timestamps: the event must be stamped with the
+    // time at which it was written, not the time at which it was polled
+    sf::Time sendTime = sf::Clock::getCurrentTime();
+    emit(fd, EV_KEY, BTN_SOUTH, 1);
+    emit(fd, EV_SYN, SYN_REPORT, 0);
+    sf::Time writtenTime = sf::Clock::getCurrentTime();
+    std::vector<sf::Event> events = settle(window);
+
+    const sf::Event* pressed = NULL;
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+        if ((events[i].type == sf::Event::JoystickButtonPressed) && (events[i].joystickButton.joystickId == joystick))
+            pressed = &events[i];
+    }
+
+    passed &= check(sf::Joystick::isButtonPressed(joystick, 0), "BTN_SOUTH is button 0");
+    passed &= check(pressed && (pressed->joystickButton.button == 0), "a JoystickButtonPressed event is generated");
+    if (pressed)
+    {
+        std::ostringstream description;
+        description << "the event is stamped when it was written (" << (pressed->timestamp - sendTime).asMicroseconds()
+                    << " us after the write started, " << (sf::Clock::getCurrentTime() - pressed->timestamp).asMicroseconds()
+                    << " us before the check)";
+        passed &= check((pressed->timestamp >= sendTime) && (pressed->timestamp <= writtenTime), description.str());
+    }
+
+    emit(fd, EV_KEY, BTN_SOUTH, 0);
+    emit(fd, EV_SYN, SYN_REPORT, 0);
+    settle(window);
+    passed &= check(!sf::Joystick::isButtonPressed(joystick, 0), "the button is released");
+
+    // Rumble: the effect is uploaded and played through the device
+    ForceFeedback forceFeedback;
+    forceFeedback.fd = fd;
+    forceFeedback.running = true;
+    std::memset(&forceFeedback.rumble, 0, sizeof(forceFeedback.rumble));
+    forceFeedback.length = 0;
+    forceFeedback.playCount = 0;
+    forceFeedback.stopCount = 0;
+
+    sf::Thread thread(&ForceFeedback::run, &forceFeedback);
+    thread.launch();
+
+    passed &= check(sf::Joystick::setVibration(joystick, 100.f, 50.f, sf::milliseconds(200)), "setVibration succeeds");
+    sf::sleep(sf::milliseconds(50));
+    {
+        sf::Lock lock(forceFeedback.mutex);
+        passed &= check((forceFeedback.rumble.strong_magnitude == 0xFFFF) && (std::abs(forceFeedback.rumble.weak_magnitude - 0x7FFF) <= 1),
+                        "the rumble magnitudes are uploaded");
+        passed &= check(forceFeedback.length == 200, "the rumble duration is uploaded");
+        passed &= check(forceFeedback.playCount == 1, "the rumble effect is started");
+    }
+
+    sf::Joystick::setVibration(joystick, 0.f, 0.f);
+    sf::sleep(sf::milliseconds(50));
+    {
+        sf::Lock lock(forceFeedback.mutex);
+        passed &= check(forceFeedback.stopCount == 1, "the rumble effect is stopped");
+    }
+
+    {
+        sf::Lock lock(forceFeedback.mutex);
+        forceFeedback.running = false;
+    }
+    thread.wait();
+
+    return passed;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Key event injected from another thread, while the main
+/// thread is blocked in waitEvent
+///
+////////////////////////////////////////////////////////////
+struct Injection
+{
+    int      fd;       ///< Virtual keyboard
+    int      value;    ///< 1 to press the key, 0 to release it
+    sf::Time sendTime; ///< Time at which the event was written to the device
+
+    void run()
+    {
+        // Let the main thread go to sleep in waitEvent first
+        sf::sleep(sf::milliseconds(5));
+
+        sendTime = sf::Clock::getCurrentTime();
+        emit(fd, EV_KEY, KEY_SPACE, value);
+        emit(fd, EV_SYN, SYN_REPORT, 0);
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+/// Measure the time between the injection of a key event and
+/// its delivery by waitEvent
+///
+////////////////////////////////////////////////////////////
+bool benchmarkLatency(sf::Window& window, int fd)
+{
+    const int samples = 200;
+
+    Injection injection;
+    injection.fd = fd;
+    injection.value = 0;
+
+    sf::Time total;
+    sf::Time shortest = sf::seconds(1);
+    sf::Time longest;
+
+    for (int i = 0; i < samples; ++i)
+    {
+        injection.value = 1 - injection.value;
+        sf::Event::EventType expected = injection.value ? sf::Event::KeyPressed : sf::Event::KeyReleased;
+
+        sf::Thread thread(&Injection::run, &injection);
+        thread.launch();
+
+        sf::Event event;
+        bool received = false;
+        while (!received && window.waitEvent(event, sf::seconds(1)))
+            received = (event.type == expected) && (event.key.code == sf::Keyboard::Space);
+        sf::Time latency = sf::Clock::getCurrentTime() - injection.sendTime;
+
+        thread.wait();
+
+        if (!received)
+        {
+            std::cerr << "waitEvent timed out before the injected event was delivered" << std::endl;
+            return false;
+        }
+
+        total += latency;
+        shortest = std::min(shortest, latency);
+        longest = std::max(longest, latency);
+    }
+
+    std::cout << "waitEvent latency:  " << std::fixed << std::setprecision(1)
+              << total.asMicroseconds() / static_cast<float>(samples) << " us average, "
+              << shortest.asMicroseconds() << " us min, "
+              << longest.asMicroseconds() << " us max" << std::endl;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::string mode = (argc > 1) ? argv[1] : "poll";
+    if ((mode != "poll") && (mode != "latency") && (mode != "joystick") && (mode != "gamepad-test"))
+    {
+        std::cerr << "Usage: " << argv[0] << " [poll|latency|joystick|gamepad-test]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if ((mode == "joystick") || (mode == "gamepad-test"))
+    {
+        int gamepad = createGamepad();
+        if (gamepad < 0)
+            return EXIT_FAILURE;
+
+        sf::Window window(sf::VideoMode(640, 480), "SFML virtual input");
+
+        int status = EXIT_FAILURE;
+        unsigned int joystick = waitForGamepad(window);
+        if (joystick < sf::Joystick::Count)
+        {
+            if (mode == "joystick")
+            {
+                benchmarkJoystick(window, gamepad);
+                status = EXIT_SUCCESS;
+            }
+            else if (testGamepad(window, gamepad, joystick))
+            {
+                status = EXIT_SUCCESS;
+            }
+        }
+
+        ioctl(gamepad, UI_DEV_DESTROY);
+        close(gamepad);
+
+        return status;
+    }
+
+    // Create the virtual device before the window, like a keyboard plugged
+    // in before the application starts; the backend finds it when it opens
+    int keyboard = createKeyboard();
+    if (keyboard < 0)
+        return EXIT_FAILURE;
+
+    // Give udev some time to create the device node
+    sf::sleep(sf::milliseconds(500));
+
+    sf::Window window(sf::VideoMode(640, 480), "SFML virtual input");
+
+    int status = EXIT_FAILURE;
+    if (waitForKeyboard(window, keyboard))
+    {
+        if (mode == "poll")
+        {
+            benchmarkPoll(window, keyboard);
+            status = EXIT_SUCCESS;
+        }
+        else if (benchmarkLatency(window, keyboard))
+        {
+            status = EXIT_SUCCESS;
+        }
+    }
+
+    ioctl(keyboard, UI_DEV_DESTROY);
+    close(keyboard);
+
+    return status;
+}
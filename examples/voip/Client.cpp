@@ -30,6 +30,8 @@ public:
     m_host(host),
     m_port(port)
     {
+        // Send small chunks, to keep the latency low
+        setProcessingInterval(sf::milliseconds(20));
     }
 
     ////////////////////////////////////////////////////////////
@@ -206,6 +206,44 @@ public:
     ////////////////////////////////////////////////////////////
     Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floating point numbers
+    ///
+    /// The samples are normalized to the [-1, 1] range (lossy
+    /// formats may slightly exceed it), and keep the full precision
+    /// of formats that have more than 16 bits per sample.
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 read(float* samples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build an index that speeds up seeking in compressed files
+    ///
+    /// Seeking in an OGG or FLAC file normally requires searching
+    /// the target in the file, which can take several milliseconds
+    /// on long files. This function scans the file once and
+    /// records where decoding can resume, so that subsequent
+    /// seeks jump close to the target and decode only a few
+    /// milliseconds of audio to reach it exactly.
+    ///
+    /// Scanning reads the whole file. If \a cacheFilename is not
+    /// empty, the index is loaded from this file if it matches
+    /// the sound file, otherwise it is built and saved there.
+    ///
+    /// The current read position is preserved.
+    ///
+    /// \param cacheFilename Path of the file caching the index, or empty to not cache it
+    ///
+    /// \return True if seeking uses an index, false if the format doesn't support it
+    ///
+    ////////////////////////////////////////////////////////////
+    bool buildSeekIndex(const std::string& cacheFilename = std::string());
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -134,6 +134,27 @@ public:
     ////////////////////////////////////////////////////////////
     Time getDuration() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Build an index that speeds up seeking in the music
+    ///
+    /// This is useful for OGG and FLAC files that are seeked
+    /// often (loop points, scrubbing): once the index is built,
+    /// setPlayingOffset() jumps close to the target instead of
+    /// searching for it in the file.
+    /// Building the index reads the whole file, so it should be
+    /// done before playing the music. If \a cacheFilename is not
+    /// empty, the index is loaded from this file when it is up to
+    /// date, and saved there otherwise.
+    ///
+    /// \param cacheFilename Path of the file caching the index, or empty to not cache it
+    ///
+    /// \return True if seeking uses an index, false if the format doesn't support it
+    ///
+    /// \see InputSoundFile::buildSeekIndex
+    ///
+    ////////////////////////////////////////////////////////////
+    bool buildSeekIndex(const std::string& cacheFilename = std::string());
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -149,6 +170,19 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual bool onGetData(Chunk& data);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of floating point audio samples from the stream source
+    ///
+    /// This function is used instead of onGetData() when the
+    /// audio device supports floating point buffers.
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return True to continue playback, false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetFloatData(FloatChunk& data);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the current playing position in the stream source
     ///
@@ -168,9 +202,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    InputSoundFile     m_file;    ///< The streamed music file
-    std::vector<Int16> m_samples; ///< Temporary buffer of samples
-    Mutex              m_mutex;   ///< Mutex protecting the data
+    InputSoundFile     m_file;         ///< The streamed music file
+    std::vector<Int16> m_samples;      ///< Temporary buffer of samples
+    std::vector<float> m_floatSamples; ///< Temporary buffer of floating point samples
+    Mutex              m_mutex;        ///< Mutex protecting the data
 };
 
 } // namespace sf
@@ -197,10 +232,11 @@ private:
 /// it, request its parameters (channels, sample rate), change
 /// the way it is played (pitch, volume, 3D position, ...), etc.
 ///
-/// As a sound stream, a music is played in its own thread in order
+/// As a sound stream, a music is played in a separate thread in order
 /// not to block the rest of the program. This means that you can
 /// leave the music alone after calling play(), it will manage itself
-/// very well.
+/// very well. All the musics share a small pool of worker threads,
+/// unless setDedicatedThread(true) is called.
 ///
 /// Usage example:
 /// \code
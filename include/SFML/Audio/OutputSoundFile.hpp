@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
 #include <string>
 
 
@@ -37,6 +38,11 @@ namespace sf
 {
 class SoundFileWriter;
 
+namespace priv
+{
+    class AsyncSoundFileWriter;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Provide write access to sound files
 ///
@@ -45,6 +51,16 @@ class SFML_AUDIO_API OutputSoundFile : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief What to do when the asynchronous buffer is full
+    ///
+    ////////////////////////////////////////////////////////////
+    enum OverflowPolicy
+    {
+        Block, ///< Wait until the background thread makes room for the samples
+        Drop   ///< Discard the samples that don't fit in the buffer
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -82,6 +98,43 @@ public:
     ////////////////////////////////////////////////////////////
     void write(const Int16* samples, Uint64 count);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode the samples in a background thread
+    ///
+    /// In asynchronous mode, write() only copies the samples to
+    /// a lock-free buffer, and a background thread encodes them
+    /// and writes them to the file by large blocks. This allows
+    /// to record audio from a thread that must not stall, such
+    /// as the main loop of a game.
+    ///
+    /// If the background thread can't keep up and the buffer is
+    /// full, write() either waits for it (sf::OutputSoundFile::Block)
+    /// or discards the samples that don't fit (sf::OutputSoundFile::Drop).
+    ///
+    /// The pending samples are all written when the file is
+    /// closed. The new mode is used for the next file opened with
+    /// openFromFile. By default, the samples are encoded synchronously.
+    ///
+    /// \param bufferSize Number of samples that the buffer can hold, or 0 to encode synchronously
+    /// \param policy     What to do when the buffer is full
+    ///
+    /// \see getDroppedSampleCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAsynchronous(std::size_t bufferSize, OverflowPolicy policy = Block);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples discarded because the buffer was full
+    ///
+    /// The count is reset when a new file is opened.
+    ///
+    /// \return Number of samples discarded with the sf::OutputSoundFile::Drop policy
+    ///
+    /// \see setAsynchronous
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedSampleCount() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -93,7 +146,11 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    SoundFileWriter* m_writer; ///< Writer that handles I/O on the file's format
+    SoundFileWriter*            m_writer;             ///< Writer that handles I/O on the file's format
+    priv::AsyncSoundFileWriter* m_asyncWriter;        ///< Background encoder, in asynchronous mode
+    std::size_t                 m_bufferSize;         ///< Size of the asynchronous buffer, 0 for synchronous mode
+    OverflowPolicy              m_policy;             ///< What to do when the asynchronous buffer is full
+    Uint64                      m_droppedSampleCount; ///< Number of samples dropped by the last closed background encoder
 };
 
 } // namespace sf
@@ -128,6 +185,15 @@ private:
 /// }
 /// \endcode
 ///
+/// When the samples are produced by a time-critical thread,
+/// setAsynchronous() moves the encoding to a background thread:
+/// \code
+/// // Buffer up to one second of stereo samples, drop what doesn't fit
+/// file.setAsynchronous(44100 * 2, sf::OutputSoundFile::Drop);
+/// if (!file.openFromFile("gameplay.ogg", 44100, 2))
+///     /* error */;
+/// \endcode
+///
 /// \see sf::SoundFileWriter, sf::InputSoundFile
 ///
 ////////////////////////////////////////////////////////////
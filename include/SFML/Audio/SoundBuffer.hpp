@@ -134,11 +134,89 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromSamples(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a file, and keep it compressed in memory
+    ///
+    /// Only the encoded file is loaded; the samples are decoded
+    /// the first time a sf::Sound plays the buffer. Decoded
+    /// buffers are kept in a cache shared by all the compressed
+    /// sound buffers, whose size is bounded by setDecodedCacheSize():
+    /// when it's full, the least recently played buffers that are
+    /// not playing are released, and decoded again when needed.
+    /// The samples are never kept on the CPU side, getSamples()
+    /// always returns NULL.
+    ///
+    /// This is best for many small compressed sounds (OGG, FLAC)
+    /// that are not all played at the same time.
+    ///
+    /// \param filename Path of the sound file to load
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadCompressedFromMemory, loadCompressedFromStream, setDecodedCacheSize
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadCompressedFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a file in memory, and keep it compressed
+    ///
+    /// The file data is copied, so the source buffer can be
+    /// released after this call. See loadCompressedFromFile
+    /// for details.
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadCompressedFromFile, loadCompressedFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadCompressedFromMemory(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a custom stream, and keep it compressed
+    ///
+    /// The whole stream is read into memory. See loadCompressedFromFile
+    /// for details.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadCompressedFromFile, loadCompressedFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadCompressedFromStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load several sound buffers from files in parallel
+    ///
+    /// The files are decoded by \a threadCount worker threads,
+    /// then uploaded to the audio device by the calling thread.
+    /// Each buffer keeps or releases its samples according to
+    /// its own setKeepSamples() setting.
+    ///
+    /// \param buffers     Array of pointers to the buffers to load
+    /// \param filenames   Array of paths of the files to load, one per buffer
+    /// \param count       Number of buffers to load
+    /// \param threadCount Number of worker threads to use
+    ///
+    /// \return Number of buffers that were successfully loaded
+    ///
+    /// \see loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t loadFromFiles(SoundBuffer* const* buffers, const std::string* filenames, std::size_t count, unsigned int threadCount = 4);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save the sound buffer to an audio file
     ///
     /// See the documentation of sf::OutputSoundFile for the list
     /// of supported formats.
+    /// Saving fails if the samples have been released
+    /// (see setKeepSamples()).
     ///
     /// \param filename Path of the sound file to write
     ///
@@ -155,6 +233,8 @@ public:
     /// The format of the returned samples is 16 bits signed integer
     /// (sf::Int16). The total number of samples in this array
     /// is given by the getSampleCount() function.
+    /// NULL is returned if the samples have been released
+    /// (see setKeepSamples()) or if the buffer is compressed.
     ///
     /// \return Read-only pointer to the array of sound samples
     ///
@@ -163,6 +243,59 @@ public:
     ////////////////////////////////////////////////////////////
     const Int16* getSamples() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose whether to keep a copy of the samples in memory
+    ///
+    /// Once the samples have been uploaded to the audio device,
+    /// the copy held by the sound buffer is only needed by
+    /// getSamples(), saveToFile() and the copy of the buffer.
+    /// Releasing it halves the memory used by the sound.
+    /// If the buffer is already loaded and \a keep is false,
+    /// the samples are released immediately.
+    /// By default, the samples are kept.
+    ///
+    /// \param keep True to keep the samples, false to release them after upload
+    ///
+    /// \see getKeepSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    void setKeepSamples(bool keep);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the samples are kept in memory after upload
+    ///
+    /// \return True if the samples are kept, false otherwise
+    ///
+    /// \see setKeepSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getKeepSamples() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum memory used by decoded compressed buffers
+    ///
+    /// This limit applies to all the sound buffers loaded with
+    /// one of the loadCompressedFromXxx functions. Buffers that are
+    /// playing are never released, so the limit can be exceeded
+    /// temporarily. The default size is 16 MB.
+    ///
+    /// \param sizeInBytes Maximum size of the decoded samples, in bytes
+    ///
+    /// \see getDecodedCacheSize, loadCompressedFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setDecodedCacheSize(std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum memory used by decoded compressed buffers
+    ///
+    /// \return Maximum size of the decoded samples, in bytes
+    ///
+    /// \see setDecodedCacheSize
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getDecodedCacheSize();
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the number of samples stored in the buffer
     ///
@@ -248,6 +381,45 @@ private:
     ////////////////////////////////////////////////////////////
     bool update(unsigned int channelCount, unsigned int sampleRate);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure that the audio device holds the samples
+    ///
+    /// This function decodes compressed buffers on demand, and
+    /// marks them as recently used. It is called by sf::Sound
+    /// before playing.
+    ///
+    /// \return True on success, false if the buffer couldn't be decoded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool prepare() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the samples held by the audio device
+    ///
+    /// The sounds that use the buffer stay attached to it.
+    ///
+    ////////////////////////////////////////////////////////////
+    void unload() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the encoded file of a compressed buffer
+    ///
+    /// This function is called before the buffer is loaded with
+    /// uncompressed samples.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearCompressed();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Initialize the buffer from an encoded sound file
+    ///
+    /// \param data Encoded file; it is swapped with the internal copy on success
+    ///
+    /// \return True on success, false if the data is not a valid sound file
+    ///
+    ////////////////////////////////////////////////////////////
+    bool initializeCompressed(std::vector<char>& data);
+
     ////////////////////////////////////////////////////////////
     /// \brief Add a sound to the list of sounds that use this buffer
     ///
@@ -272,10 +444,16 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int       m_buffer;   ///< OpenAL buffer identifier
-    std::vector<Int16> m_samples;  ///< Samples buffer
-    Time               m_duration; ///< Sound duration
-    mutable SoundList  m_sounds;   ///< List of sounds that are using this buffer
+    mutable unsigned int m_buffer;       ///< OpenAL buffer identifier
+    std::vector<Int16>   m_samples;      ///< Samples buffer
+    std::vector<char>    m_compressed;   ///< Encoded file, for buffers decoded on demand
+    Uint64               m_sampleCount;  ///< Number of samples
+    unsigned int         m_channelCount; ///< Number of channels
+    unsigned int         m_sampleRate;   ///< Sample rate
+    Time                 m_duration;     ///< Sound duration
+    bool                 m_keepSamples;  ///< Keep m_samples after upload?
+    mutable bool         m_isDecoded;    ///< Does the OpenAL buffer hold the decoded compressed data?
+    mutable SoundList    m_sounds;       ///< List of sounds that are using this buffer
 };
 
 } // namespace sf
@@ -302,6 +480,12 @@ private:
 /// a custom stream (see sf::InputStream) or directly from an array
 /// of samples. It can also be saved back to a file.
 ///
+/// To reduce the memory used by sounds, a sound buffer can release
+/// its copy of the samples once they are uploaded to the audio device
+/// (see setKeepSamples()), or keep the encoded file in memory and
+/// decode it on demand (see loadCompressedFromFile()). Many sound
+/// buffers can be loaded in parallel with loadFromFiles().
+///
 /// Sound buffers alone are not very useful: they hold the audio data
 /// but cannot be played. To do so, you need to use the sf::Sound class,
 /// which provides functions to play/pause/stop the sound as well as
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -55,6 +56,16 @@ public:
         unsigned int sampleRate;   ///< Samples rate of the sound, in samples per second
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of a seek index
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SeekPoint
+    {
+        Uint64 sampleOffset; ///< Sample offset (channels included) at which decoding can resume
+        Uint64 byteOffset;   ///< Position in the file where decoding resumes
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Virtual destructor
     ///
@@ -100,6 +111,56 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floating point numbers
+    ///
+    /// The samples are normalized to the [-1, 1] range (lossy
+    /// formats may slightly exceed it, they are not clamped).
+    /// Readers whose source format has more precision than
+    /// 16 bits should override this function; the default
+    /// implementation converts the samples returned by read().
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 readFloat(float* samples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scan the whole file to build a seek index
+    ///
+    /// Compressed formats can override this function to record
+    /// where decoding can start, so that seek() can jump close to
+    /// the target instead of searching for it. The read position
+    /// is undefined after this function returns, the caller must
+    /// seek to restore it.
+    /// The default implementation returns false.
+    ///
+    /// \param index Array to fill, sorted by increasing offsets
+    ///
+    /// \return True if the index was built, false if the format doesn't need or support it
+    ///
+    /// \see setSeekIndex
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool buildSeekIndex(std::vector<SeekPoint>& index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the seek index to use in seek()
+    ///
+    /// The index was previously returned by buildSeekIndex(),
+    /// possibly by another reader on the same file.
+    /// The default implementation does nothing.
+    ///
+    /// \param index Seek index
+    ///
+    /// \see buildSeekIndex
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setSeekIndex(const std::vector<SeekPoint>& index);
 };
 
 } // namespace sf
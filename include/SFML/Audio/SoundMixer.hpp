@@ -0,0 +1,418 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDMIXER_HPP
+#define SFML_SOUNDMIXER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class SoundBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Software mixer that combines many virtual voices
+///        into a single stream of samples
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundMixer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Algorithms available to resample the voices
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Resampler
+    {
+        Linear,   ///< Linear interpolation between two samples: cheapest, slightly dull and aliased
+        Polyphase ///< 8-taps windowed-sinc filter bank: better quality, about 4 times more expensive
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a voice played by the mixer
+    ///
+    /// The value 0 never identifies a voice, it is returned
+    /// when a voice couldn't be started.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint32 VoiceId;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining the initial parameters of a voice
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_AUDIO_API VoiceSettings
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        VoiceSettings();
+
+        float volume;   ///< Volume of the voice, in the range [0, 100]
+        float pitch;    ///< Pitch of the voice, 1 being the original pitch
+        float pan;      ///< Stereo position, from -1 (left) to 1 (right)
+        bool  loop;     ///< Whether the voice restarts when it reaches its end
+        int   priority; ///< Priority used to choose which voice to steal when all the voices are busy
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the mixer
+    ///
+    /// \param channelCount Number of channels of the output (1 or 2)
+    /// \param sampleRate   Sample rate of the output
+    /// \param maxVoices    Maximum number of voices played simultaneously
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundMixer(unsigned int channelCount = 2, unsigned int sampleRate = 44100, std::size_t maxVoices = 32);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start playing a sound buffer on a new voice
+    ///
+    /// The buffer is not copied: it must remain alive, and not
+    /// be modified, as long as the voice plays it. The mixer
+    /// reads the samples kept by the buffer, so compressed buffers
+    /// and buffers that release their samples can't be played.
+    ///
+    /// \param buffer   Sound buffer to play
+    /// \param settings Initial parameters of the voice
+    ///
+    /// \return Identifier of the new voice, or 0 if it couldn't be started
+    ///
+    ////////////////////////////////////////////////////////////
+    VoiceId play(const SoundBuffer& buffer, const VoiceSettings& settings = VoiceSettings());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start playing an array of samples on a new voice
+    ///
+    /// The samples are not copied: they must remain alive, and
+    /// not be modified, as long as the voice plays them.
+    ///
+    /// If all the voices are busy, the voice with the lowest
+    /// priority is stolen, provided that its priority is not
+    /// higher than the priority of the new voice. Among voices
+    /// with the same priority, the one closest to its end is
+    /// stolen.
+    ///
+    /// \param samples      Pointer to the array of samples
+    /// \param sampleCount  Number of samples in the array
+    /// \param channelCount Number of channels (1 = mono, 2 = stereo)
+    /// \param sampleRate   Sample rate (number of samples to play per second)
+    /// \param settings     Initial parameters of the voice
+    ///
+    /// \return Identifier of the new voice, or 0 if it couldn't be started
+    ///
+    ////////////////////////////////////////////////////////////
+    VoiceId play(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate, const VoiceSettings& settings = VoiceSettings());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop a voice
+    ///
+    /// This function does nothing if the voice has already
+    /// finished playing.
+    ///
+    /// \param voice Identifier of the voice to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop(VoiceId voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop all the voices
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopAll();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a voice is still playing
+    ///
+    /// \param voice Identifier of the voice
+    ///
+    /// \return True if the voice is playing, false if it finished, was stopped or was stolen
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPlaying(VoiceId voice) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the volume of a voice
+    ///
+    /// \param voice  Identifier of the voice
+    /// \param volume New volume, in the range [0, 100]
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVolume(VoiceId voice, float volume);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the pitch of a voice
+    ///
+    /// \param voice Identifier of the voice
+    /// \param pitch New pitch, 1 being the original pitch
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPitch(VoiceId voice, float pitch);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the stereo position of a voice
+    ///
+    /// \param voice Identifier of the voice
+    /// \param pan   New position, from -1 (left) to 1 (right)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPan(VoiceId voice, float pan);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change whether a voice loops
+    ///
+    /// \param voice Identifier of the voice
+    /// \param loop  True to loop, false to stop at the end
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLoop(VoiceId voice, bool loop);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of voices currently playing
+    ///
+    /// \return Number of active voices
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVoiceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the volume applied to the whole mix
+    ///
+    /// \param volume New volume, in the range [0, 100]
+    ///
+    /// \see getMasterVolume
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMasterVolume(float volume);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the volume applied to the whole mix
+    ///
+    /// \return Master volume, in the range [0, 100]
+    ///
+    /// \see setMasterVolume
+    ///
+    ////////////////////////////////////////////////////////////
+    float getMasterVolume() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the resampling algorithm
+    ///
+    /// \param resampler New resampling algorithm
+    ///
+    /// \see getResampler
+    ///
+    ////////////////////////////////////////////////////////////
+    void setResampler(Resampler resampler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the resampling algorithm
+    ///
+    /// \return Current resampling algorithm
+    ///
+    /// \see setResampler
+    ///
+    ////////////////////////////////////////////////////////////
+    Resampler getResampler() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of channels of the output
+    ///
+    /// \return Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChannelCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the output
+    ///
+    /// \return Sample rate, in samples per second
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getSampleRate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mix the active voices into an array of samples
+    ///
+    /// This function advances all the voices by \a frameCount
+    /// frames and writes the result, interleaved, to \a samples,
+    /// which must be large enough to hold frameCount * channel
+    /// count samples. It never allocates memory, and can be
+    /// called from any thread.
+    ///
+    /// \param samples    Array to fill with the mixed samples
+    /// \param frameCount Number of frames to render
+    ///
+    ////////////////////////////////////////////////////////////
+    void render(Int16* samples, std::size_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total CPU time spent in render
+    ///
+    /// Comparing this value to the duration of the rendered
+    /// audio (see getRenderedFrameCount) gives the CPU load
+    /// of the mixer.
+    ///
+    /// \return Accumulated mixing time
+    ///
+    /// \see resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getMixingTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total number of frames rendered
+    ///
+    /// \return Accumulated number of rendered frames
+    ///
+    /// \see resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getRenderedFrameCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the mixing time and rendered frame counters
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Internal state of a voice
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Voice
+    {
+        VoiceId      id;           ///< Identifier of the voice, 0 if the slot is free
+        const Int16* samples;      ///< Samples played by the voice
+        Uint64       frameCount;   ///< Number of frames in the samples
+        unsigned int channelCount; ///< Number of channels of the samples
+        unsigned int sampleRate;   ///< Sample rate of the samples
+        Uint64       position;     ///< Playing position, in frames, as a 32.32 fixed-point number
+        float        volume;       ///< Volume, in the range [0, 1]
+        float        pitch;        ///< Pitch factor
+        float        pan;          ///< Stereo position
+        bool         loop;         ///< Loop flag
+        int          priority;     ///< Priority used for voice stealing
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the voice matching an identifier
+    ///
+    /// \param voice Identifier of the voice
+    ///
+    /// \return Pointer to the voice, or NULL if it is not playing
+    ///
+    ////////////////////////////////////////////////////////////
+    Voice* findVoice(VoiceId voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resample a voice and add it to the accumulator
+    ///
+    /// \param voice      Voice to mix
+    /// \param frameCount Number of frames to mix
+    ///
+    ////////////////////////////////////////////////////////////
+    void mixVoice(Voice& voice, std::size_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int       m_channelCount;   ///< Number of output channels
+    unsigned int       m_sampleRate;     ///< Output sample rate
+    std::vector<Voice> m_voices;         ///< Voice slots (fixed size)
+    VoiceId            m_nextId;         ///< Identifier of the next voice to start
+    float              m_masterVolume;   ///< Volume applied to the mix, in the range [0, 1]
+    Resampler          m_resampler;      ///< Resampling algorithm
+    std::vector<float> m_accumulator;    ///< Mix of the current block, interleaved
+    std::vector<float> m_voiceBuffer;    ///< Resampled samples of the current voice, interleaved
+    std::vector<float> m_filters;        ///< Coefficients of the polyphase filter bank
+    Time               m_mixingTime;     ///< Accumulated time spent in render
+    Uint64             m_renderedFrames; ///< Accumulated number of rendered frames
+    mutable Mutex      m_mutex;          ///< Protects the voices against concurrent access from the audio thread
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDMIXER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundMixer
+/// \ingroup audio
+///
+/// sf::SoundMixer mixes many short sounds in software, instead
+/// of playing each of them on its own audio source like
+/// sf::Sound does. This keeps the number of sources used by the
+/// audio driver constant, no matter how many sounds are played,
+/// which helps on platforms where sources are limited or
+/// expensive, and makes it cheap to start and stop sounds.
+///
+/// Each sound is played on a voice, identified by the value
+/// returned by play(). Voices are automatically released when
+/// they reach their end; when too many sounds are played at the
+/// same time, the least important ones are stolen according to
+/// their priority. Voices are resampled to the output sample
+/// rate with the selected algorithm, and mixed using SIMD
+/// instructions (SSE or NEON) when the CPU supports them.
+///
+/// The mixer itself doesn't output anything: its render()
+/// function produces blocks of samples, which can be sent to
+/// the audio device with sf::SoundMixerStream, written to a
+/// file with sf::OutputSoundFile, or inspected directly. This
+/// also means that the mixer works without any audio device.
+///
+/// Usage example:
+/// \code
+/// sf::SoundMixer mixer(2, 44100, 64);
+/// sf::SoundMixerStream output(mixer);
+/// output.play();
+///
+/// sf::SoundMixer::VoiceSettings settings;
+/// settings.volume = 50.f;
+/// settings.pan = -0.5f;
+/// sf::SoundMixer::VoiceId voice = mixer.play(explosionBuffer, settings);
+///
+/// // later...
+/// mixer.setPitch(voice, 1.2f);
+///
+/// // check the CPU load of the mixer
+/// float load = mixer.getMixingTime().asSeconds() * mixer.getSampleRate() / mixer.getRenderedFrameCount();
+/// \endcode
+///
+/// \see sf::SoundMixerStream, sf::Sound
+///
+////////////////////////////////////////////////////////////
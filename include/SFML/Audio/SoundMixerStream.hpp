@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDMIXERSTREAM_HPP
+#define SFML_SOUNDMIXERSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class SoundMixer;
+
+////////////////////////////////////////////////////////////
+/// \brief Audio stream that plays the output of a sf::SoundMixer
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundMixerStream : public SoundStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the stream from a mixer
+    ///
+    /// The duration of the chunks rendered by the mixer defines
+    /// the latency between a call to sf::SoundMixer::play and
+    /// the moment the sound is heard: smaller chunks give a
+    /// lower latency, but wake the streaming thread more often.
+    ///
+    /// \param mixer         Mixer to play
+    /// \param chunkDuration Duration of the chunks rendered by the mixer
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SoundMixerStream(SoundMixer& mixer, Time chunkDuration = milliseconds(20));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundMixerStream();
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of audio samples from the mixer
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return Always true, the stream never ends by itself
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(Chunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source
+    ///
+    /// The output of a mixer can't be seeked, this function does nothing.
+    ///
+    /// \param timeOffset New playing position, from the beginning of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSeek(Time timeOffset);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SoundMixer&        m_mixer;   ///< Mixer rendering the samples
+    std::vector<Int16> m_samples; ///< Buffer receiving the rendered samples
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDMIXERSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundMixerStream
+/// \ingroup audio
+///
+/// sf::SoundMixerStream sends the output of a sf::SoundMixer
+/// to the audio device, through a single streamed source.
+/// The stream renders new chunks from the mixer on its
+/// streaming thread, and keeps playing silence when no voice
+/// is active, until it is stopped.
+///
+/// Since the stream is a regular sf::SoundSource, its volume,
+/// pitch and 3D position apply to the whole mix.
+///
+/// Usage example:
+/// \code
+/// sf::SoundMixer mixer;
+/// sf::SoundMixerStream stream(mixer, sf::milliseconds(10));
+/// stream.play();
+///
+/// mixer.play(buffer);
+/// \endcode
+///
+/// \see sf::SoundMixer
+///
+////////////////////////////////////////////////////////////
@@ -32,6 +32,8 @@
 #include <SFML/Audio/AlResource.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Signal.hpp>
 #include <vector>
 #include <string>
 
@@ -46,6 +48,20 @@ class SFML_AUDIO_API SoundRecorder : AlResource
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding the capture statistics
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Uint64       processedChunkCount; ///< Number of chunks passed to onProcessSamples()
+        unsigned int overrunCount;        ///< Number of times the capture buffer was full, and samples may have been lost
+        Time         latency;             ///< Age of the oldest samples of the last chunk, when it was processed
+        Time         maxLatency;          ///< Largest latency
+        Time         jitter;              ///< Average delay between the scheduled and the actual processing times
+        Time         maxJitter;           ///< Largest delay between the scheduled and the actual processing times
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief destructor
     ///
@@ -185,6 +201,27 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the capture statistics
+    ///
+    /// The statistics are updated by the capture thread every
+    /// time it processes the captured samples.
+    ///
+    /// \return Statistics gathered since the last reset
+    ///
+    /// \see resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the capture statistics
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -205,6 +242,11 @@ protected:
     ///
     /// Note: this is only a hint, the actual period may vary.
     /// So don't rely on this parameter to implement precise timing.
+    /// The capture thread follows a fixed schedule, so the time
+    /// spent in onProcessSamples doesn't make the period drift,
+    /// and it is interrupted immediately when the capture stops.
+    /// Intervals as short as 5 ms can be used for low latency
+    /// processing; the minimum is 1 ms.
     ///
     /// The default processing interval is 100 ms.
     ///
@@ -271,8 +313,10 @@ private:
     /// capture loop. It retrieves the captured samples and
     /// forwards them to the derived class.
     ///
+    /// \return Number of frames that were available in the capture buffer
+    ///
     ////////////////////////////////////////////////////////////
-    void processCapturedSamples();
+    unsigned int processCapturedSamples();
 
     ////////////////////////////////////////////////////////////
     /// \brief Clean up the recorder's internal resources
@@ -286,12 +330,16 @@ private:
     // Member data
     ////////////////////////////////////////////////////////////
     Thread             m_thread;             ///< Thread running the background recording task
-    std::vector<Int16> m_samples;            ///< Buffer to store captured samples
+    std::vector<Int16> m_samples;            ///< Buffer to store captured samples, allocated when the capture starts
     unsigned int       m_sampleRate;         ///< Sample rate
     Time               m_processingInterval; ///< Time period between calls to onProcessSamples
     bool               m_isCapturing;        ///< Capturing state
     std::string        m_deviceName;         ///< Name of the audio capture device
     unsigned int       m_channelCount;       ///< Number of recording channels
+    mutable Mutex      m_mutex;              ///< Mutex protecting the processing interval and the statistics
+    Signal             m_wakeUp;             ///< Signal used to interrupt the capture thread when the capture stops
+    Statistics         m_statistics;         ///< Capture statistics
+    Time               m_totalJitter;        ///< Sum of the processing delays, used to compute the average jitter
 };
 
 } // namespace sf
@@ -33,11 +33,18 @@
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/System/Mutex.hpp>
+#include <SFML/System/Signal.hpp>
 #include <cstdlib>
+#include <vector>
 
 
 namespace sf
 {
+namespace priv
+{
+    class StreamScheduler;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for streamed audio sources
 ///
@@ -56,6 +63,31 @@ public:
         std::size_t  sampleCount; ///< Number of samples pointed by Samples
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a chunk of floating point audio data to stream
+    ///
+    ////////////////////////////////////////////////////////////
+    struct FloatChunk
+    {
+        const float* samples;     ///< Pointer to the audio samples, normalized to [-1, 1]
+        std::size_t  sampleCount; ///< Number of samples pointed by Samples
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding the streaming statistics
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Uint64       underrunCount;     ///< Number of times the playing queue ran dry while streaming
+        Time         queuedDuration;    ///< Duration of audio queued but not played yet, at the last update
+        Time         minQueuedDuration; ///< Lowest queued duration observed since the last reset
+        unsigned int queuedBufferCount; ///< Number of buffers in the playing queue, at the last update
+        Uint64       decodedChunkCount; ///< Number of chunks requested from the stream source
+        Time         decodeTime;        ///< Total time spent in onGetData()
+        Time         maxDecodeTime;     ///< Longest time spent producing a single chunk
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -136,6 +168,12 @@ public:
     /// when the stream is stopped has no effect, since playing
     /// the stream would reset its position.
     ///
+    /// The seek is performed by the streaming thread, which
+    /// keeps running: it drops the queued audio and refills
+    /// its buffers from the new position. This function
+    /// returns immediately, and getPlayingOffset() reports
+    /// the new position right away.
+    ///
     /// \param timeOffset New playing position, from the beginning of the stream
     ///
     /// \see getPlayingOffset
@@ -178,6 +216,132 @@ public:
     ////////////////////////////////////////////////////////////
     bool getLoop() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of buffers used by the streaming loop
+    ///
+    /// More buffers make the stream more robust against a slow
+    /// or irregular source, fewer buffers lower the latency
+    /// between onGetData() and the moment the data is heard.
+    /// The value is clamped to [2, 16], and takes effect
+    /// the next time the stream is started.
+    /// The default buffer count is 3.
+    ///
+    /// \param count Number of buffers
+    ///
+    /// \see getBufferCount, setChunkDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of buffers used by the streaming loop
+    ///
+    /// \return Number of buffers
+    ///
+    /// \see setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBufferCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the preferred duration of the chunks returned by onGetData()
+    ///
+    /// This is only a hint for derived classes, which should
+    /// size the chunks they return accordingly (sf::Music does).
+    /// The total latency of the stream is roughly the buffer
+    /// count multiplied by the chunk duration.
+    /// The default chunk duration is 1 second.
+    ///
+    /// \param duration Preferred chunk duration
+    ///
+    /// \see getChunkDuration, setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setChunkDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the preferred duration of the chunks returned by onGetData()
+    ///
+    /// \return Preferred chunk duration
+    ///
+    /// \see setChunkDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getChunkDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose between a dedicated thread and the shared workers
+    ///
+    /// By default, all the streams are serviced by a small pool of
+    /// shared worker threads, which refill the streams closest to
+    /// running dry first. Streams whose source may block for a long
+    /// time (network streams, for example) should use their own
+    /// thread instead, so that they don't delay the other streams.
+    /// The new mode takes effect the next time the stream is started.
+    ///
+    /// \param dedicated True to use a dedicated thread, false to use the shared workers
+    ///
+    /// \see hasDedicatedThread, setSharedThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDedicatedThread(bool dedicated);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the stream uses a dedicated thread
+    ///
+    /// \return True if the stream uses its own thread, false if it uses the shared workers
+    ///
+    /// \see setDedicatedThread
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasDedicatedThread() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of shared worker threads
+    ///
+    /// The shared workers are started when the first stream
+    /// that doesn't use a dedicated thread is played. Changing the
+    /// number of workers has no effect once they are running.
+    /// The default number of workers is 2.
+    ///
+    /// \param count Number of worker threads (at least 1)
+    ///
+    /// \see getSharedThreadCount, setDedicatedThread
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setSharedThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of shared worker threads
+    ///
+    /// \return Number of worker threads
+    ///
+    /// \see setSharedThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getSharedThreadCount();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the streaming statistics
+    ///
+    /// The statistics are updated by the streaming thread
+    /// every time it wakes up.
+    ///
+    /// \return Statistics gathered since the last reset
+    ///
+    /// \see resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the streaming statistics
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -198,11 +362,17 @@ protected:
     /// It can be called multiple times if the settings of the
     /// audio stream change, but only when the stream is stopped.
     ///
+    /// If \a floatSamples is true, the samples are requested with
+    /// onGetFloatData() instead of onGetData(). They are given to
+    /// the audio device as is if it supports floating point buffers,
+    /// and converted to 16-bit integers otherwise.
+    ///
     /// \param channelCount Number of channels of the stream
     /// \param sampleRate   Sample rate, in samples per second
+    /// \param floatSamples Does the stream source provide floating point samples?
     ///
     ////////////////////////////////////////////////////////////
-    void initialize(unsigned int channelCount, unsigned int sampleRate);
+    void initialize(unsigned int channelCount, unsigned int sampleRate, bool floatSamples = false);
 
     ////////////////////////////////////////////////////////////
     /// \brief Request a new chunk of audio samples from the stream source
@@ -223,6 +393,23 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual bool onGetData(Chunk& data) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of floating point audio samples from the stream source
+    ///
+    /// This function is called instead of onGetData() when the
+    /// stream was initialized with floating point samples; it
+    /// follows the same rules. Sources which produce floating
+    /// point samples (decoders, synthesizers, effects) can
+    /// override it to avoid a conversion to 16-bit integers.
+    /// The default implementation returns false.
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return True to continue playback, false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetFloatData(FloatChunk& data);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the current playing position in the stream source
     ///
@@ -236,6 +423,23 @@ protected:
 
 private:
 
+    friend class priv::StreamScheduler;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start streaming, in the dedicated thread or with the shared workers
+    ///
+    ////////////////////////////////////////////////////////////
+    void launchStreaming();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the stream is no longer being streamed
+    ///
+    /// m_isStreaming must have been set to false before calling
+    /// this function.
+    ///
+    ////////////////////////////////////////////////////////////
+    void waitStreaming();
+
     ////////////////////////////////////////////////////////////
     /// \brief Function called as the entry point of the thread
     ///
@@ -245,6 +449,31 @@ private:
     ////////////////////////////////////////////////////////////
     void streamData();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the buffers, fill the queue and start playing
+    ///
+    /// \return False if the stream was stopped before it could start
+    ///
+    ////////////////////////////////////////////////////////////
+    bool startStreaming();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run one iteration of the streaming loop
+    ///
+    /// \param delay  Receives the time to wait before the next iteration
+    /// \param queued Receives the duration of audio left in the queue
+    ///
+    /// \return False if streaming is over, true otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool updateStream(Time& delay, Time& queued);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop playing, empty the queue and destroy the buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    void finishStreaming();
+
     ////////////////////////////////////////////////////////////
     /// \brief Fill a new buffer with audio samples, and append
     ///        it to the playing queue
@@ -253,7 +482,7 @@ private:
     /// consumed; it fills it again and inserts it back into the
     /// playing queue.
     ///
-    /// \param bufferNum Number of the buffer to fill (in [0, BufferCount])
+    /// \param bufferNum Number of the buffer to fill (in [0, MaxBufferCount])
     /// \param immediateLoop Treat empty buffers as spent, and act on loops immediately
     ///
     /// \return True if the stream source has requested to stop, false otherwise
@@ -261,6 +490,29 @@ private:
     ////////////////////////////////////////////////////////////
     bool fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a chunk from onGetData() or onGetFloatData()
+    ///
+    /// \param data      Chunk to fill with 16-bit samples
+    /// \param floatData Chunk to fill with floating point samples
+    ///
+    /// \return Return value of the called function
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getData(Chunk& data, FloatChunk& floatData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the position of a running stream
+    ///
+    /// This function is called by the streaming loop. It drops
+    /// the queued buffers, lets the derived class seek and
+    /// refills the queue from the new position.
+    ///
+    /// \param timeOffset New playing position, from the beginning of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    void seekStreaming(Time timeOffset);
+
     ////////////////////////////////////////////////////////////
     /// \brief Fill the audio buffers and put them all into the playing queue
     ///
@@ -280,26 +532,58 @@ private:
     ////////////////////////////////////////////////////////////
     void clearQueue();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute how long the streaming loop can sleep
+    ///
+    /// The delay is derived from the amount of audio left in
+    /// the playing queue, so that the loop wakes up right after
+    /// the oldest buffer has been consumed, but early enough
+    /// to refill the queue before it runs dry.
+    /// This function also updates the queue statistics.
+    ///
+    /// \param queued Receives the duration of audio left in the queue
+    ///
+    /// \return Time to wait before the next update
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRefillDelay(Time& queued);
+
     enum
     {
-        BufferCount = 3,    ///< Number of audio buffers used by the streaming loop
-        BufferRetries = 2   ///< Number of retries (excluding initial try) for onGetData()
+        MaxBufferCount = 16, ///< Maximum number of audio buffers used by the streaming loop
+        BufferRetries = 2    ///< Number of retries (excluding initial try) for onGetData()
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread        m_thread;                  ///< Thread running the background tasks
-    mutable Mutex m_threadMutex;             ///< Thread mutex
-    Status        m_threadStartState;        ///< State the thread starts in (Playing, Paused, Stopped)
-    bool          m_isStreaming;             ///< Streaming state (true = playing, false = stopped)
-    unsigned int  m_buffers[BufferCount];    ///< Sound buffers used to store temporary audio data
-    unsigned int  m_channelCount;            ///< Number of channels (1 = mono, 2 = stereo, ...)
-    unsigned int  m_sampleRate;              ///< Frequency (samples / second)
-    Uint32        m_format;                  ///< Format of the internal sound buffers
-    bool          m_loop;                    ///< Loop flag (true to loop, false to play once)
-    Uint64        m_samplesProcessed;        ///< Number of buffers processed since beginning of the stream
-    bool          m_endBuffers[BufferCount]; ///< Each buffer is marked as "end buffer" or not, for proper duration calculation
+    Thread        m_thread;                        ///< Thread running the background tasks
+    mutable Mutex m_threadMutex;                   ///< Thread mutex
+    Signal        m_wakeUp;                        ///< Signal used to interrupt the dedicated thread, or to report the release of the stream by the shared workers
+    Status        m_threadStartState;              ///< State the thread starts in (Playing, Paused, Stopped)
+    bool          m_isStreaming;                   ///< Streaming state (true = playing, false = stopped)
+    bool          m_dedicatedThread;               ///< Use m_thread instead of the shared workers?
+    bool          m_requestStop;                   ///< Has the stream source requested to stop?
+    bool          m_seekPending;                   ///< Has a seek been requested to the streaming loop?
+    Time          m_seekOffset;                    ///< Playing position requested by the pending seek
+    unsigned int  m_bufferCount;                   ///< Number of buffers requested by the user
+    unsigned int  m_activeBufferCount;             ///< Number of buffers used by the running streaming loop
+    Time          m_chunkDuration;                 ///< Preferred duration of the chunks
+    unsigned int  m_buffers[MaxBufferCount];       ///< Sound buffers used to store temporary audio data
+    unsigned int  m_channelCount;                  ///< Number of channels (1 = mono, 2 = stereo, ...)
+    unsigned int  m_sampleRate;                    ///< Frequency (samples / second)
+    Uint32        m_format;                        ///< Format of the internal sound buffers
+    bool          m_floatSamples;                  ///< Does the stream source provide floating point samples?
+    Uint32        m_floatFormat;                   ///< Floating point format of the internal sound buffers (0 if not supported)
+    std::vector<Int16> m_conversionBuffer;         ///< Floating point samples converted to 16-bit integers, when the device doesn't support floating point buffers
+    bool          m_loop;                          ///< Loop flag (true to loop, false to play once)
+    Uint64        m_samplesProcessed;              ///< Number of buffers processed since beginning of the stream
+    bool          m_endBuffers[MaxBufferCount];    ///< Each buffer is marked as "end buffer" or not, for proper duration calculation
+    Uint64        m_bufferFrames[MaxBufferCount];  ///< Number of frames stored in each buffer
+    unsigned int  m_queue[MaxBufferCount];         ///< Numbers of the buffers in the playing queue, oldest first
+    unsigned int  m_queueStart;                    ///< Index of the oldest buffer in m_queue
+    unsigned int  m_queueSize;                     ///< Number of buffers in the playing queue
+    Statistics    m_statistics;                    ///< Streaming statistics
 };
 
 } // namespace sf
@@ -333,13 +617,22 @@ private:
 /// \li onGetData fills a new chunk of audio data to be played
 /// \li onSeek changes the current playing position in the source
 ///
-/// It is important to note that each SoundStream is played in its
-/// own separate thread, so that the streaming loop doesn't block the
-/// rest of the program. In particular, the OnGetData and OnSeek
-/// virtual functions may sometimes be called from this separate thread.
+/// It is important to note that SoundStreams are played in separate
+/// threads, so that the streaming loop doesn't block the rest of the
+/// program. By default a small pool of worker threads is shared by all
+/// the streams (see setDedicatedThread). In particular, the OnGetData and OnSeek
+/// virtual functions may sometimes be called from these separate threads.
 /// It is important to keep this in mind, because you may have to take
 /// care of synchronization issues if you share data between threads.
 ///
+/// The latency of the stream is controlled by the number of
+/// buffers (setBufferCount) and the duration of each chunk
+/// (setChunkDuration). The streaming thread sleeps until the
+/// oldest queued buffer has been played, and runs with a
+/// realtime priority when the system allows it.
+/// getStatistics() reports underruns and the fill level of the
+/// queue, which helps tuning these two values.
+///
 /// Usage example:
 /// \code
 /// class CustomStream : public sf::SoundStream
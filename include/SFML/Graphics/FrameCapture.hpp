@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FRAMECAPTURE_HPP
+#define SFML_FRAMECAPTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class Window;
+
+////////////////////////////////////////////////////////////
+/// \brief Captures the frames of a window without waiting
+///        for the GPU
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API FrameCapture : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Type of the function receiving the captured frames
+    ///
+    /// \param pixels   Array of width * height RGBA pixels, top-down; it is
+    ///                 only valid until the function returns
+    /// \param width    Width of the frame, in pixels
+    /// \param height   Height of the frame, in pixels
+    /// \param userData User data given to setCallback
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*Callback)(const Uint8* pixels, unsigned int width, unsigned int height, void* userData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The default latency is 2 frames.
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameCapture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The frames that were not delivered yet are discarded,
+    /// call flush() before to get them.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~FrameCapture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the function receiving the captured frames
+    ///
+    /// \param callback Function to call for each frame, can be NULL
+    /// \param userData Pointer passed to the function
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCallback(Callback callback, void* userData = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of frames between a capture and its delivery
+    ///
+    /// Reading a frame back right after drawing it makes the
+    /// CPU wait until the GPU has finished rendering it. With a
+    /// latency of N frames, the frame captured by a call to
+    /// capture() is delivered N calls later, when the GPU is
+    /// done with it. A latency of 0 delivers the frames
+    /// immediately, like sf::RenderWindow::capture.
+    /// The pending frames are delivered first.
+    ///
+    /// \param frames Number of frames of latency
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLatency(std::size_t frames);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames between a capture and its delivery
+    ///
+    /// \return Number of frames of latency
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLatency() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture the current contents of a window
+    ///
+    /// This function must be called after drawing and before
+    /// calling display() on the window. The contents are copied
+    /// to a texture by the GPU, and the callback receives the
+    /// frame captured \a latency calls before, if any.
+    ///
+    /// \param window Window to capture
+    ///
+    /// \return True if the contents were copied
+    ///
+    ////////////////////////////////////////////////////////////
+    bool capture(const Window& window);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deliver all the pending frames now
+    ///
+    /// This function waits until the GPU has finished rendering
+    /// the pending frames, for example when the recording stops.
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames captured but not delivered yet
+    ///
+    /// \return Number of pending frames
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+private:
+
+    struct Slot;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a captured frame back and give it to the callback
+    ///
+    /// \param slot Slot containing the frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void deliver(Slot& slot);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Slot*> m_slots;    ///< Ring of textures receiving the captures
+    std::size_t        m_next;     ///< Index of the slot receiving the next capture
+    std::vector<Uint8> m_pixels;   ///< Buffer receiving the pixels read back
+    Callback           m_callback; ///< Function receiving the frames
+    void*              m_userData; ///< User data passed to the callback
+};
+
+} // namespace sf
+
+
+#endif // SFML_FRAMECAPTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FrameCapture
+/// \ingroup graphics
+///
+/// sf::RenderWindow::capture reads the window back as soon as
+/// it is called, which makes the CPU wait until the GPU has
+/// finished drawing the frame. That's fine for a screenshot,
+/// but too slow to record a video or to take thumbnails while
+/// the application is running.
+///
+/// sf::FrameCapture instead copies the frames to a ring of
+/// textures on the GPU, and reads each one back a few frames
+/// later, when it is ready. The pixels are given to a callback
+/// function. They are read through a framebuffer object
+/// attached to the texture when the OpenGL implementation
+/// supports them, otherwise with sf::Texture::copyToImage.
+///
+/// Usage example:
+/// \code
+/// void writeFrame(const sf::Uint8* pixels, unsigned int width, unsigned int height, void* userData)
+/// {
+///     VideoEncoder* encoder = static_cast<VideoEncoder*>(userData);
+///     encoder->addFrame(pixels, width, height);
+/// }
+///
+/// sf::FrameCapture recorder;
+/// recorder.setCallback(&writeFrame, &encoder);
+///
+/// while (window.isOpen())
+/// {
+///     window.clear();
+///     window.draw(scene);
+///     recorder.capture(window);
+///     window.display();
+/// }
+///
+/// recorder.flush();
+/// \endcode
+///
+/// \see sf::RenderWindow::capture
+///
+////////////////////////////////////////////////////////////
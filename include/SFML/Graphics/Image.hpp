@@ -47,6 +47,17 @@ class SFML_GRAPHICS_API Image
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters available to resample an image
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ResampleFilter
+    {
+        Box,      ///< Average of the covered pixels (nearest pixel when enlarging); fastest, best suited to mipmaps
+        Bilinear, ///< Linear interpolation, with a wider support when shrinking
+        Lanczos   ///< 3-lobed Lanczos windowed sinc; sharpest, but slowest
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -86,6 +97,40 @@ public:
     ////////////////////////////////////////////////////////////
     void create(unsigned int width, unsigned int height, const Uint8* pixels);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the image from an array of BGRA pixels
+    ///
+    /// This is the same as create(width, height, pixels), except
+    /// that the red and blue components of the source pixels are
+    /// swapped. This is the layout used by most framebuffers and
+    /// by many windowing systems.
+    ///
+    /// \param width  Width of the image
+    /// \param height Height of the image
+    /// \param pixels Array of pixels to copy to the image
+    ///
+    /// \see copyToBgra
+    ///
+    ////////////////////////////////////////////////////////////
+    void createFromBgra(unsigned int width, unsigned int height, const Uint8* pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the image from an array of 16-bit RGB565 pixels
+    ///
+    /// The \a pixels array is assumed to contain width * height
+    /// values, with red in the 5 most significant bits and blue
+    /// in the 5 least significant bits. The pixels of the image
+    /// are opaque.
+    ///
+    /// \param width  Width of the image
+    /// \param height Height of the image
+    /// \param pixels Array of pixels to copy to the image
+    ///
+    /// \see copyToRgb565
+    ///
+    ////////////////////////////////////////////////////////////
+    void createFromRgb565(unsigned int width, unsigned int height, const Uint16* pixels);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file on disk
     ///
@@ -179,10 +224,10 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Copy pixels from another image onto this one
     ///
-    /// This function does a slow pixel copy and should not be
-    /// used intensively. It can be used to prepare a complex
-    /// static image from several others, but if you need this
-    /// kind of feature in real-time you'd better use sf::RenderTexture.
+    /// This function copies the pixels on the CPU. It can be used
+    /// to prepare a complex static image from several others, but
+    /// if you need this kind of feature in real-time you'd better
+    /// use sf::RenderTexture.
     ///
     /// If \a sourceRect is empty, the whole image is copied.
     /// If \a applyAlpha is set to true, the transparency of
@@ -258,6 +303,117 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the color components of every pixel by its alpha
+    ///
+    /// Premultiplied pixels can be blended with a simple addition,
+    /// without color fringes around the transparent areas.
+    ///
+    /// \see unpremultiplyAlpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void premultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Divide the color components of every pixel by its alpha
+    ///
+    /// This is the inverse of premultiplyAlpha, up to the
+    /// precision lost by the premultiplication. The color of
+    /// fully transparent pixels becomes black.
+    ///
+    /// \see premultiplyAlpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void unpremultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the pixels to an array of BGRA pixels
+    ///
+    /// The \a pixels array must be large enough to contain
+    /// getSize().x * getSize().y * 4 bytes.
+    ///
+    /// \param pixels Array to fill
+    ///
+    /// \see createFromBgra
+    ///
+    ////////////////////////////////////////////////////////////
+    void copyToBgra(Uint8* pixels) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the pixels to an array of 16-bit RGB565 pixels
+    ///
+    /// The alpha component is dropped. The \a pixels array
+    /// must be large enough to contain getSize().x * getSize().y
+    /// values.
+    ///
+    /// \param pixels Array to fill
+    ///
+    /// \see createFromRgb565
+    ///
+    ////////////////////////////////////////////////////////////
+    void copyToRgb565(Uint16* pixels) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the size of the image, resampling its pixels
+    ///
+    /// The pixels are filtered with premultiplied alpha, so that
+    /// the color of transparent pixels doesn't bleed into their
+    /// neighbours. The rows are processed in parallel by a pool
+    /// of threads (see setThreadCount).
+    /// If \a width or \a height is 0, the image becomes empty.
+    ///
+    /// \param width  New width of the image
+    /// \param height New height of the image
+    /// \param filter Filter used to compute the new pixels
+    ///
+    /// \see buildMipChain
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(unsigned int width, unsigned int height, ResampleFilter filter = Bilinear);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the successive mipmap levels of the image
+    ///
+    /// Each level is half the size of the previous one (rounded
+    /// down, and at least 1 pixel), down to 1x1. The image itself
+    /// (level 0) is not included. The levels can be uploaded
+    /// to a texture with sf::Texture::updateMipmap.
+    ///
+    /// \param levels Vector to fill with the levels 1 to N
+    /// \param filter Filter used to compute each level from the previous one
+    ///
+    /// \see resize
+    ///
+    ////////////////////////////////////////////////////////////
+    void buildMipChain(std::vector<Image>& levels, ResampleFilter filter = Box) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads used to resample images
+    ///
+    /// The worker threads are started the first time a large
+    /// image is resampled. Changing the number of threads stops
+    /// the running workers, and the next resampling starts the
+    /// new number of them; a count of 1 stops all the workers,
+    /// which can be used to release them before unloading SFML.
+    /// The default is 4.
+    ///
+    /// \param count Number of threads, including the calling thread
+    ///
+    /// \see getThreadCount, resize, buildMipChain
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads used to resample images
+    ///
+    /// \return Number of threads, including the calling thread
+    ///
+    /// \see setThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getThreadCount();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -44,7 +44,7 @@ enum PrimitiveType
     Triangles,     ///< List of individual triangles
     TriangleStrip, ///< List of connected triangles, a point uses the two previous points to form a triangle
     TriangleFan,   ///< List of connected triangles, a point uses the common center and the previous point to form a triangle
-    Quads,         ///< List of individual quads (deprecated, don't work with OpenGL ES)
+    Quads,         ///< List of individual quads (drawn as indexed triangles)
 
     // Deprecated names
     LinesStrip     = LineStrip,     ///< \deprecated Use LineStrip instead
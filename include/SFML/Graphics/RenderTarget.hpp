@@ -38,6 +38,7 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
@@ -247,6 +248,47 @@ public:
     void draw(const Vertex* vertices, std::size_t vertexCount,
               PrimitiveType type, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices and 16-bit indices
+    ///
+    /// The primitives are built from the vertices referenced by
+    /// \a indices, in this order; shared vertices only have to be
+    /// stored and transformed once. Each index must be lower than
+    /// \a vertexCount.
+    ///
+    /// The sf::Quads primitive type is not supported by indexed
+    /// draws; use sf::Triangles with 6 indices per quad instead.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, const Uint16* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices and 32-bit indices
+    ///
+    /// This overload can address more than 65536 vertices. On
+    /// OpenGL ES implementations that don't support 32-bit
+    /// indices, the indices are converted to 16 bits if
+    /// possible, otherwise the draw is skipped.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, const Uint32* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -345,6 +387,23 @@ public:
     ////////////////////////////////////////////////////////////
     void resetGLStates();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of redundant OpenGL calls skipped so far
+    ///
+    /// The render target keeps a copy of the OpenGL states it
+    /// sets (matrices, bound texture and shader, blending, client
+    /// states and vertex pointers), and skips the calls that
+    /// wouldn't change them. The difference between the values
+    /// returned at two successive frames gives the number of
+    /// calls saved during a frame; when SFML is compiled with
+    /// the profiler, the "Elided GL calls" counter records it
+    /// directly.
+    ///
+    /// \return Number of OpenGL calls skipped since the target was created
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getElidedGlCallCount() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -394,6 +453,14 @@ private:
     ////////////////////////////////////////////////////////////
     void applyTexture(const Texture* texture);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a new texture matrix, unless it is already loaded
+    ///
+    /// \param matrix 4x4 matrix to load
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyTextureMatrix(const float* matrix);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new shader
     ///
@@ -402,6 +469,49 @@ private:
     ////////////////////////////////////////////////////////////
     void applyShader(const Shader* shader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Count OpenGL calls skipped by the states cache
+    ///
+    /// \param count Number of calls skipped
+    ///
+    ////////////////////////////////////////////////////////////
+    void addElidedCalls(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Setup the OpenGL states and vertex pointers for a draw
+    ///
+    /// Must be called with the target active.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupDraw(const Vertex* vertices, std::size_t vertexCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore the OpenGL states after a draw
+    ///
+    /// \param states Render states used for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void cleanupDraw(const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param indexType   OpenGL type of the indices
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawElements(const Vertex* vertices, std::size_t vertexCount, const void* indices, std::size_t indexCount,
+                      unsigned int indexType, PrimitiveType type, const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Render states cache
     ///
@@ -410,21 +520,29 @@ private:
     {
         enum {VertexCacheSize = 4};
 
-        bool      glStatesSet;    ///< Are our internal GL states set yet?
-        bool      viewChanged;    ///< Has the current view changed since last draw?
-        BlendMode lastBlendMode;  ///< Cached blending mode
-        Uint64    lastTextureId;  ///< Cached texture
-        bool      texCoordsArrayEnabled; ///< Is GL_TEXTURE_COORD_ARRAY client state enabled?
-        bool      useVertexCache; ///< Did we previously use the vertex cache?
-        Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
+        bool          glStatesSet;           ///< Are our internal GL states set yet?
+        bool          viewChanged;           ///< Has the current view changed since last draw?
+        BlendMode     lastBlendMode;         ///< Cached blending mode
+        Uint64        lastTextureId;         ///< Cached texture
+        bool          shaderBound;           ///< Is a shader left bound by the last draw?
+        bool          texCoordsArrayEnabled; ///< Is GL_TEXTURE_COORD_ARRAY client state enabled?
+        bool          transformSet;          ///< Is lastTransform the current model-view matrix?
+        Transform     lastTransform;         ///< Cached model-view matrix
+        bool          textureMatrixSet;      ///< Is textureMatrix the current texture matrix?
+        float         textureMatrix[16];     ///< Cached texture matrix
+        const Vertex* vertexPointer;         ///< Cached array given to glVertexPointer and glColorPointer
+        const Vertex* texCoordsPointer;      ///< Cached array given to glTexCoordPointer
+        Uint64        elidedCalls;           ///< Number of redundant GL calls skipped
+        Vertex        vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; ///< Default view
-    View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
+    View                m_defaultView;  ///< Default view
+    View                m_view;         ///< Current view
+    StatesCache         m_cache;        ///< Render states cache
+    std::vector<Uint16> m_shortIndices; ///< 32-bit indices converted to 16-bit when the former are not supported
 };
 
 } // namespace sf
@@ -151,6 +151,8 @@ public:
     /// update(Window&) function.
     /// You can also draw things directly to a texture with the
     /// sf::RenderTexture class.
+    /// To record many frames, sf::FrameCapture reads them back
+    /// a few frames later instead of waiting for the GPU.
     ///
     /// \return Image containing the captured contents
     ///
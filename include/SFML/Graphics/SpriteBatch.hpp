@@ -0,0 +1,395 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPRITEBATCH_HPP
+#define SFML_SPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Drawable set of textured quads sharing the same
+///        texture, drawn with a single draw call
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteBatch : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch with no source texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty batch from a source texture
+    ///
+    /// \param texture Source texture
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpriteBatch(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source texture of the batch
+    ///
+    /// The \a texture argument refers to a texture that must
+    /// exist as long as the batch uses it. Indeed, the batch
+    /// doesn't store its own copy of the texture, but rather keeps
+    /// a pointer to the one that you passed to this function.
+    /// The texture rectangles of the sprites are left unchanged.
+    ///
+    /// \param texture New texture
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture of the batch
+    ///
+    /// If the batch has no source texture, a NULL pointer is returned.
+    ///
+    /// \return Pointer to the batch's texture
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sprite to the batch
+    ///
+    /// The origin of the new sprite is (0, 0). If \a textureRect
+    /// is empty, the sprite displays the whole texture.
+    ///
+    /// \param textureRect Sub-rectangle of the texture displayed by the sprite
+    /// \param position    Position of the sprite
+    /// \param rotation    Rotation of the sprite, in degrees
+    /// \param scale       Scale factors of the sprite
+    /// \param color       Global color of the sprite
+    ///
+    /// \return Index of the new sprite
+    ///
+    /// \see remove
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const IntRect& textureRect, const Vector2f& position = Vector2f(0, 0), float rotation = 0.f,
+                    const Vector2f& scale = Vector2f(1, 1), const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a sprite from the batch
+    ///
+    /// The last sprite of the batch is moved to \a index, so
+    /// that removing a sprite is a constant time operation;
+    /// the indices of the other sprites are unchanged.
+    ///
+    /// \param index Index of the sprite to remove
+    ///
+    /// \see add, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sprites from the batch
+    ///
+    /// The memory is kept, to be reused by the next sprites.
+    ///
+    /// \see remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve memory for a number of sprites
+    ///
+    /// \param count Number of sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sprites in the batch
+    ///
+    /// \return Number of sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSpriteCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of a sprite
+    ///
+    /// \param index    Index of the sprite
+    /// \param position New position
+    ///
+    /// \see getPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(std::size_t index, const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Current position
+    ///
+    /// \see setPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getPosition(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the rotation of a sprite
+    ///
+    /// \param index Index of the sprite
+    /// \param angle New rotation, in degrees
+    ///
+    /// \see getRotation
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRotation(std::size_t index, float angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rotation of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Current rotation, in degrees, in the range [0, 360]
+    ///
+    /// \see setRotation
+    ///
+    ////////////////////////////////////////////////////////////
+    float getRotation(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scale factors of a sprite
+    ///
+    /// \param index   Index of the sprite
+    /// \param factors New scale factors
+    ///
+    /// \see getScale
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScale(std::size_t index, const Vector2f& factors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scale factors of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Current scale factors
+    ///
+    /// \see setScale
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getScale(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the local origin of a sprite
+    ///
+    /// The origin is the center point of the rotation and
+    /// scaling of the sprite, relative to its top-left corner.
+    ///
+    /// \param index  Index of the sprite
+    /// \param origin New origin
+    ///
+    /// \see getOrigin
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOrigin(std::size_t index, const Vector2f& origin);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local origin of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Current origin
+    ///
+    /// \see setOrigin
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getOrigin(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sub-rectangle of the texture displayed by a sprite
+    ///
+    /// \param index       Index of the sprite
+    /// \param textureRect Rectangle defining the region of the texture to display
+    ///
+    /// \see getTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(std::size_t index, const IntRect& textureRect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sub-rectangle of the texture displayed by a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Texture rectangle of the sprite
+    ///
+    /// \see setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the global color of a sprite
+    ///
+    /// \param index Index of the sprite
+    /// \param color New color of the sprite
+    ///
+    /// \see getColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColor(std::size_t index, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global color of a sprite
+    ///
+    /// \param index Index of the sprite
+    ///
+    /// \return Global color of the sprite
+    ///
+    /// \see setColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getColor(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the bounding rectangle of all the sprites
+    ///
+    /// \return Bounding rectangle of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the vertices are updated
+    ///
+    /// All the attributes are updated only if necessary.
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureVerticesUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*              m_texture;              ///< Texture of the sprites
+    std::vector<Vector2f>       m_positions;            ///< Position of each sprite
+    std::vector<Vector2f>       m_origins;              ///< Origin of each sprite
+    std::vector<Vector2f>       m_scales;               ///< Scale factors of each sprite
+    std::vector<float>          m_rotations;            ///< Rotation of each sprite, in degrees
+    std::vector<float>          m_cosines;              ///< Cosine of the rotation of each sprite
+    std::vector<float>          m_sines;                ///< Sine of the rotation of each sprite
+    std::vector<IntRect>        m_textureRects;         ///< Texture rectangle of each sprite
+    std::vector<Color>          m_colors;               ///< Color of each sprite
+    mutable std::vector<Vertex> m_vertices;             ///< Quads of all the sprites (4 vertices per sprite)
+    mutable bool                m_positionsNeedUpdate;  ///< Do the vertex positions need to be recomputed?
+    mutable bool                m_attributesNeedUpdate; ///< Do the texture coordinates and colors need to be recomputed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteBatch
+/// \ingroup graphics
+///
+/// sf::SpriteBatch draws a large number of textured quads
+/// (sprites) that share the same texture with a single draw
+/// call. Drawing thousands of sf::Sprite instances requires
+/// as many draw calls, because their triangle strips can't
+/// be concatenated; a sprite batch instead generates a single
+/// list of independent quads, drawn as indexed triangles.
+///
+/// The attributes of the sprites (position, rotation, scale,
+/// origin, texture rectangle and color) are stored in separate
+/// arrays, and the vertices are regenerated in a single pass
+/// when the batch is drawn after a modification. The texture
+/// coordinates and colors are only regenerated when they
+/// change, so moving sprites only costs the update of their
+/// positions.
+///
+/// The sprites are addressed by their index, as returned by
+/// add(). Use one batch per texture: all the sprites of a
+/// batch share its texture and render states. The batch
+/// itself is not transformable, but a transform can be
+/// applied to all the sprites with the render states.
+///
+/// Usage example:
+/// \code
+/// sf::Texture texture;
+/// texture.loadFromFile("particles.png");
+///
+/// sf::SpriteBatch batch(texture);
+/// batch.reserve(10000);
+/// for (int i = 0; i < 10000; ++i)
+/// {
+///     std::size_t index = batch.add(sf::IntRect(0, 0, 16, 16), sf::Vector2f(i % 100 * 8, i / 100 * 6));
+///     batch.setOrigin(index, sf::Vector2f(8, 8));
+/// }
+///
+/// // In the main loop
+/// for (std::size_t i = 0; i < batch.getSpriteCount(); ++i)
+///     batch.setRotation(i, batch.getRotation(i) + 1);
+///
+/// window.draw(batch);
+/// \endcode
+///
+/// \see sf::Sprite, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
@@ -201,17 +201,23 @@ public:
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
+    /// If \a buildMipmap is true, the mipmap levels are computed
+    /// on the CPU with Image::buildMipChain and uploaded along with
+    /// the pixels; unlike generateMipmap, this doesn't require
+    /// any OpenGL extension.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
-    /// \param image Image to load into the texture
-    /// \param area  Area of the image to load
+    /// \param image       Image to load into the texture
+    /// \param area        Area of the image to load
+    /// \param buildMipmap Compute and upload the mipmap levels too?
     ///
     /// \return True if loading was successful
     ///
-    /// \see loadFromFile, loadFromMemory
+    /// \see loadFromFile, loadFromMemory, updateMipmap
     ///
     ////////////////////////////////////////////////////////////
-    bool loadFromImage(const Image& image, const IntRect& area = IntRect());
+    bool loadFromImage(const Image& image, const IntRect& area = IntRect(), bool buildMipmap = false);
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the texture
@@ -507,6 +513,29 @@ public:
     ////////////////////////////////////////////////////////////
     bool generateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload mipmap levels computed on the CPU
+    ///
+    /// \a levels contains the levels 1 to N, as filled by
+    /// Image::buildMipChain; level 0 is the current content of
+    /// the texture. Each level must fit in the corresponding
+    /// level of the texture. Missing levels are left undefined,
+    /// and as for generateMipmap, the mipmap has to be uploaded
+    /// again after the texture is modified.
+    ///
+    /// This is an alternative to generateMipmap for the drivers
+    /// that don't support it, or when the levels must be
+    /// computed with a specific filter.
+    ///
+    /// \param levels Mipmap levels to upload
+    ///
+    /// \return True if the levels were uploaded, false if one of them doesn't fit
+    ///
+    /// \see generateMipmap, Image::buildMipChain
+    ///
+    ////////////////////////////////////////////////////////////
+    bool updateMipmap(const std::vector<Image>& levels);
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -611,6 +640,17 @@ private:
     ////////////////////////////////////////////////////////////
     void invalidateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the texture matrix needed to bind the texture
+    ///
+    /// \param coordinateType Type of texture coordinates to use
+    /// \param matrix         Array of 16 floats receiving the matrix
+    ///
+    /// \return True if the matrix is not the identity
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getTextureMatrix(CoordinateType coordinateType, float* matrix) const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -320,6 +320,9 @@ private:
     Vector2f          m_position;                   ///< Position of the object in the 2D world
     float             m_rotation;                   ///< Orientation of the object, in degrees
     Vector2f          m_scale;                      ///< Scale of the object
+    mutable float     m_cosine;                     ///< Cosine of the rotation angle
+    mutable float     m_sine;                       ///< Sine of the rotation angle
+    mutable bool      m_rotationNeedUpdate;         ///< Do the cosine and sine need to be recomputed?
     mutable Transform m_transform;                  ///< Combined transformation of the object
     mutable bool      m_transformNeedUpdate;        ///< Does the transform need to be recomputed?
     mutable Transform m_inverseTransform;           ///< Combined transformation of the object
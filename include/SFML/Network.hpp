@@ -34,6 +34,10 @@
 #include <SFML/Network/Http.hpp>
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Packet.hpp>
+#include <SFML/Network/PacketCipher.hpp>
+#include <SFML/Network/PacketCompressor.hpp>
+#include <SFML/Network/PacketPipeline.hpp>
+#include <SFML/Network/PacketTransform.hpp>
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketHandle.hpp>
 #include <SFML/Network/SocketSelector.hpp>
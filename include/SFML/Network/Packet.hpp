@@ -35,6 +35,7 @@
 
 namespace sf
 {
+class PacketPipeline;
 class String;
 class TcpSocket;
 class UdpSocket;
@@ -130,6 +131,37 @@ public:
 
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the pipeline used to transform the packet data
+    ///
+    /// When a pipeline is set, the default implementations of
+    /// onSend and onReceive encode the data with it before it is
+    /// sent, and decode the data with it after it is received.
+    /// If the received data can't be decoded (for example because
+    /// it was corrupted or forged), the packet is left empty and
+    /// its reading state becomes invalid.
+    ///
+    /// The packet doesn't take ownership of the pipeline, which
+    /// must remain alive as long as the packet uses it.
+    /// Pass NULL to disable the transformations (the default).
+    ///
+    /// \param pipeline Pipeline to use, or NULL
+    ///
+    /// \see getPipeline
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPipeline(PacketPipeline* pipeline);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the pipeline used to transform the packet data
+    ///
+    /// \return Pipeline used by the packet, or NULL if there is none
+    ///
+    /// \see setPipeline
+    ///
+    ////////////////////////////////////////////////////////////
+    PacketPipeline* getPipeline() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Test the validity of the packet, for reading
     ///
@@ -226,7 +258,13 @@ protected:
     /// The function must return a pointer to the modified data,
     /// as well as the number of bytes pointed.
     /// The default implementation provides the packet's data
-    /// without transforming it.
+    /// transformed by its pipeline, if any, or without
+    /// transforming it otherwise.
+    /// When the packet has a pipeline, a NULL pointer means
+    /// that the data couldn't be encoded: the socket then
+    /// doesn't send anything and returns sf::Socket::Error.
+    /// Data successfully encoded to nothing must be returned
+    /// as a non-NULL pointer with a size of 0.
     ///
     /// \param size Variable to fill with the size of data to send
     ///
@@ -245,8 +283,9 @@ protected:
     /// used for decompression, decryption, etc.
     /// The function receives a pointer to the received data,
     /// and must fill the packet with the transformed bytes.
-    /// The default implementation fills the packet directly
-    /// without transforming the data.
+    /// The default implementation fills the packet with the
+    /// data decoded by its pipeline, if any, or directly
+    /// without transforming the data otherwise.
     ///
     /// \param data Pointer to the received bytes
     /// \param size Number of bytes
@@ -280,10 +319,12 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_data;    ///< Data stored in the packet
-    std::size_t       m_readPos; ///< Current reading position in the packet
-    std::size_t       m_sendPos; ///< Current send position in the packet (for handling partial sends)
-    bool              m_isValid; ///< Reading state of the packet
+    std::vector<char> m_data;     ///< Data stored in the packet
+    std::size_t       m_readPos;  ///< Current reading position in the packet
+    std::size_t       m_sendPos;  ///< Current send position in the packet (for handling partial sends)
+    bool              m_isValid;  ///< Reading state of the packet
+    PacketPipeline*   m_pipeline; ///< Pipeline transforming the data when it is sent and received
+    std::vector<char> m_encoded;  ///< Data encoded by the pipeline, kept for resuming partial sends
 };
 
 } // namespace sf
@@ -377,9 +418,22 @@ private:
 /// custom transformations to the data before it is sent,
 /// and after it is received. This is typically used to
 /// handle automatic compression or encryption of the data.
-/// This is achieved by inheriting from sf::Packet, and overriding
-/// the onSend and onReceive functions.
 ///
+/// The simplest way to do so is to attach a sf::PacketPipeline,
+/// made of built-in transforms like sf::PacketCompressor and
+/// sf::PacketCipher, to the packet:
+/// \code
+/// sf::PacketCompressor compressor;
+/// sf::PacketPipeline pipeline;
+/// pipeline.add(compressor);
+///
+/// sf::Packet packet;
+/// packet.setPipeline(&pipeline);
+/// packet << x << s << d;
+/// \endcode
+///
+/// For full control, it is also possible to inherit from
+/// sf::Packet and override the onSend and onReceive functions.
 /// Here is an example:
 /// \code
 /// class ZipPacket : public sf::Packet
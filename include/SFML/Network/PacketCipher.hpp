@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PACKETCIPHER_HPP
+#define SFML_PACKETCIPHER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/PacketTransform.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Packet transform that encrypts and authenticates
+///        data with ChaCha20-Poly1305
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API PacketCipher : public PacketTransform
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Size of a key, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static const std::size_t KeySize = 32;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Number of bytes added to each packet (nonce and tag)
+    ///
+    ////////////////////////////////////////////////////////////
+    static const std::size_t Overhead = 28;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the cipher from a key
+    ///
+    /// The nonces generated by the cipher start with a random
+    /// prefix drawn from the system's random generator, so
+    /// the same key can be used by several peers and by
+    /// successive sessions without reusing a nonce.
+    ///
+    /// \param key Pointer to the KeySize bytes of the secret key
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PacketCipher(const void* key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encrypt outgoing data
+    ///
+    /// \param data   Pointer to the bytes to encrypt
+    /// \param size   Number of bytes pointed by \a data
+    /// \param output Buffer to fill with the encrypted bytes
+    ///
+    /// \return True if the encryption succeeded, false if no
+    ///         random nonce prefix could be generated
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool encode(const char* data, std::size_t size, std::vector<char>& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check and decrypt incoming data
+    ///
+    /// \param data   Pointer to the bytes to decrypt
+    /// \param size   Number of bytes pointed by \a data
+    /// \param output Buffer to fill with the decrypted bytes
+    ///
+    /// \return True if the data is authentic and could be decrypted
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool decode(const char* data, std::size_t size, std::vector<char>& output);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a new random prefix for the nonces
+    ///
+    /// \return True if the system's random generator succeeded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool generatePrefix();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint32 m_key[8];    ///< Secret key, as little-endian words
+    Uint32 m_prefix[2]; ///< Random part of the nonces generated by this cipher
+    Uint32 m_counter;   ///< Counter part of the next nonce
+    bool   m_hasPrefix; ///< Was a random prefix successfully generated?
+};
+
+} // namespace sf
+
+
+#endif // SFML_PACKETCIPHER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PacketCipher
+/// \ingroup network
+///
+/// sf::PacketCipher is a sf::PacketTransform that implements
+/// the ChaCha20-Poly1305 authenticated encryption scheme
+/// (RFC 8439). It is fast on CPUs without AES instructions,
+/// like the ARM cores of small devices, and is self-contained.
+///
+/// Each encrypted packet carries its 12-bytes nonce and a
+/// 16-bytes authentication tag. The nonce is made of a 64-bits
+/// random prefix, chosen when the cipher is created, and a
+/// 32-bits packet counter; a new prefix is drawn when the
+/// counter wraps around. Packets that were modified
+/// or encrypted with another key are rejected: the receiving
+/// socket then returns a packet whose reading state is
+/// invalid.
+///
+/// The cipher only guarantees confidentiality and integrity:
+/// it doesn't prevent an attacker from replaying a packet
+/// captured earlier, and it doesn't exchange the key. If it
+/// matters, the application must handle these with sequence
+/// numbers and its own key agreement.
+///
+/// When combined with a sf::PacketCompressor, the cipher
+/// must be added after the compressor, since encrypted data
+/// can't be compressed.
+///
+/// Usage example:
+/// \code
+/// sf::Uint8 key[sf::PacketCipher::KeySize] = ...; // shared secret
+/// sf::PacketCipher cipher(key);
+///
+/// sf::PacketPipeline pipeline;
+/// pipeline.add(cipher);
+/// \endcode
+///
+/// \see sf::PacketPipeline, sf::PacketCompressor
+///
+////////////////////////////////////////////////////////////
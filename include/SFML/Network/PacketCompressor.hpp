@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PACKETCOMPRESSOR_HPP
+#define SFML_PACKETCOMPRESSOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/PacketTransform.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Packet transform that compresses data with the
+///        LZ4 block format
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API PacketCompressor : public PacketTransform
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param threshold Minimum size, in bytes, of the data to compress
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PacketCompressor(std::size_t threshold = 64);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the compression threshold
+    ///
+    /// Data smaller than the threshold is sent uncompressed,
+    /// because the gain would not be worth the CPU time.
+    /// Data that would not get smaller once compressed is
+    /// sent uncompressed as well. Only the sending side uses
+    /// the threshold, the receiving side doesn't need to know it.
+    ///
+    /// \param threshold Minimum size, in bytes, of the data to compress
+    ///
+    /// \see getThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreshold(std::size_t threshold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the compression threshold
+    ///
+    /// \return Minimum size, in bytes, of the data to compress
+    ///
+    /// \see setThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getThreshold() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compress outgoing data
+    ///
+    /// \param data   Pointer to the bytes to compress
+    /// \param size   Number of bytes pointed by \a data
+    /// \param output Buffer to fill with the compressed bytes
+    ///
+    /// \return True if the compression succeeded
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool encode(const char* data, std::size_t size, std::vector<char>& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decompress incoming data
+    ///
+    /// \param data   Pointer to the bytes to decompress
+    /// \param size   Number of bytes pointed by \a data
+    /// \param output Buffer to fill with the decompressed bytes
+    ///
+    /// \return True if the data was valid and could be decompressed
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool decode(const char* data, std::size_t size, std::vector<char>& output);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t         m_threshold; ///< Minimum size of the data to compress
+    std::vector<Uint32> m_table;     ///< Hash table of the match finder, kept to avoid reallocating it for each packet
+};
+
+} // namespace sf
+
+
+#endif // SFML_PACKETCOMPRESSOR_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PacketCompressor
+/// \ingroup network
+///
+/// sf::PacketCompressor is a sf::PacketTransform that reduces
+/// the size of the packets using the LZ4 block format. LZ4
+/// trades some compression ratio for a very high speed, which
+/// suits the kind of data that games send many times per
+/// second, like world snapshots made of mostly unchanged
+/// fields.
+///
+/// The compressor is self-contained and doesn't depend on any
+/// external library. Each encoded packet starts with a small
+/// header telling whether the data is compressed and its
+/// original size, so that small or incompressible packets
+/// can be sent as is, with an overhead of a single byte.
+///
+/// Usage example:
+/// \code
+/// sf::PacketCompressor compressor(128); // don't compress packets smaller than 128 bytes
+///
+/// sf::PacketPipeline pipeline;
+/// pipeline.add(compressor);
+///
+/// sf::Packet packet;
+/// packet.setPipeline(&pipeline);
+/// \endcode
+///
+/// \see sf::PacketPipeline, sf::PacketCipher
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PACKETPIPELINE_HPP
+#define SFML_PACKETPIPELINE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class PacketTransform;
+
+////////////////////////////////////////////////////////////
+/// \brief Ordered chain of transforms applied to the data
+///        of the packets that use it
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API PacketPipeline : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty pipeline, which leaves data untouched.
+    ///
+    ////////////////////////////////////////////////////////////
+    PacketPipeline();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a transform to the end of the pipeline
+    ///
+    /// Outgoing data goes through the transforms in the order
+    /// they were added, incoming data goes through them in
+    /// reverse order. The pipeline doesn't take ownership of
+    /// the transform: it must remain alive as long as the
+    /// pipeline uses it.
+    ///
+    /// \param transform Transform to append
+    ///
+    /// \see clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(PacketTransform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the transforms from the pipeline
+    ///
+    /// \see add
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run outgoing data through all the transforms
+    ///
+    /// \param data   Pointer to the bytes to transform
+    /// \param size   Number of bytes pointed by \a data
+    /// \param output Buffer to fill with the transformed bytes
+    ///
+    /// \return True if all the transforms succeeded
+    ///
+    /// \see decode
+    ///
+    ////////////////////////////////////////////////////////////
+    bool encode(const void* data, std::size_t size, std::vector<char>& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run incoming data through all the transforms,
+    ///        in reverse order
+    ///
+    /// On success, \a result points to the restored bytes. They
+    /// are stored in an internal buffer of the pipeline and
+    /// remain valid until the next call to encode or decode.
+    ///
+    /// \param data   Pointer to the received bytes
+    /// \param size   Number of bytes pointed by \a data
+    /// \param result Variable to fill with the restored bytes
+    /// \param resultSize Variable to fill with the number of restored bytes
+    ///
+    /// \return True if all the transforms succeeded
+    ///
+    /// \see encode
+    ///
+    ////////////////////////////////////////////////////////////
+    bool decode(const void* data, std::size_t size, const char*& result, std::size_t& resultSize);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<PacketTransform*> m_transforms; ///< Transforms of the pipeline, in encoding order
+    std::vector<char>             m_buffers[2]; ///< Scratch buffers ping-ponged between the stages
+};
+
+} // namespace sf
+
+
+#endif // SFML_PACKETPIPELINE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PacketPipeline
+/// \ingroup network
+///
+/// sf::PacketPipeline chains several sf::PacketTransform
+/// instances, typically a compressor followed by a cipher.
+/// Once a pipeline is attached to a packet with
+/// sf::Packet::setPipeline, the data of the packet is encoded
+/// by the pipeline when it is sent, and decoded when it is
+/// received.
+///
+/// The intermediate results are stored in scratch buffers
+/// owned by the pipeline, and the final encoded data in a
+/// buffer owned by the packet. These buffers keep their
+/// capacity, so once the largest packet has been processed,
+/// reusing the same pipeline and packet doesn't allocate
+/// memory anymore.
+///
+/// Because of these shared buffers, a pipeline must not be
+/// used by several threads at the same time.
+///
+/// Usage example:
+/// \code
+/// sf::PacketCompressor compressor;
+/// sf::PacketCipher cipher(key);
+///
+/// sf::PacketPipeline pipeline;
+/// pipeline.add(compressor); // compress first...
+/// pipeline.add(cipher);     // ...then encrypt
+///
+/// sf::Packet packet;
+/// packet.setPipeline(&pipeline);
+/// packet << snapshot;
+/// socket.send(packet);
+/// \endcode
+///
+/// \see sf::PacketTransform, sf::Packet
+///
+////////////////////////////////////////////////////////////
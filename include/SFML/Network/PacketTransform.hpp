@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PACKETTRANSFORM_HPP
+#define SFML_PACKETTRANSFORM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract base class for reversible transformations
+///        applied to packet data (compression, encryption, ...)
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API PacketTransform
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~PacketTransform();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform outgoing data
+    ///
+    /// The transformed bytes must be written to \a output,
+    /// replacing its previous contents. The output vector is
+    /// a scratch buffer that is reused from one packet to the
+    /// next, so implementations should only resize it and
+    /// never shrink its capacity.
+    ///
+    /// \param data   Pointer to the bytes to transform
+    /// \param size   Number of bytes pointed by \a data
+    /// \param output Buffer to fill with the transformed bytes
+    ///
+    /// \return True if the transformation succeeded
+    ///
+    /// \see decode
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool encode(const char* data, std::size_t size, std::vector<char>& output) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Revert the transformation on incoming data
+    ///
+    /// Incoming data comes from the network and must not be
+    /// trusted: this function must return false, instead of
+    /// crashing or reading out of bounds, when the data is
+    /// malformed or fails an integrity check.
+    ///
+    /// \param data   Pointer to the bytes to restore
+    /// \param size   Number of bytes pointed by \a data
+    /// \param output Buffer to fill with the restored bytes
+    ///
+    /// \return True if the data could be restored
+    ///
+    /// \see encode
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool decode(const char* data, std::size_t size, std::vector<char>& output) = 0;
+};
+
+} // namespace sf
+
+
+#endif // SFML_PACKETTRANSFORM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PacketTransform
+/// \ingroup network
+///
+/// sf::PacketTransform is the interface of the building blocks
+/// of a sf::PacketPipeline. A transform turns the bytes of a
+/// packet into another representation before they are sent,
+/// and restores them after they are received.
+///
+/// SFML provides two built-in transforms: sf::PacketCompressor
+/// and sf::PacketCipher. Custom transforms only have to
+/// override the encode and decode functions:
+/// \code
+/// class XorTransform : public sf::PacketTransform
+/// {
+/// public:
+///
+///     virtual bool encode(const char* data, std::size_t size, std::vector<char>& output)
+///     {
+///         output.resize(size);
+///         for (std::size_t i = 0; i < size; ++i)
+///             output[i] = data[i] ^ 0x5A;
+///         return true;
+///     }
+///
+///     virtual bool decode(const char* data, std::size_t size, std::vector<char>& output)
+///     {
+///         return encode(data, size, output);
+///     }
+/// };
+/// \endcode
+///
+/// \see sf::PacketPipeline, sf::Packet
+///
+////////////////////////////////////////////////////////////
@@ -73,6 +73,20 @@ public:
     ////////////////////////////////////////////////////////////
     Time restart();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time of the system clock
+    ///
+    /// The clock used by sf::Clock is monotonic and its origin is
+    /// unspecified (usually the boot of the system), so the
+    /// returned value is only meaningful when compared to other
+    /// values returned by this function, such as the timestamps
+    /// of the events (sf::Event::timestamp).
+    ///
+    /// \return Current time of the system clock
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getCurrentTime();
+
 private:
 
     ////////////////////////////////////////////////////////////
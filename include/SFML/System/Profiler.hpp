@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PROFILER_HPP
+#define SFML_PROFILER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Lightweight recorder of timing zones and counters
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Profiler
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scoped timing zone
+    ///
+    /// The zone measures the time elapsed between its construction
+    /// and its destruction, and records it in a buffer owned by
+    /// the calling thread. Nothing is recorded if the profiler
+    /// is disabled when the zone starts.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_SYSTEM_API Zone : NonCopyable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Start the zone
+        ///
+        /// \param name Name of the zone; it must be a string literal,
+        ///             or at least stay valid until the trace is saved
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Zone(const char* name);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief End the zone and record it
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Zone();
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        const char* m_name;  ///< Name of the zone
+        Int64       m_begin; ///< Start time in microseconds, or -1 if the zone is not recorded
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the recording
+    ///
+    /// The profiler is disabled by default, so that the zones
+    /// and counters compiled in SFML cost a single test.
+    ///
+    /// \param enabled True to record the zones and counters
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the recording is enabled
+    ///
+    /// \return True if the zones and counters are recorded
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isEnabled();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of a counter, creating it if needed
+    ///
+    /// Looking a counter up is slow; the SFML_PROFILE_COUNTER
+    /// macro does it only once per call site.
+    ///
+    /// \param name Name of the counter; it must be a string literal,
+    ///             or at least stay valid until the trace is saved
+    ///
+    /// \return Identifier of the counter
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getCounterId(const char* name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a value to a counter for the current frame
+    ///
+    /// This function can be called from any thread.
+    ///
+    /// \param counter Identifier of the counter, returned by getCounterId
+    /// \param value   Value to add
+    ///
+    ////////////////////////////////////////////////////////////
+    static void addToCounter(unsigned int counter, Int64 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total of a counter over the last frame
+    ///
+    /// \param name Name of the counter
+    ///
+    /// \return Value of the counter when markFrame was last called,
+    ///         or 0 if the counter doesn't exist
+    ///
+    ////////////////////////////////////////////////////////////
+    static Int64 getLastFrameCounter(const char* name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the end of a frame
+    ///
+    /// This function records a "Frame" zone covering the time
+    /// since the previous call, adds the current values of the
+    /// counters to the trace and resets them, and collects the
+    /// zones recorded by all the threads. sf::Window::display
+    /// calls it when SFML is compiled with the profiler.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void markFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the recorded trace to a file
+    ///
+    /// The file uses the Chrome trace event format (JSON), which
+    /// can be opened in chrome://tracing or in Perfetto.
+    ///
+    /// \param filename Path of the file to write
+    ///
+    /// \return True if the file was successfully written
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool saveChromeTrace(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the recorded trace
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clear();
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+// Instrumentation macros, they expand to nothing unless
+// SFML_PROFILER is defined
+////////////////////////////////////////////////////////////
+#ifdef SFML_PROFILER
+
+    #define SFML_PROFILE_CONCAT_IMPL(a, b) a##b
+    #define SFML_PROFILE_CONCAT(a, b) SFML_PROFILE_CONCAT_IMPL(a, b)
+
+    #define SFML_PROFILE_ZONE(name) sf::Profiler::Zone SFML_PROFILE_CONCAT(sfmlProfileZone, __LINE__)(name)
+
+    #define SFML_PROFILE_COUNTER(name, value) \
+        do \
+        { \
+            static const unsigned int sfmlCounterId = sf::Profiler::getCounterId(name); \
+            sf::Profiler::addToCounter(sfmlCounterId, value); \
+        } while (false)
+
+    #define SFML_PROFILE_FRAME() sf::Profiler::markFrame()
+
+#else
+
+    #define SFML_PROFILE_ZONE(name)
+    #define SFML_PROFILE_COUNTER(name, value) do {} while (false)
+    #define SFML_PROFILE_FRAME() do {} while (false)
+
+#endif
+
+
+#endif // SFML_PROFILER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Profiler
+/// \ingroup system
+///
+/// sf::Profiler records named timing zones and counters, to
+/// find out where the time of a frame goes. The zones are
+/// stored in a lock-free buffer owned by each thread, so
+/// that measuring doesn't disturb the measured code; they
+/// are collected at the end of each frame.
+///
+/// The profiling code is compiled only when SFML_PROFILER is
+/// defined (CMake option SFML_ENABLE_PROFILER), otherwise the
+/// SFML_PROFILE_ZONE, SFML_PROFILE_COUNTER and SFML_PROFILE_FRAME
+/// macros expand to nothing. When compiled, it still records
+/// nothing until it is enabled with setEnabled.
+///
+/// The CMake option only applies to the compilation of SFML:
+/// the macros are expanded in your own code according to your
+/// own definitions, so you must also define SFML_PROFILER in
+/// your project (for example with -DSFML_PROFILER) to record
+/// your zones and counters with them. The sf::Profiler class
+/// itself is always available, whatever the option.
+///
+/// Each thread that records a zone gets a buffer of 16384
+/// zones. The buffer is released when the thread exits, and
+/// reused by the next thread that records a zone.
+///
+/// SFML itself defines zones around the expensive operations
+/// (drawing, texture uploads, glyph rendering, buffer swaps)
+/// and counts the draw calls, the state changes in
+/// sf::RenderTarget, the uploaded texture bytes and the glyph
+/// cache misses.
+///
+/// Usage example:
+/// \code
+/// sf::Profiler::setEnabled(true);
+///
+/// while (window.isOpen())
+/// {
+///     {
+///         SFML_PROFILE_ZONE("Update");
+///         updateWorld();
+///     }
+///
+///     window.clear();
+///     drawWorld(window);
+///     window.display(); // marks the end of the frame
+/// }
+///
+/// sf::Profiler::saveChromeTrace("trace.json");
+/// \endcode
+///
+////////////////////////////////////////////////////////////
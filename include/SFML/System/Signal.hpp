@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SIGNAL_HPP
+#define SFML_SIGNAL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class SignalImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Lets a thread sleep until another thread wakes it up
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Signal : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The signal is initially not raised.
+    ///
+    ////////////////////////////////////////////////////////////
+    Signal();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Signal();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Raise the signal
+    ///
+    /// If a thread is waiting on the signal, it is woken up.
+    /// Otherwise, the signal stays raised and the next call
+    /// to wait() returns immediately.
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void notify();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the signal is raised
+    ///
+    /// This function blocks until another thread calls notify(),
+    /// and lowers the signal before returning.
+    ///
+    /// \see notify
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the signal is raised, or a timeout expires
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if the signal was raised, false if the timeout expired
+    ///
+    /// \see notify
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Time timeout);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::SignalImpl* m_signalImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_SIGNAL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Signal
+/// \ingroup system
+///
+/// sf::Signal is a synchronization object that lets a thread
+/// sleep until another thread has something for it to do,
+/// instead of polling periodically. A signal remembers that it
+/// was raised: a notification sent while nobody is waiting is
+/// not lost, it wakes up the next wait. Each wait consumes the
+/// notification, so several notifications sent before a wait
+/// only wake it up once.
+///
+/// Waiting with a timeout makes it easy to combine deadlines
+/// (like the next audio buffer to fill) with requests coming
+/// from other threads (like a request to stop).
+///
+/// Usage example:
+/// \code
+/// sf::Signal wakeUp;
+/// bool running = true;
+///
+/// void worker()
+/// {
+///     while (running)
+///     {
+///         // sleep at most 100 ms, or less if there's new work
+///         wakeUp.wait(sf::milliseconds(100));
+///         processPendingWork();
+///     }
+/// }
+///
+/// // in the main thread
+/// pushWork(job);
+/// wakeUp.notify();
+/// \endcode
+///
+/// \see sf::Thread, sf::Mutex
+///
+////////////////////////////////////////////////////////////
@@ -49,6 +49,17 @@ class SFML_SYSTEM_API Thread : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Scheduling priorities of a thread
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Priority
+    {
+        Normal,  ///< Default priority given by the operating system
+        High,    ///< Above normal priority
+        Realtime ///< Highest priority, for threads with hard deadlines like audio streaming
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct the thread from a functor with no argument
     ///
@@ -171,6 +182,32 @@ public:
     ////////////////////////////////////////////////////////////
     void terminate();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the scheduling priority of the thread
+    ///
+    /// The priority is applied immediately if the thread is
+    /// running, and every time it is launched.
+    /// Raising the priority above Normal often requires special
+    /// privileges; when they are missing, the thread silently
+    /// keeps the default priority.
+    ///
+    /// \param priority New priority of the thread
+    ///
+    /// \see getPriority
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPriority(Priority priority);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the requested scheduling priority of the thread
+    ///
+    /// \return Priority requested with setPriority
+    ///
+    /// \see setPriority
+    ///
+    ////////////////////////////////////////////////////////////
+    Priority getPriority() const;
+
 private:
 
     friend class priv::ThreadImpl;
@@ -188,6 +225,7 @@ private:
     ////////////////////////////////////////////////////////////
     priv::ThreadImpl* m_impl;       ///< OS-specific implementation of the thread
     priv::ThreadFunc* m_entryPoint; ///< Abstraction of the function to run
+    Priority          m_priority;   ///< Scheduling priority requested for the thread
 };
 
 #include <SFML/System/Thread.inl>
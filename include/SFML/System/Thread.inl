@@ -67,7 +67,8 @@ struct ThreadMemberFunc : ThreadFunc
 template <typename F>
 Thread::Thread(F functor) :
 m_impl      (NULL),
-m_entryPoint(new priv::ThreadFunctor<F>(functor))
+m_entryPoint(new priv::ThreadFunctor<F>(functor)),
+m_priority  (Normal)
 {
 }
 
@@ -76,7 +77,8 @@ m_entryPoint(new priv::ThreadFunctor<F>(functor))
 template <typename F, typename A>
 Thread::Thread(F function, A argument) :
 m_impl      (NULL),
-m_entryPoint(new priv::ThreadFunctorWithArg<F, A>(function, argument))
+m_entryPoint(new priv::ThreadFunctorWithArg<F, A>(function, argument)),
+m_priority  (Normal)
 {
 }
 
@@ -85,6 +87,7 @@ m_entryPoint(new priv::ThreadFunctorWithArg<F, A>(function, argument))
 template <typename C>
 Thread::Thread(void(C::*function)(), C* object) :
 m_impl      (NULL),
-m_entryPoint(new priv::ThreadMemberFunc<C>(function, object))
+m_entryPoint(new priv::ThreadMemberFunc<C>(function, object)),
+m_priority  (Normal)
 {
 }
@@ -117,6 +117,21 @@ public:
     ////////////////////////////////////////////////////////////
     static const Context* getActiveContext();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of the context active on the calling thread
+    ///
+    /// Unlike getActiveContext, this function also identifies
+    /// the contexts of the windows and the internal ones. Each
+    /// context gets a different identifier, which is never
+    /// reused, so that resources that OpenGL can't share between
+    /// contexts (such as framebuffer objects) can be associated
+    /// with their context.
+    ///
+    /// \return Identifier of the active context, or 0 if none is active
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getActiveContextId();
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a in-memory context
     ///
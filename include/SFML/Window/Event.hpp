@@ -33,6 +33,7 @@
 #include <SFML/Window/Keyboard.hpp>
 #include <SFML/Window/Mouse.hpp>
 #include <SFML/Window/Sensor.hpp>
+#include <SFML/System/Time.hpp>
 
 
 namespace sf
@@ -216,7 +217,8 @@ public:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    EventType type; ///< Type of the event
+    EventType type;      ///< Type of the event
+    Time      timestamp; ///< Time at which the event happened, on the clock of sf::Clock::getCurrentTime
 
     union
     {
@@ -260,6 +262,13 @@ public:
 /// event.key member, all other members such as event.MouseMove
 /// or event.text will have undefined values.
 ///
+/// Every event also carries a timestamp. When the system provides
+/// the time at which the input actually happened (like evdev on
+/// Linux), this time is used; otherwise the event is stamped when
+/// it is received. Comparing timestamps with
+/// sf::Clock::getCurrentTime() gives the age of an event, which is
+/// more accurate than the time at which it is polled.
+///
 /// Usage example:
 /// \code
 /// sf::Event event;
@@ -37,6 +37,8 @@ namespace sf
 
 class Context;
 
+typedef void (*ContextDestroyCallback)(Uint64 contextId, void* userData);
+
 ////////////////////////////////////////////////////////////
 /// \brief Base class for classes that require an OpenGL context
 ///
@@ -57,6 +59,21 @@ protected:
     ////////////////////////////////////////////////////////////
     ~GlResource();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a function to be called when a context is destroyed
+    ///
+    /// The function receives the identifier of the context (see
+    /// Context::getActiveContextId), so that data associated
+    /// with it can be released. The context may not be usable
+    /// anymore when the function is called; the OpenGL objects
+    /// that it doesn't share are destroyed with it anyway.
+    ///
+    /// \param callback Function to call
+    /// \param userData User data passed to \a callback
+    ///
+    ////////////////////////////////////////////////////////////
+    static void registerContextDestroyCallback(ContextDestroyCallback callback, void* userData);
+
     ////////////////////////////////////////////////////////////
     /// \brief RAII helper class to temporarily lock an available context for use
     ///
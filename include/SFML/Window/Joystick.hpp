@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/Export.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Time.hpp>
 
 
 namespace sf
@@ -153,6 +154,27 @@ public:
     ////////////////////////////////////////////////////////////
     static Identification getIdentification(unsigned int joystick);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a joystick vibrate
+    ///
+    /// Most gamepads have two rumble motors: a strong, low
+    /// frequency one and a weak, high frequency one. Calling
+    /// this function again replaces the current vibration;
+    /// magnitudes of 0 stop it.
+    ///
+    /// Vibrations are currently supported on Linux only, for
+    /// the devices that support force feedback.
+    ///
+    /// \param joystick Index of the joystick
+    /// \param strong   Magnitude of the strong motor, in range [0 .. 100]
+    /// \param weak     Magnitude of the weak motor, in range [0 .. 100]
+    /// \param duration Duration of the vibration, or Time::Zero to vibrate until stopped
+    ///
+    /// \return True if the vibration was started, false if the joystick can't vibrate
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setVibration(unsigned int joystick, float strong, float weak, Time duration = Time::Zero);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the states of all joysticks
     ///
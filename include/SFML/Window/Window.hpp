@@ -38,6 +38,7 @@
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/String.hpp>
+#include <vector>
 
 
 namespace sf
@@ -237,6 +238,118 @@ public:
     ////////////////////////////////////////////////////////////
     bool waitEvent(Event& event);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for an event, for a limited time, and return it
+    ///
+    /// This function is the same as the other overload of waitEvent,
+    /// except that it returns false if no event was received
+    /// before \a timeout elapsed. A null or negative timeout makes
+    /// it behave like pollEvent.
+    /// \code
+    /// sf::Event event;
+    /// while (window.waitEvent(event, sf::milliseconds(500)))
+    /// {
+    ///    // process event...
+    /// }
+    ///
+    /// // no event for half a second, blink the cursor...
+    /// \endcode
+    ///
+    /// \param event   Event to be returned
+    /// \param timeout Maximum time to wait for an event
+    ///
+    /// \return True if an event was returned, false if the timeout expired or an error occurred
+    ///
+    /// \see pollEvent
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitEvent(Event& event, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the compression of motion events
+    ///
+    /// High rate mice and touch screens can generate many more
+    /// MouseMoved and TouchMoved events than the application
+    /// needs. When compression is enabled, a motion event that
+    /// follows another one of the same kind (and for the same
+    /// finger) in the event queue replaces it, so that at most
+    /// one motion is returned per batch of events.
+    /// The replaced events can still be retrieved with
+    /// getEventHistory().
+    ///
+    /// Compression is disabled by default.
+    ///
+    /// \param enabled True to enable compression, false to disable it
+    ///
+    /// \see getEventHistory
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEventCompressionEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the events merged into the last returned event
+    ///
+    /// When event compression is enabled, this function returns
+    /// the intermediate motion events that were replaced by the
+    /// last event returned by pollEvent() or waitEvent(), oldest
+    /// first. Applications that need every sample (like drawing
+    /// programs) can process them before the event itself.
+    /// \code
+    /// while (window.pollEvent(event))
+    /// {
+    ///     if (event.type == sf::Event::MouseMoved)
+    ///     {
+    ///         const std::vector<sf::Event>& history = window.getEventHistory();
+    ///         for (std::size_t i = 0; i < history.size(); ++i)
+    ///             addPoint(history[i].mouseMove.x, history[i].mouseMove.y);
+    ///
+    ///         addPoint(event.mouseMove.x, event.mouseMove.y);
+    ///     }
+    /// }
+    /// \endcode
+    ///
+    /// \return Events merged into the last returned event
+    ///
+    /// \see setEventCompressionEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Event>& getEventHistory() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of events waiting to be returned
+    ///
+    /// This is the number of events that remain to be processed
+    /// in the current batch, plus the number of events that the
+    /// system has already received but not yet passed to the
+    /// window, when the implementation buffers them in its own
+    /// queue. A high value means that the system produces events
+    /// faster than they are processed; when that queue is full,
+    /// events are dropped.
+    ///
+    /// \return Number of pending events
+    ///
+    /// \see getDroppedEventCount
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingEventCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of events lost by the system
+    ///
+    /// Some implementations read the input devices into a queue
+    /// of fixed size, and drop the events that don't fit when
+    /// they are not processed fast enough. This function returns
+    /// the number of events dropped since the window was
+    /// created; it is always 0 when the implementation never
+    /// drops events.
+    ///
+    /// \return Number of dropped events
+    ///
+    /// \see getPendingEventCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedEventCount() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the position of the window
     ///
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/AsyncSoundFileWriter.hpp>
+#include <SFML/Audio/SoundFileWriter.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+    // Number of samples passed to the writer at once
+    const std::size_t blockSize = 16384;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+AsyncSoundFileWriter::AsyncSoundFileWriter(SoundFileWriter& writer, unsigned int channelCount, std::size_t bufferSize, OutputSoundFile::OverflowPolicy policy) :
+m_writer            (writer),
+m_channelCount      (channelCount),
+m_policy            (policy),
+m_ring              (std::max(bufferSize, static_cast<std::size_t>(channelCount))),
+m_dataAvailable     (),
+m_spaceAvailable    (),
+m_mutex             (),
+m_stopping          (false),
+m_droppedSampleCount(0),
+m_thread            (&AsyncSoundFileWriter::run, this)
+{
+    m_thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+AsyncSoundFileWriter::~AsyncSoundFileWriter()
+{
+    {
+        Lock lock(m_mutex);
+        m_stopping = true;
+    }
+
+    // Let the worker write what is left and exit
+    m_dataAvailable.notify();
+    m_thread.wait();
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncSoundFileWriter::write(const Int16* samples, Uint64 count)
+{
+    if (m_policy == OutputSoundFile::Drop)
+    {
+        // Push whole frames only, so that the channels stay interleaved in the file
+        std::size_t space = m_ring.getFreeSpace() / m_channelCount * m_channelCount;
+        std::size_t pushed = m_ring.push(samples, static_cast<std::size_t>(std::min(count, static_cast<Uint64>(space))));
+        m_droppedSampleCount += count - pushed;
+
+        if (pushed > 0)
+            m_dataAvailable.notify();
+    }
+    else
+    {
+        // Push as much as possible, and wait for the worker to make room for the rest
+        for (;;)
+        {
+            std::size_t pushed = m_ring.push(samples, static_cast<std::size_t>(std::min(count, static_cast<Uint64>(m_ring.getCapacity()))));
+            samples += pushed;
+            count -= pushed;
+
+            if (pushed > 0)
+                m_dataAvailable.notify();
+
+            if (count == 0)
+                break;
+
+            m_spaceAvailable.wait();
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 AsyncSoundFileWriter::getDroppedSampleCount() const
+{
+    return m_droppedSampleCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncSoundFileWriter::run()
+{
+    // The writers ignore incomplete frames, so always pass them whole frames
+    std::vector<Int16> block(std::max(blockSize / m_channelCount, static_cast<std::size_t>(1)) * m_channelCount);
+
+    for (;;)
+    {
+        std::size_t count = std::min(m_ring.getSize(), block.size()) / m_channelCount * m_channelCount;
+        if (count > 0)
+        {
+            // Make room for the producer before encoding, so that it doesn't wait for us
+            m_ring.pop(&block[0], count);
+            m_spaceAvailable.notify();
+
+            m_writer.write(&block[0], count);
+        }
+        else
+        {
+            {
+                Lock lock(m_mutex);
+                if (m_stopping)
+                    break;
+            }
+
+            m_dataAvailable.wait();
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
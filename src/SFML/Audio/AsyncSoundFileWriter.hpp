@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ASYNCSOUNDFILEWRITER_HPP
+#define SFML_ASYNCSOUNDFILEWRITER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/OutputSoundFile.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Signal.hpp>
+#include <SFML/System/SpscRing.hpp>
+#include <SFML/System/Thread.hpp>
+
+
+namespace sf
+{
+class SoundFileWriter;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Encode the samples written to a sound file
+///        in a background thread
+///
+/// The samples are copied to a lock-free ring buffer by the
+/// thread calling write(), and a worker thread pops them by
+/// large blocks and passes them to the actual writer.
+///
+////////////////////////////////////////////////////////////
+class AsyncSoundFileWriter : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start the worker thread
+    ///
+    /// \param writer       Writer of the open file
+    /// \param channelCount Number of channels of the sound
+    /// \param bufferSize   Number of samples that the ring buffer can hold
+    /// \param policy       What to do when the ring buffer is full
+    ///
+    ////////////////////////////////////////////////////////////
+    AsyncSoundFileWriter(SoundFileWriter& writer, unsigned int channelCount, std::size_t bufferSize, OutputSoundFile::OverflowPolicy policy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits until all the pending samples have been written.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~AsyncSoundFileWriter();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue audio samples for writing
+    ///
+    /// \param samples Pointer to the sample array to write
+    /// \param count   Number of samples to write
+    ///
+    ////////////////////////////////////////////////////////////
+    void write(const Int16* samples, Uint64 count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples dropped because the buffer was full
+    ///
+    /// \return Number of dropped samples
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedSampleCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SoundFileWriter&                m_writer;             ///< Writer of the open file
+    unsigned int                    m_channelCount;       ///< Number of channels of the sound
+    OutputSoundFile::OverflowPolicy m_policy;             ///< What to do when the ring buffer is full
+    SpscRing<Int16>                 m_ring;               ///< Samples waiting to be encoded
+    Signal                          m_dataAvailable;      ///< Signal raised when samples are pushed, or when the worker must stop
+    Signal                          m_spaceAvailable;     ///< Signal raised when samples are popped
+    Mutex                           m_mutex;              ///< Mutex protecting m_stopping
+    bool                            m_stopping;           ///< Must the worker stop once the ring buffer is empty?
+    Uint64                          m_droppedSampleCount; ///< Number of samples dropped because the buffer was full
+    Thread                          m_thread;             ///< Worker thread
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_ASYNCSOUNDFILEWRITER_HPP
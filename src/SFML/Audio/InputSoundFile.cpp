@@ -32,6 +32,81 @@
 #include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <fstream>
+
+
+namespace
+{
+    // Version of the seek index cache file format
+    const sf::Uint32 seekIndexVersion = 1;
+
+    void writeUint64(std::ostream& stream, sf::Uint64 value)
+    {
+        char bytes[8];
+        for (int i = 0; i < 8; ++i)
+            bytes[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+        stream.write(bytes, sizeof(bytes));
+    }
+
+    bool readUint64(std::istream& stream, sf::Uint64& value)
+    {
+        unsigned char bytes[8];
+        if (!stream.read(reinterpret_cast<char*>(bytes), sizeof(bytes)))
+            return false;
+
+        value = 0;
+        for (int i = 0; i < 8; ++i)
+            value |= static_cast<sf::Uint64>(bytes[i]) << (i * 8);
+        return true;
+    }
+
+    bool loadSeekIndex(const std::string& filename, sf::Uint64 fileSize, sf::Uint64 sampleCount, std::vector<sf::SoundFileReader::SeekPoint>& index)
+    {
+        std::ifstream file(filename.c_str(), std::ios_base::binary);
+        if (!file)
+            return false;
+
+        // Check that the index belongs to the sound file
+        char magic[4];
+        sf::Uint64 version, size, samples, count;
+        if (!file.read(magic, sizeof(magic)) || (std::string(magic, 4) != "SFSI") ||
+            !readUint64(file, version) || (version != seekIndexVersion) ||
+            !readUint64(file, size) || (size != fileSize) ||
+            !readUint64(file, samples) || (samples != sampleCount) ||
+            !readUint64(file, count) || (count == 0) || (count > fileSize))
+            return false;
+
+        index.resize(static_cast<std::size_t>(count));
+        for (std::size_t i = 0; i < index.size(); ++i)
+        {
+            if (!readUint64(file, index[i].sampleOffset) || !readUint64(file, index[i].byteOffset))
+                return false;
+        }
+
+        return true;
+    }
+
+    void saveSeekIndex(const std::string& filename, sf::Uint64 fileSize, sf::Uint64 sampleCount, const std::vector<sf::SoundFileReader::SeekPoint>& index)
+    {
+        std::ofstream file(filename.c_str(), std::ios_base::binary);
+        if (!file)
+        {
+            sf::err() << "Failed to save seek index to \"" << filename << "\"" << std::endl;
+            return;
+        }
+
+        file.write("SFSI", 4);
+        writeUint64(file, seekIndexVersion);
+        writeUint64(file, fileSize);
+        writeUint64(file, sampleCount);
+        writeUint64(file, index.size());
+        for (std::size_t i = 0; i < index.size(); ++i)
+        {
+            writeUint64(file, index[i].sampleOffset);
+            writeUint64(file, index[i].byteOffset);
+        }
+    }
+}
 
 
 namespace sf
@@ -253,6 +328,49 @@ Uint64 InputSoundFile::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 InputSoundFile::read(float* samples, Uint64 maxCount)
+{
+    Uint64 readSamples = 0;
+    if (m_reader && samples && maxCount)
+        readSamples = m_reader->readFloat(samples, maxCount);
+    m_sampleOffset += readSamples;
+    return readSamples;
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSoundFile::buildSeekIndex(const std::string& cacheFilename)
+{
+    if (!m_reader)
+        return false;
+
+    Uint64 fileSize = static_cast<Uint64>(m_stream->getSize());
+    std::vector<SoundFileReader::SeekPoint> index;
+
+    // Try the cached index first
+    if (!cacheFilename.empty() && loadSeekIndex(cacheFilename, fileSize, m_sampleCount, index))
+    {
+        m_reader->setSeekIndex(index);
+        return true;
+    }
+
+    // Scan the file, then restore the read position
+    bool built = m_reader->buildSeekIndex(index);
+    if (built)
+        m_reader->setSeekIndex(index);
+    m_reader->seek(m_sampleOffset);
+
+    if (!built)
+        return false;
+
+    if (!cacheFilename.empty())
+        saveSeekIndex(cacheFilename, fileSize, m_sampleCount, index);
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputSoundFile::close()
 {
@@ -26,12 +26,24 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Music.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
 #include <fstream>
 
 
+namespace
+{
+    // Number of samples needed to store a chunk of the given duration (at least one frame)
+    std::size_t getChunkSampleCount(sf::Time duration, unsigned int sampleRate, unsigned int channelCount)
+    {
+        std::size_t frames = static_cast<std::size_t>(duration.asMicroseconds() * sampleRate / 1000000);
+        return (frames > 0 ? frames : 1) * channelCount;
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -108,11 +120,25 @@ Time Music::getDuration() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Music::buildSeekIndex(const std::string& cacheFilename)
+{
+    Lock lock(m_mutex);
+
+    return m_file.buildSeekIndex(cacheFilename);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Music::onGetData(SoundStream::Chunk& data)
 {
     Lock lock(m_mutex);
 
+    // Follow changes of the chunk duration
+    std::size_t sampleCount = getChunkSampleCount(getChunkDuration(), m_file.getSampleRate(), m_file.getChannelCount());
+    if (m_samples.size() != sampleCount)
+        m_samples.resize(sampleCount);
+
     // Fill the chunk parameters
     data.samples     = &m_samples[0];
     data.sampleCount = static_cast<std::size_t>(m_file.read(&m_samples[0], m_samples.size()));
@@ -122,6 +148,25 @@ bool Music::onGetData(SoundStream::Chunk& data)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Music::onGetFloatData(SoundStream::FloatChunk& data)
+{
+    Lock lock(m_mutex);
+
+    // Follow the chunk duration, which may have changed since the last chunk
+    std::size_t sampleCount = getChunkSampleCount(getChunkDuration(), m_file.getSampleRate(), m_file.getChannelCount());
+    if (m_floatSamples.size() != sampleCount)
+        m_floatSamples.resize(sampleCount);
+
+    // Fill the chunk parameters
+    data.samples     = &m_floatSamples[0];
+    data.sampleCount = static_cast<std::size_t>(m_file.read(&m_floatSamples[0], m_floatSamples.size()));
+
+    // Check if we have stopped obtaining samples or reached the end of the audio file
+    return (data.sampleCount != 0) && (m_file.getSampleOffset() < m_file.getSampleCount());
+}
+
+
 ////////////////////////////////////////////////////////////
 void Music::onSeek(Time timeOffset)
 {
@@ -134,11 +179,25 @@ void Music::onSeek(Time timeOffset)
 ////////////////////////////////////////////////////////////
 void Music::initialize()
 {
-    // Resize the internal buffer so that it can contain 1 second of audio samples
-    m_samples.resize(m_file.getSampleRate() * m_file.getChannelCount());
+    // Decode directly to floating point samples if the device can play them,
+    // this skips the conversion to 16-bit and keeps the precision of the file
+    bool floatSamples = priv::AudioDevice::getFloatFormatFromChannelCount(m_file.getChannelCount()) != 0;
+
+    // Resize the internal buffer so that it can contain one chunk of audio samples
+    std::size_t sampleCount = getChunkSampleCount(getChunkDuration(), m_file.getSampleRate(), m_file.getChannelCount());
+    if (floatSamples)
+    {
+        m_floatSamples.resize(sampleCount);
+        std::vector<Int16>().swap(m_samples);
+    }
+    else
+    {
+        m_samples.resize(sampleCount);
+        std::vector<float>().swap(m_floatSamples);
+    }
 
     // Initialize the stream
-    SoundStream::initialize(m_file.getChannelCount(), m_file.getSampleRate());
+    SoundStream::initialize(m_file.getChannelCount(), m_file.getSampleRate(), floatSamples);
 }
 
 } // namespace sf
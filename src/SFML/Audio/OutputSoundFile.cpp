@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/OutputSoundFile.hpp>
+#include <SFML/Audio/AsyncSoundFileWriter.hpp>
 #include <SFML/Audio/SoundFileWriter.hpp>
 #include <SFML/Audio/SoundFileFactory.hpp>
 
@@ -34,7 +35,11 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 OutputSoundFile::OutputSoundFile() :
-m_writer(NULL)
+m_writer            (NULL),
+m_asyncWriter       (NULL),
+m_bufferSize        (0),
+m_policy            (Block),
+m_droppedSampleCount(0)
 {
 }
 
@@ -65,6 +70,11 @@ bool OutputSoundFile::openFromFile(const std::string& filename, unsigned int sam
         return false;
     }
 
+    // Start the background encoder if requested
+    m_droppedSampleCount = 0;
+    if (m_bufferSize > 0)
+        m_asyncWriter = new priv::AsyncSoundFileWriter(*m_writer, channelCount, m_bufferSize, m_policy);
+
     return true;
 }
 
@@ -73,14 +83,42 @@ bool OutputSoundFile::openFromFile(const std::string& filename, unsigned int sam
 void OutputSoundFile::write(const Int16* samples, Uint64 count)
 {
     if (m_writer && samples && count)
-        m_writer->write(samples, count);
+    {
+        if (m_asyncWriter)
+            m_asyncWriter->write(samples, count);
+        else
+            m_writer->write(samples, count);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void OutputSoundFile::setAsynchronous(std::size_t bufferSize, OverflowPolicy policy)
+{
+    m_bufferSize = bufferSize;
+    m_policy = policy;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 OutputSoundFile::getDroppedSampleCount() const
+{
+    return m_asyncWriter ? m_asyncWriter->getDroppedSampleCount() : m_droppedSampleCount;
 }
 
 
 ////////////////////////////////////////////////////////////
 void OutputSoundFile::close()
 {
-    // Destroy the reader
+    // Write the pending samples and stop the background encoder
+    if (m_asyncWriter)
+    {
+        m_droppedSampleCount = m_asyncWriter->getDroppedSampleCount();
+        delete m_asyncWriter;
+        m_asyncWriter = NULL;
+    }
+
+    // Destroy the writer
     delete m_writer;
     m_writer = NULL;
 }
@@ -70,6 +70,10 @@ Sound::~Sound()
 ////////////////////////////////////////////////////////////
 void Sound::play()
 {
+    // Compressed buffers are decoded on demand
+    if (m_buffer)
+        m_buffer->prepare();
+
     alCheck(alSourcePlay(m_source));
 }
 
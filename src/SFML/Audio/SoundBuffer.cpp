@@ -31,16 +31,97 @@
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <list>
 #include <memory>
 
 
+namespace
+{
+    // Compressed sound buffers whose samples are held by the audio device, most recently played first
+    sf::Mutex cacheMutex;
+    std::list<const sf::SoundBuffer*> decodedBuffers;
+    std::size_t decodedSize = 0;
+    std::size_t cacheSize = 16 * 1024 * 1024;
+
+    // Remove a buffer from the list of decoded buffers
+    void forget(const sf::SoundBuffer* buffer, std::size_t size)
+    {
+        decodedBuffers.remove(buffer);
+        decodedSize -= size;
+    }
+
+    // Samples decoded by loadFromFiles
+    struct DecodedFile
+    {
+        DecodedFile() : channelCount(0), sampleRate(0), success(false) {}
+
+        std::vector<sf::Int16> samples;
+        unsigned int           channelCount;
+        unsigned int           sampleRate;
+        bool                   success;
+    };
+
+    // Work shared by the threads of loadFromFiles
+    struct BulkLoad
+    {
+        const std::string*       filenames;
+        std::vector<DecodedFile> files;
+        std::size_t              next;
+        sf::Mutex                mutex;
+    };
+
+    // Decode files until there's none left
+    void decodeFiles(BulkLoad* load)
+    {
+        for (;;)
+        {
+            std::size_t index;
+            {
+                sf::Lock lock(load->mutex);
+                if (load->next >= load->files.size())
+                    return;
+                index = load->next++;
+            }
+
+            sf::InputSoundFile file;
+            if (!file.openFromFile(load->filenames[index]))
+                continue;
+
+            DecodedFile& decoded = load->files[index];
+            sf::Uint64 sampleCount = file.getSampleCount();
+            decoded.samples.resize(static_cast<std::size_t>(sampleCount));
+            if (sampleCount && (file.read(&decoded.samples[0], sampleCount) == sampleCount))
+            {
+                decoded.channelCount = file.getChannelCount();
+                decoded.sampleRate   = file.getSampleRate();
+                decoded.success      = true;
+            }
+            else
+            {
+                std::vector<sf::Int16>().swap(decoded.samples);
+            }
+        }
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 SoundBuffer::SoundBuffer() :
-m_buffer  (0),
-m_duration()
+m_buffer      (0),
+m_sampleCount (0),
+m_channelCount(0),
+m_sampleRate  (0),
+m_duration    (),
+m_keepSamples (true),
+m_isDecoded   (false)
 {
     // Create the buffer
     alCheck(alGenBuffers(1, &m_buffer));
@@ -49,16 +130,33 @@ m_duration()
 
 ////////////////////////////////////////////////////////////
 SoundBuffer::SoundBuffer(const SoundBuffer& copy) :
-m_buffer  (0),
-m_samples (copy.m_samples),
-m_duration(copy.m_duration),
-m_sounds  () // don't copy the attached sounds
+m_buffer      (0),
+m_samples     (copy.m_samples),
+m_compressed  (copy.m_compressed),
+m_sampleCount (0),
+m_channelCount(0),
+m_sampleRate  (0),
+m_duration    (),
+m_keepSamples (copy.m_keepSamples),
+m_isDecoded   (false),
+m_sounds      () // don't copy the attached sounds
 {
     // Create the buffer
     alCheck(alGenBuffers(1, &m_buffer));
 
-    // Update the internal buffer with the new samples
-    update(copy.getChannelCount(), copy.getSampleRate());
+    if (m_compressed.empty())
+    {
+        // Update the internal buffer with the new samples
+        update(copy.getChannelCount(), copy.getSampleRate());
+    }
+    else
+    {
+        // Compressed buffers are decoded on demand
+        m_sampleCount  = copy.m_sampleCount;
+        m_channelCount = copy.m_channelCount;
+        m_sampleRate   = copy.m_sampleRate;
+        m_duration     = copy.m_duration;
+    }
 }
 
 
@@ -75,6 +173,9 @@ SoundBuffer::~SoundBuffer()
     for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
         (*it)->resetBuffer();
 
+    // Remove the buffer from the cache of decoded buffers
+    clearCompressed();
+
     // Destroy the buffer
     if (m_buffer)
         alCheck(alDeleteBuffers(1, &m_buffer));
@@ -121,6 +222,7 @@ bool SoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsi
     {
         // Copy the new audio samples
         m_samples.assign(samples, samples + sampleCount);
+        clearCompressed();
 
         // Update the internal buffer with the new samples
         return update(channelCount, sampleRate);
@@ -140,9 +242,113 @@ bool SoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadCompressedFromFile(const std::string& filename)
+{
+    FileInputStream stream;
+    if (stream.open(filename))
+    {
+        return loadCompressedFromStream(stream);
+    }
+    else
+    {
+        err() << "Failed to open sound file \"" << filename << "\" (couldn't open stream)" << std::endl;
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadCompressedFromMemory(const void* data, std::size_t sizeInBytes)
+{
+    if (!data || !sizeInBytes)
+    {
+        err() << "Failed to load compressed sound buffer from memory (empty data)" << std::endl;
+        return false;
+    }
+
+    const char* begin = static_cast<const char*>(data);
+    std::vector<char> file(begin, begin + sizeInBytes);
+
+    return initializeCompressed(file);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadCompressedFromStream(InputStream& stream)
+{
+    Int64 size = stream.getSize();
+    if ((size <= 0) || (stream.seek(0) != 0))
+    {
+        err() << "Failed to load compressed sound buffer from stream (can't read the stream size)" << std::endl;
+        return false;
+    }
+
+    std::vector<char> file(static_cast<std::size_t>(size));
+    if (stream.read(&file[0], size) != size)
+    {
+        err() << "Failed to load compressed sound buffer from stream (can't read the stream)" << std::endl;
+        return false;
+    }
+
+    return initializeCompressed(file);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundBuffer::loadFromFiles(SoundBuffer* const* buffers, const std::string* filenames, std::size_t count, unsigned int threadCount)
+{
+    BulkLoad load;
+    load.filenames = filenames;
+    load.files.resize(count);
+    load.next = 0;
+
+    // Decode the files in parallel
+    std::vector<Thread*> threads;
+    for (std::size_t i = 0; (i < std::max(threadCount, 1u)) && (i < count); ++i)
+    {
+        threads.push_back(new Thread(&decodeFiles, &load));
+        threads.back()->launch();
+    }
+
+    for (std::vector<Thread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+
+    // Upload the samples from the calling thread
+    std::size_t loaded = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        DecodedFile& decoded = load.files[i];
+        if (!decoded.success)
+            continue;
+
+        SoundBuffer& buffer = *buffers[i];
+        buffer.m_samples.swap(decoded.samples);
+        buffer.clearCompressed();
+
+        if (buffer.update(decoded.channelCount, decoded.sampleRate))
+            ++loaded;
+
+        // Free the memory as soon as possible, the decoded samples of all the files may be large
+        std::vector<Int16>().swap(decoded.samples);
+    }
+
+    return loaded;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::saveToFile(const std::string& filename) const
 {
+    if (m_samples.empty())
+    {
+        err() << "Failed to save sound buffer to \"" << filename << "\" (the samples have been released)" << std::endl;
+        return false;
+    }
+
     // Create the sound file in write mode
     OutputSoundFile file;
     if (file.openFromFile(filename, getSampleRate(), getChannelCount()))
@@ -166,30 +372,58 @@ const Int16* SoundBuffer::getSamples() const
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundBuffer::setKeepSamples(bool keep)
+{
+    m_keepSamples = keep;
+
+    // The samples, if any, have already been uploaded
+    if (!m_keepSamples)
+        std::vector<Int16>().swap(m_samples);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::getKeepSamples() const
+{
+    return m_keepSamples;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::setDecodedCacheSize(std::size_t sizeInBytes)
+{
+    Lock lock(cacheMutex);
+    cacheSize = sizeInBytes;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundBuffer::getDecodedCacheSize()
+{
+    Lock lock(cacheMutex);
+    return cacheSize;
+}
+
+
 ////////////////////////////////////////////////////////////
 Uint64 SoundBuffer::getSampleCount() const
 {
-    return m_samples.size();
+    return m_sampleCount;
 }
 
 
 ////////////////////////////////////////////////////////////
 unsigned int SoundBuffer::getSampleRate() const
 {
-    ALint sampleRate;
-    alCheck(alGetBufferi(m_buffer, AL_FREQUENCY, &sampleRate));
-
-    return sampleRate;
+    return m_sampleRate;
 }
 
 
 ////////////////////////////////////////////////////////////
 unsigned int SoundBuffer::getChannelCount() const
 {
-    ALint channelCount;
-    alCheck(alGetBufferi(m_buffer, AL_CHANNELS, &channelCount));
-
-    return channelCount;
+    return m_channelCount;
 }
 
 
@@ -205,10 +439,18 @@ SoundBuffer& SoundBuffer::operator =(const SoundBuffer& right)
 {
     SoundBuffer temp(right);
 
-    std::swap(m_samples,  temp.m_samples);
-    std::swap(m_buffer,   temp.m_buffer);
-    std::swap(m_duration, temp.m_duration);
-    std::swap(m_sounds,   temp.m_sounds); // swap sounds too, so that they are detached when temp is destroyed
+    // The cache refers to this buffer by address, and its OpenAL buffer is about to be swapped
+    clearCompressed();
+
+    std::swap(m_samples,      temp.m_samples);
+    std::swap(m_compressed,   temp.m_compressed);
+    std::swap(m_buffer,       temp.m_buffer);
+    std::swap(m_sampleCount,  temp.m_sampleCount);
+    std::swap(m_channelCount, temp.m_channelCount);
+    std::swap(m_sampleRate,   temp.m_sampleRate);
+    std::swap(m_duration,     temp.m_duration);
+    std::swap(m_keepSamples,  temp.m_keepSamples);
+    std::swap(m_sounds,       temp.m_sounds); // swap sounds too, so that they are detached when temp is destroyed
 
     return *this;
 }
@@ -226,6 +468,8 @@ bool SoundBuffer::initialize(InputSoundFile& file)
     m_samples.resize(static_cast<std::size_t>(sampleCount));
     if (file.read(&m_samples[0], sampleCount) == sampleCount)
     {
+        clearCompressed();
+
         // Update the internal buffer with the new samples
         return update(channelCount, sampleRate);
     }
@@ -264,6 +508,11 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
     ALsizei size = static_cast<ALsizei>(m_samples.size()) * sizeof(Int16);
     alCheck(alBufferData(m_buffer, format, &m_samples[0], size, sampleRate));
 
+    // Store the sound parameters
+    m_sampleCount  = m_samples.size();
+    m_channelCount = channelCount;
+    m_sampleRate   = sampleRate;
+
     // Compute the duration
     m_duration = seconds(static_cast<float>(m_samples.size()) / sampleRate / channelCount);
 
@@ -271,6 +520,139 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
     for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
         (*it)->setBuffer(*this);
 
+    // The audio device has its own copy of the samples
+    if (!m_keepSamples)
+        std::vector<Int16>().swap(m_samples);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::prepare() const
+{
+    // Uncompressed buffers are always ready
+    if (m_compressed.empty())
+        return true;
+
+    Lock lock(cacheMutex);
+
+    if (m_isDecoded)
+    {
+        // Mark the buffer as the most recently played one
+        decodedBuffers.remove(this);
+        decodedBuffers.push_front(this);
+        return true;
+    }
+
+    // Decoding the samples doesn't change the observable state of the buffer
+    SoundBuffer& self = const_cast<SoundBuffer&>(*this);
+
+    InputSoundFile file;
+    if (!file.openFromMemory(&m_compressed[0], m_compressed.size()))
+        return false;
+
+    self.m_samples.resize(static_cast<std::size_t>(m_sampleCount));
+    bool decoded = (file.read(&self.m_samples[0], m_sampleCount) == m_sampleCount) &&
+                   self.update(m_channelCount, m_sampleRate);
+    std::vector<Int16>().swap(self.m_samples);
+
+    if (!decoded)
+    {
+        err() << "Failed to decode compressed sound buffer" << std::endl;
+        return false;
+    }
+
+    m_isDecoded = true;
+    decodedBuffers.push_front(this);
+    decodedSize += static_cast<std::size_t>(m_sampleCount) * sizeof(Int16);
+
+    // Make room by releasing the least recently played buffers that are not playing
+    std::list<const SoundBuffer*>::iterator it = decodedBuffers.end();
+    while ((decodedSize > cacheSize) && (--it != decodedBuffers.begin()))
+    {
+        const SoundBuffer* buffer = *it;
+
+        bool isPlaying = false;
+        for (SoundList::const_iterator sound = buffer->m_sounds.begin(); sound != buffer->m_sounds.end(); ++sound)
+            isPlaying = isPlaying || ((*sound)->getStatus() != Sound::Stopped);
+
+        // Move the iterator away from the buffer before it leaves the list
+        if (!isPlaying)
+        {
+            ++it;
+            buffer->unload();
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::unload() const
+{
+    // Detach the sounds, replace the OpenAL buffer with an empty one, and reattach them
+    SoundList sounds(m_sounds);
+    for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
+        (*it)->resetBuffer();
+
+    alCheck(alDeleteBuffers(1, &m_buffer));
+    alCheck(alGenBuffers(1, &m_buffer));
+
+    for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
+        (*it)->setBuffer(*this);
+
+    Lock lock(cacheMutex);
+    if (m_isDecoded)
+    {
+        forget(this, static_cast<std::size_t>(m_sampleCount) * sizeof(Int16));
+        m_isDecoded = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::clearCompressed()
+{
+    {
+        Lock lock(cacheMutex);
+        if (m_isDecoded)
+        {
+            forget(this, static_cast<std::size_t>(m_sampleCount) * sizeof(Int16));
+            m_isDecoded = false;
+        }
+    }
+
+    std::vector<char>().swap(m_compressed);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::initializeCompressed(std::vector<char>& data)
+{
+    // Check that the data can be decoded, and retrieve the sound parameters
+    InputSoundFile file;
+    if (!file.openFromMemory(&data[0], data.size()))
+        return false;
+
+    if (!file.getSampleCount() || !priv::AudioDevice::getFormatFromChannelCount(file.getChannelCount()))
+    {
+        err() << "Failed to load compressed sound buffer (empty sound or unsupported number of channels)" << std::endl;
+        return false;
+    }
+
+    // Release the previous samples, and keep the encoded file
+    unload();
+    clearCompressed();
+    std::vector<Int16>().swap(m_samples);
+    m_compressed.swap(data);
+
+    m_sampleCount  = file.getSampleCount();
+    m_channelCount = file.getChannelCount();
+    m_sampleRate   = file.getSampleRate();
+    m_duration     = file.getDuration();
+
     return true;
 }
 
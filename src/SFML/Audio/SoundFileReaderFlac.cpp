@@ -28,6 +28,7 @@
 #include <SFML/Audio/SoundFileReaderFlac.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 
 
@@ -112,36 +113,46 @@ namespace
         if (data->remaining < frameSamples)
             data->leftovers.reserve(static_cast<std::size_t>(frameSamples - data->remaining));
 
+        // Samples are moved to the upper bits of a 32 bits integer, whatever their size
+        unsigned int shift = 32 - frame->header.bits_per_sample;
+
+        // When seeking with the index, drop the samples that precede the target
+        unsigned int first = 0;
+        if (data->seeking)
+        {
+            sf::Uint64 frameStart = frame->header.number.sample_number;
+            if (frameStart > data->seekFrame)
+            {
+                // The indexed frame is past the target, the index doesn't match the file
+                data->seeking = false;
+                data->seekMissed = true;
+                return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+            }
+
+            if (frameStart + frame->header.blocksize <= data->seekFrame)
+                return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+
+            first = static_cast<unsigned int>(data->seekFrame - frameStart);
+            data->seeking = false;
+        }
+
         // Decode the samples
-        for (unsigned i = 0; i < frame->header.blocksize; ++i)
+        for (unsigned i = first; i < frame->header.blocksize; ++i)
         {
             for (unsigned int j = 0; j < frame->header.channels; ++j)
             {
                 // Decode the current sample
-                sf::Int16 sample = 0;
-                switch (frame->header.bits_per_sample)
-                {
-                    case 8:
-                        sample = buffer[j][i] << 8;
-                        break;
-                    case 16:
-                        sample = buffer[j][i];
-                        break;
-                    case 24:
-                        sample = buffer[j][i] >> 8;
-                        break;
-                    case 32:
-                        sample = buffer[j][i] >> 16;
-                        break;
-                    default:
-                        assert(false);
-                        break;
-                }
+                sf::Int32 sample = static_cast<sf::Int32>(static_cast<sf::Uint32>(buffer[j][i]) << shift);
 
                 if (data->buffer && data->remaining > 0)
                 {
                     // If there's room in the output buffer, copy the sample there
-                    *data->buffer++ = sample;
+                    *data->buffer++ = static_cast<sf::Int16>(sample >> 16);
+                    data->remaining--;
+                }
+                else if (data->floatBuffer && data->remaining > 0)
+                {
+                    *data->floatBuffer++ = sample * (1.f / 2147483648.f);
                     data->remaining--;
                 }
                 else
@@ -173,6 +184,11 @@ namespace
         sf::priv::SoundFileReaderFlac::ClientData* data = static_cast<sf::priv::SoundFileReaderFlac::ClientData*>(clientData);
         data->error = true;
     }
+
+    bool compareSampleOffset(sf::Uint64 sampleOffset, const sf::SoundFileReader::SeekPoint& point)
+    {
+        return sampleOffset < point.sampleOffset;
+    }
 }
 
 namespace sf
@@ -190,7 +206,13 @@ bool SoundFileReaderFlac::check(InputStream& stream)
     // Initialize the decoder with our callbacks
     ClientData data;
     data.stream = &stream;
+    data.buffer = NULL;
+    data.floatBuffer = NULL;
+    data.remaining = 0;
     data.error = false;
+    data.seeking = false;
+    data.seekMissed = false;
+    data.seekFrame = 0;
     FLAC__stream_decoder_init_stream(decoder, &streamRead, &streamSeek, &streamTell, &streamLength, &streamEof, &streamWrite, NULL, &streamError, &data);
 
     // Read the header
@@ -206,8 +228,9 @@ bool SoundFileReaderFlac::check(InputStream& stream)
 
 ////////////////////////////////////////////////////////////
 SoundFileReaderFlac::SoundFileReaderFlac() :
-m_decoder(NULL),
-m_clientData()
+m_decoder   (NULL),
+m_clientData(),
+m_seekIndex ()
 {
 }
 
@@ -256,6 +279,7 @@ void SoundFileReaderFlac::seek(Uint64 sampleOffset)
 
     // Reset the callback data (the "write" callback will be called)
     m_clientData.buffer = NULL;
+    m_clientData.floatBuffer = NULL;
     m_clientData.remaining = 0;
     m_clientData.leftovers.clear();
 
@@ -263,8 +287,10 @@ void SoundFileReaderFlac::seek(Uint64 sampleOffset)
     if (sampleOffset < m_clientData.info.sampleCount)
     {
         // The "write" callback will populate the leftovers buffer with the first batch of samples from the
-        // seek destination, and since we want that data in this typical case, we don't re-clear it afterward
-        FLAC__stream_decoder_seek_absolute(m_decoder, sampleOffset / m_clientData.info.channelCount);
+        // seek destination, and since we want that data in this typical case, we don't re-clear it afterward.
+        // The seek index, if any, avoids the search done by the decoder
+        if (!seekWithIndex(sampleOffset))
+            FLAC__stream_decoder_seek_absolute(m_decoder, sampleOffset / m_clientData.info.channelCount);
     }
     else
     {
@@ -280,32 +306,43 @@ void SoundFileReaderFlac::seek(Uint64 sampleOffset)
 
 ////////////////////////////////////////////////////////////
 Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
+{
+    return decode(samples, NULL, maxCount);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderFlac::readFloat(float* samples, Uint64 maxCount)
+{
+    return decode(NULL, samples, maxCount);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderFlac::decode(Int16* samples, float* floatSamples, Uint64 maxCount)
 {
     assert(m_decoder);
 
-    // If there are leftovers from previous call, use it first
-    Uint64 left = m_clientData.leftovers.size();
-    if (left > 0)
+    // If there are leftovers from previous call, use them first
+    Uint64 left = std::min(static_cast<Uint64>(m_clientData.leftovers.size()), maxCount);
+    for (Uint64 i = 0; i < left; ++i)
     {
-        if (left > maxCount)
-        {
-            // There are more leftovers than needed
-            std::copy(m_clientData.leftovers.begin(), m_clientData.leftovers.begin() + maxCount, samples);
-            std::vector<Int16> leftovers(m_clientData.leftovers.begin() + maxCount, m_clientData.leftovers.end());
-            m_clientData.leftovers.swap(leftovers);
-            return maxCount;
-        }
+        Int32 sample = m_clientData.leftovers[static_cast<std::size_t>(i)];
+        if (samples)
+            *samples++ = static_cast<Int16>(sample >> 16);
         else
-        {
-            // We can use all the leftovers and decode new frames
-            std::copy(m_clientData.leftovers.begin(), m_clientData.leftovers.end(), samples);
-        }
+            *floatSamples++ = sample * (1.f / 2147483648.f);
     }
+    m_clientData.leftovers.erase(m_clientData.leftovers.begin(), m_clientData.leftovers.begin() + static_cast<std::size_t>(left));
+
+    // There were more leftovers than needed
+    if (left == maxCount)
+        return maxCount;
 
     // Reset the data that will be used in the callback
-    m_clientData.buffer = samples + left;
+    m_clientData.buffer = samples;
+    m_clientData.floatBuffer = floatSamples;
     m_clientData.remaining = maxCount - left;
-    m_clientData.leftovers.clear();
 
     // Decode frames one by one until we reach the requested sample count, the end of file or an error
     while (m_clientData.remaining > 0)
@@ -320,7 +357,102 @@ Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
             break;
     }
 
-    return maxCount - m_clientData.remaining;
+    Uint64 count = maxCount - m_clientData.remaining;
+
+    // Don't let the callback write to the caller's arrays anymore
+    m_clientData.buffer = NULL;
+    m_clientData.floatBuffer = NULL;
+    m_clientData.remaining = 0;
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderFlac::buildSeekIndex(std::vector<SeekPoint>& index)
+{
+    assert(m_decoder);
+
+    m_clientData.leftovers.clear();
+
+    // Rewind to the first frame
+    if (!FLAC__stream_decoder_reset(m_decoder) || !FLAC__stream_decoder_process_until_end_of_metadata(m_decoder))
+        return false;
+
+    // Record a frame every 100 ms at most, it is enough to keep the decoding after a seek short
+    unsigned int channelCount = m_clientData.info.channelCount;
+    Uint64 spacing = std::max(m_clientData.info.sampleRate / 10, 1u);
+    Uint64 nextFrame = 0;
+    Uint64 frame = 0;
+
+    // Walk the frames without decoding their samples
+    for (;;)
+    {
+        FLAC__uint64 position = 0;
+        if (!FLAC__stream_decoder_get_decode_position(m_decoder, &position))
+            break;
+
+        if (!FLAC__stream_decoder_skip_single_frame(m_decoder) ||
+            (FLAC__stream_decoder_get_state(m_decoder) == FLAC__STREAM_DECODER_END_OF_STREAM))
+            break;
+
+        if (frame >= nextFrame)
+        {
+            SeekPoint point = {frame * channelCount, position};
+            index.push_back(point);
+            nextFrame = frame + spacing;
+        }
+
+        frame += FLAC__stream_decoder_get_blocksize(m_decoder);
+    }
+
+    return !index.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderFlac::setSeekIndex(const std::vector<SeekPoint>& index)
+{
+    m_seekIndex = index;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderFlac::seekWithIndex(Uint64 sampleOffset)
+{
+    // Find the last frame that starts before the target
+    std::vector<SeekPoint>::const_iterator point = std::upper_bound(m_seekIndex.begin(), m_seekIndex.end(), sampleOffset, compareSampleOffset);
+    if (point == m_seekIndex.begin())
+        return false;
+    --point;
+
+    // Jump to the frame: the decoder looks for the next frame header from there
+    if (!FLAC__stream_decoder_flush(m_decoder) ||
+        (m_clientData.stream->seek(point->byteOffset) != static_cast<Int64>(point->byteOffset)))
+        return false;
+
+    // Decode until the "write" callback reaches the target
+    m_clientData.seeking = true;
+    m_clientData.seekMissed = false;
+    m_clientData.seekFrame = sampleOffset / m_clientData.info.channelCount;
+    while (m_clientData.seeking)
+    {
+        if (!FLAC__stream_decoder_process_single(m_decoder) ||
+            (FLAC__stream_decoder_get_state(m_decoder) == FLAC__STREAM_DECODER_END_OF_STREAM))
+            break;
+    }
+
+    bool found = !m_clientData.seeking && !m_clientData.seekMissed;
+    m_clientData.seeking = false;
+
+    if (!found)
+    {
+        // Let the decoder search the target itself
+        m_clientData.leftovers.clear();
+        FLAC__stream_decoder_flush(m_decoder);
+    }
+
+    return found;
 }
 
 
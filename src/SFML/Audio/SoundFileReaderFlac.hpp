@@ -104,6 +104,35 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floating point numbers
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 readFloat(float* samples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scan the whole file to build a seek index
+    ///
+    /// \param index Array to fill, sorted by increasing offsets
+    ///
+    /// \return True if the index was built
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool buildSeekIndex(std::vector<SeekPoint>& index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the seek index to use in seek()
+    ///
+    /// \param index Seek index
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setSeekIndex(const std::vector<SeekPoint>& index);
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -115,9 +144,13 @@ public:
         InputStream*          stream;
         SoundFileReader::Info info;
         Int16*                buffer;
+        float*                floatBuffer;
         Uint64                remaining;
-        std::vector<Int16>    leftovers;
+        std::vector<Int32>    leftovers;
         bool                  error;
+        bool                  seeking;
+        bool                  seekMissed;
+        Uint64                seekFrame;
     };
 
 private:
@@ -128,11 +161,34 @@ private:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode samples to either 16 bits integers or floating point numbers
+    ///
+    /// \param samples      Integer array to fill, or NULL
+    /// \param floatSamples Floating point array to fill, or NULL
+    /// \param maxCount     Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 decode(Int16* samples, float* floatSamples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Seek to the given sample, starting from the closest indexed frame
+    ///
+    /// \param sampleOffset Index of the sample to jump to
+    ///
+    /// \return True on success, false if the index couldn't be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool seekWithIndex(Uint64 sampleOffset);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    FLAC__StreamDecoder* m_decoder;    ///< FLAC decoder
-    ClientData           m_clientData; ///< Structure passed to the decoder callbacks
+    FLAC__StreamDecoder*   m_decoder;    ///< FLAC decoder
+    ClientData             m_clientData; ///< Structure passed to the decoder callbacks
+    std::vector<SeekPoint> m_seekIndex;  ///< Frames where decoding can resume, sorted by sample offset
 };
 
 } // namespace priv
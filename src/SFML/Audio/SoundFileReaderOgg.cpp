@@ -30,6 +30,7 @@
 #include <SFML/System/Err.hpp>
 #include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <cassert>
 
 
@@ -64,6 +65,15 @@ namespace
     }
 
     static ov_callbacks callbacks = {&read, &seek, NULL, &tell};
+
+    // Decoding must start this many frames before a seek target, so that the
+    // overlapped first block (the largest Vorbis block is 8192 frames) is complete
+    const ogg_int64_t seekPreroll = 8192;
+
+    bool compareSampleOffset(sf::Uint64 sampleOffset, const sf::SoundFileReader::SeekPoint& point)
+    {
+        return sampleOffset < point.sampleOffset;
+    }
 }
 
 namespace sf
@@ -89,7 +99,8 @@ bool SoundFileReaderOgg::check(InputStream& stream)
 ////////////////////////////////////////////////////////////
 SoundFileReaderOgg::SoundFileReaderOgg() :
 m_vorbis      (),
-m_channelCount(0)
+m_channelCount(0),
+m_seekIndex   ()
 {
     m_vorbis.datasource = NULL;
 }
@@ -131,7 +142,10 @@ void SoundFileReaderOgg::seek(Uint64 sampleOffset)
 {
     assert(m_vorbis.datasource);
 
-    ov_pcm_seek(&m_vorbis, sampleOffset / m_channelCount);
+    // Use the seek index if possible, it avoids the bisection search done by ov_pcm_seek
+    ogg_int64_t frame = static_cast<ogg_int64_t>(sampleOffset / m_channelCount);
+    if (!seekWithIndex(frame))
+        ov_pcm_seek(&m_vorbis, frame);
 }
 
 
@@ -163,6 +177,140 @@ Uint64 SoundFileReaderOgg::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderOgg::readFloat(float* samples, Uint64 maxCount)
+{
+    assert(m_vorbis.datasource);
+
+    // Vorbis decodes to floating point samples, get them before they are converted to integers
+    Uint64 count = 0;
+    while (count + m_channelCount <= maxCount)
+    {
+        float** channels = NULL;
+        int framesToRead = static_cast<int>(std::min((maxCount - count) / m_channelCount, static_cast<Uint64>(4096)));
+        long framesRead = ov_read_float(&m_vorbis, &channels, framesToRead, NULL);
+        if (framesRead > 0)
+        {
+            // Interleave the channels
+            for (long i = 0; i < framesRead; ++i)
+            {
+                for (unsigned int j = 0; j < m_channelCount; ++j)
+                    *samples++ = channels[j][i];
+            }
+
+            count += framesRead * m_channelCount;
+        }
+        else
+        {
+            // error or end of file
+            break;
+        }
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderOgg::buildSeekIndex(std::vector<SeekPoint>& index)
+{
+    assert(m_vorbis.datasource);
+
+    // Chained files contain several streams with their own granule positions
+    if (!ov_seekable(&m_vorbis) || (ov_streams(&m_vorbis) != 1))
+        return false;
+
+    InputStream* stream = static_cast<InputStream*>(m_vorbis.datasource);
+    if (stream->seek(0) != 0)
+        return false;
+
+    // Record a page every 100 ms at most, it is enough to keep the decoding after a seek short
+    ogg_int64_t spacing = std::max(ov_info(&m_vorbis, -1)->rate / 10, 1L);
+    ogg_int64_t nextFrame = 0;
+    ogg_int64_t lastGranule = -1;
+    Uint64 offset = 0;
+
+    // Walk the page headers: decoding a page resumes at the granule position of the previous one
+    for (;;)
+    {
+        unsigned char header[27];
+        if ((stream->read(header, sizeof(header)) != sizeof(header)) || (std::memcmp(header, "OggS", 4) != 0))
+            break;
+
+        unsigned char segments[255];
+        unsigned int segmentCount = header[26];
+        if (stream->read(segments, segmentCount) != static_cast<Int64>(segmentCount))
+            break;
+
+        Uint64 pageSize = sizeof(header) + segmentCount;
+        for (unsigned int i = 0; i < segmentCount; ++i)
+            pageSize += segments[i];
+
+        // Skip the header pages, which precede the first audio page
+        if ((offset >= static_cast<Uint64>(m_vorbis.dataoffsets[0])) && (lastGranule >= 0) && (lastGranule >= nextFrame))
+        {
+            SeekPoint point = {static_cast<Uint64>(lastGranule) * m_channelCount, offset};
+            index.push_back(point);
+            nextFrame = lastGranule + spacing;
+        }
+
+        // Pages on which no packet ends have no granule position (-1)
+        Uint64 granule = 0;
+        for (int i = 7; i >= 0; --i)
+            granule = (granule << 8) | header[6 + i];
+        if (granule != static_cast<Uint64>(-1))
+            lastGranule = static_cast<ogg_int64_t>(granule);
+
+        offset += pageSize;
+        if (stream->seek(offset) != static_cast<Int64>(offset))
+            break;
+    }
+
+    return !index.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderOgg::setSeekIndex(const std::vector<SeekPoint>& index)
+{
+    m_seekIndex = index;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderOgg::seekWithIndex(ogg_int64_t frame)
+{
+    // Find the last page that leaves enough room before the target for the decoder to be primed
+    Uint64 start = static_cast<Uint64>(std::max(frame - seekPreroll, static_cast<ogg_int64_t>(0))) * m_channelCount;
+    std::vector<SeekPoint>::const_iterator point = std::upper_bound(m_seekIndex.begin(), m_seekIndex.end(), start, compareSampleOffset);
+    if (point == m_seekIndex.begin())
+        return false;
+    --point;
+
+    // Jump to the page; vorbisfile reports the exact position where decoding resumes
+    if (ov_raw_seek(&m_vorbis, static_cast<ogg_int64_t>(point->byteOffset)) != 0)
+        return false;
+
+    ogg_int64_t position = ov_pcm_tell(&m_vorbis);
+    if ((position < 0) || (position > frame))
+        return false;
+
+    // Decode and drop the frames up to the target
+    while (position < frame)
+    {
+        float** channels = NULL;
+        int framesToRead = static_cast<int>(std::min(frame - position, static_cast<ogg_int64_t>(4096)));
+        long framesRead = ov_read_float(&m_vorbis, &channels, framesToRead, NULL);
+        if (framesRead <= 0)
+            return false;
+
+        position += framesRead;
+    }
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFileReaderOgg::close()
 {
@@ -171,6 +319,7 @@ void SoundFileReaderOgg::close()
         ov_clear(&m_vorbis);
         m_vorbis.datasource = NULL;
         m_channelCount = 0;
+        m_seekIndex.clear();
     }
 }
 
@@ -104,8 +104,47 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floating point numbers
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 readFloat(float* samples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scan the whole file to build a seek index
+    ///
+    /// \param index Array to fill, sorted by increasing offsets
+    ///
+    /// \return True if the index was built
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool buildSeekIndex(std::vector<SeekPoint>& index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the seek index to use in seek()
+    ///
+    /// \param index Seek index
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setSeekIndex(const std::vector<SeekPoint>& index);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Seek to the given frame, starting from the closest indexed page
+    ///
+    /// \param frame Index of the frame to jump to
+    ///
+    /// \return True on success, false if the index couldn't be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool seekWithIndex(ogg_int64_t frame);
+
     ////////////////////////////////////////////////////////////
     /// \brief Close the open Vorbis file
     ///
@@ -115,8 +154,9 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    OggVorbis_File m_vorbis;       // ogg/vorbis file handle
-    unsigned int   m_channelCount; // number of channels of the open sound file
+    OggVorbis_File         m_vorbis;       // ogg/vorbis file handle
+    unsigned int           m_channelCount; // number of channels of the open sound file
+    std::vector<SeekPoint> m_seekIndex;    // pages where decoding can resume, sorted by sample offset
 };
 
 } // namespace priv
@@ -32,6 +32,14 @@
 #include <cctype>
 #include <cassert>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_WAV_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_WAV_NEON
+#endif
+
 
 namespace
 {
@@ -88,6 +96,208 @@ namespace
     }
 
     const sf::Uint64 mainChunkSize = 12;
+
+    // Size of the blocks read from the stream, in bytes
+    const std::size_t blockSize = 16384;
+
+    bool isLittleEndian()
+    {
+        const sf::Uint16 value = 1;
+        return *reinterpret_cast<const sf::Uint8*>(&value) == 1;
+    }
+
+    // The following functions convert blocks of little endian samples
+    // to 16 bits signed samples, keeping the most significant bits
+
+    void convert8bit(const sf::Uint8* input, sf::Int16* output, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_WAV_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bias = _mm_set1_epi16(128);
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            __m128i low   = _mm_slli_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(bytes, zero), bias), 8);
+            __m128i high  = _mm_slli_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(bytes, zero), bias), 8);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), low);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 8), high);
+        }
+#elif defined(SFML_WAV_NEON)
+        const uint8x16_t bias = vdupq_n_u8(128);
+        for (; i + 16 <= count; i += 16)
+        {
+            // Flipping the top bit turns the unsigned samples into signed ones
+            int8x16_t bytes = vreinterpretq_s8_u8(veorq_u8(vld1q_u8(input + i), bias));
+            vst1q_s16(output + i,     vshll_n_s8(vget_low_s8(bytes), 8));
+            vst1q_s16(output + i + 8, vshll_n_s8(vget_high_s8(bytes), 8));
+        }
+#endif
+
+        for (; i < count; ++i)
+            output[i] = static_cast<sf::Int16>((static_cast<sf::Int16>(input[i]) - 128) << 8);
+    }
+
+    void convert16bit(const sf::Uint8* input, sf::Int16* output, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            output[i] = static_cast<sf::Int16>(input[i * 2] | (input[i * 2 + 1] << 8));
+    }
+
+    void convert24bit(const sf::Uint8* input, sf::Int16* output, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_WAV_NEON)
+        if (isLittleEndian())
+        {
+            for (; i + 16 <= count; i += 16)
+            {
+                // De-interleave the three bytes of each sample, and keep the two upper ones
+                uint8x16x3_t bytes = vld3q_u8(input + i * 3);
+                uint8x16x2_t word;
+                word.val[0] = bytes.val[1];
+                word.val[1] = bytes.val[2];
+                vst2q_u8(reinterpret_cast<uint8_t*>(output + i), word);
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+            output[i] = static_cast<sf::Int16>(input[i * 3 + 1] | (input[i * 3 + 2] << 8));
+    }
+
+    void convert32bit(const sf::Uint8* input, sf::Int16* output, std::size_t count)
+    {
+        std::size_t i = 0;
+
+        if (isLittleEndian())
+        {
+#if defined(SFML_WAV_SSE2)
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 4));
+                __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 4 + 16));
+                __m128i packed = _mm_packs_epi32(_mm_srai_epi32(low, 16), _mm_srai_epi32(high, 16));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), packed);
+            }
+#elif defined(SFML_WAV_NEON)
+            for (; i + 8 <= count; i += 8)
+            {
+                // The upper halves of the samples are the odd 16 bits words
+                int16x8x2_t words = vld2q_s16(reinterpret_cast<const int16_t*>(input + i * 4));
+                vst1q_s16(output + i, words.val[1]);
+            }
+#endif
+        }
+
+        for (; i < count; ++i)
+            output[i] = static_cast<sf::Int16>(input[i * 4 + 2] | (input[i * 4 + 3] << 8));
+    }
+
+    // The following functions convert blocks of little endian samples
+    // to floating point samples in [-1, 1], keeping all the bits
+
+    void convert8bit(const sf::Uint8* input, float* output, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_WAV_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bias = _mm_set1_epi16(128);
+        const __m128 scale = _mm_set1_ps(1.f / 128.f);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i words = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i)), zero), bias);
+            __m128i low   = _mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16);
+            __m128i high  = _mm_srai_epi32(_mm_unpackhi_epi16(words, words), 16);
+            _mm_storeu_ps(output + i,     _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+            _mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+        }
+#elif defined(SFML_WAV_NEON)
+        const uint8x8_t bias = vdup_n_u8(128);
+        for (; i + 8 <= count; i += 8)
+        {
+            // Flipping the top bit turns the unsigned samples into signed ones
+            int16x8_t words = vmovl_s8(vreinterpret_s8_u8(veor_u8(vld1_u8(input + i), bias)));
+            vst1q_f32(output + i,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(words))), 1.f / 128.f));
+            vst1q_f32(output + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(words))), 1.f / 128.f));
+        }
+#endif
+
+        for (; i < count; ++i)
+            output[i] = (static_cast<int>(input[i]) - 128) * (1.f / 128.f);
+    }
+
+    void convert16bit(const sf::Uint8* input, float* output, std::size_t count)
+    {
+        std::size_t i = 0;
+
+        if (isLittleEndian())
+        {
+#if defined(SFML_WAV_SSE2)
+            const __m128 scale = _mm_set1_ps(1.f / 32768.f);
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 2));
+                __m128i low   = _mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16);
+                __m128i high  = _mm_srai_epi32(_mm_unpackhi_epi16(words, words), 16);
+                _mm_storeu_ps(output + i,     _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+                _mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+            }
+#elif defined(SFML_WAV_NEON)
+            for (; i + 8 <= count; i += 8)
+            {
+                int16x8_t words = vld1q_s16(reinterpret_cast<const int16_t*>(input + i * 2));
+                vst1q_f32(output + i,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(words))), 1.f / 32768.f));
+                vst1q_f32(output + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(words))), 1.f / 32768.f));
+            }
+#endif
+        }
+
+        for (; i < count; ++i)
+            output[i] = static_cast<sf::Int16>(input[i * 2] | (input[i * 2 + 1] << 8)) * (1.f / 32768.f);
+    }
+
+    void convert24bit(const sf::Uint8* input, float* output, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // Place the sample in the upper bytes of a 32 bits integer to get the sign right
+            sf::Uint32 sample = (input[i * 3] << 8) | (input[i * 3 + 1] << 16) | (static_cast<sf::Uint32>(input[i * 3 + 2]) << 24);
+            output[i] = static_cast<sf::Int32>(sample) * (1.f / 2147483648.f);
+        }
+    }
+
+    void convert32bit(const sf::Uint8* input, float* output, std::size_t count)
+    {
+        std::size_t i = 0;
+
+        if (isLittleEndian())
+        {
+#if defined(SFML_WAV_SSE2)
+            const __m128 scale = _mm_set1_ps(1.f / 2147483648.f);
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 4));
+                _mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(samples), scale));
+            }
+#elif defined(SFML_WAV_NEON)
+            for (; i + 4 <= count; i += 4)
+            {
+                int32x4_t samples = vld1q_s32(reinterpret_cast<const int32_t*>(input + i * 4));
+                vst1q_f32(output + i, vmulq_n_f32(vcvtq_f32_s32(samples), 1.f / 2147483648.f));
+            }
+#endif
+        }
+
+        for (; i < count; ++i)
+        {
+            sf::Uint32 sample = input[i * 4] | (input[i * 4 + 1] << 8) | (input[i * 4 + 2] << 16) | (static_cast<sf::Uint32>(input[i * 4 + 3]) << 24);
+            output[i] = static_cast<sf::Int32>(sample) * (1.f / 2147483648.f);
+        }
+    }
 }
 
 namespace sf
@@ -111,7 +321,9 @@ SoundFileReaderWav::SoundFileReaderWav() :
 m_stream        (NULL),
 m_bytesPerSample(0),
 m_dataStart     (0),
-m_dataEnd       (0)
+m_dataEnd       (0),
+m_position      (0),
+m_block         ()
 {
 }
 
@@ -136,7 +348,8 @@ void SoundFileReaderWav::seek(Uint64 sampleOffset)
 {
     assert(m_stream);
 
-    m_stream->seek(m_dataStart + sampleOffset * m_bytesPerSample);
+    m_position = std::min(m_dataStart + sampleOffset * m_bytesPerSample, m_dataEnd);
+    m_stream->seek(m_position);
 }
 
 
@@ -145,65 +358,98 @@ Uint64 SoundFileReaderWav::read(Int16* samples, Uint64 maxCount)
 {
     assert(m_stream);
 
+    m_block.resize(blockSize);
+
+    // Read whole blocks of samples, and convert them all at once
     Uint64 count = 0;
-    while ((count < maxCount) && (m_stream->tell() < m_dataEnd))
+    while (count < maxCount)
     {
+        std::size_t toRead = static_cast<std::size_t>(std::min(maxCount - count, static_cast<Uint64>(blockSize / m_bytesPerSample)));
+
+        // Little endian 16 bits samples are already in the right format
+        bool direct = (m_bytesPerSample == 2) && isLittleEndian();
+        std::size_t samplesRead = readBlock(direct ? static_cast<void*>(samples + count) : &m_block[0], toRead);
+
         switch (m_bytesPerSample)
         {
-            case 1:
-            {
-                Uint8 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = (static_cast<Int16>(sample) - 128) << 8;
-                else
-                    return count;
-                break;
-            }
+            case 1:  convert8bit(&m_block[0], samples + count, samplesRead);  break;
+            case 2:  if (!direct) convert16bit(&m_block[0], samples + count, samplesRead); break;
+            case 3:  convert24bit(&m_block[0], samples + count, samplesRead); break;
+            case 4:  convert32bit(&m_block[0], samples + count, samplesRead); break;
+            default: assert(false); return 0;
+        }
 
-            case 2:
-            {
-                Int16 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample;
-                else
-                    return count;
-                break;
-            }
+        count += samplesRead;
 
-            case 3:
-            {
-                Uint32 sample = 0;
-                if (decode24bit(*m_stream, sample))
-                    *samples++ = sample >> 8;
-                else
-                    return count;
-                break;
-            }
+        // Stop at the end of the data
+        if (samplesRead < toRead)
+            break;
+    }
 
-            case 4:
-            {
-                Uint32 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample >> 16;
-                else
-                    return count;
-                break;
-            }
+    return count;
+}
 
-            default:
-            {
-                assert(false);
-                return 0;
-            }
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderWav::readFloat(float* samples, Uint64 maxCount)
+{
+    assert(m_stream);
+
+    m_block.resize(blockSize);
+
+    // Read whole blocks of samples, and convert them all at once
+    Uint64 count = 0;
+    while (count < maxCount)
+    {
+        std::size_t toRead = static_cast<std::size_t>(std::min(maxCount - count, static_cast<Uint64>(blockSize / m_bytesPerSample)));
+        std::size_t samplesRead = readBlock(&m_block[0], toRead);
+
+        switch (m_bytesPerSample)
+        {
+            case 1:  convert8bit(&m_block[0], samples + count, samplesRead);  break;
+            case 2:  convert16bit(&m_block[0], samples + count, samplesRead); break;
+            case 3:  convert24bit(&m_block[0], samples + count, samplesRead); break;
+            case 4:  convert32bit(&m_block[0], samples + count, samplesRead); break;
+            default: assert(false); return 0;
         }
 
-        ++count;
+        count += samplesRead;
+
+        // Stop at the end of the data
+        if (samplesRead < toRead)
+            break;
     }
 
     return count;
 }
 
 
+////////////////////////////////////////////////////////////
+std::size_t SoundFileReaderWav::readBlock(void* destination, std::size_t maxCount)
+{
+    if (m_position >= m_dataEnd)
+        return 0;
+
+    Uint64 available = (m_dataEnd - m_position) / m_bytesPerSample;
+    std::size_t toRead = static_cast<std::size_t>(std::min(static_cast<Uint64>(maxCount), available));
+    if (toRead == 0)
+        return 0;
+
+    Int64 bytesRead = m_stream->read(destination, toRead * m_bytesPerSample);
+    if (bytesRead <= 0)
+        return 0;
+
+    std::size_t samplesRead = static_cast<std::size_t>(bytesRead) / m_bytesPerSample;
+    m_position += samplesRead * m_bytesPerSample;
+
+    // Don't leave the stream in the middle of a sample
+    if (samplesRead * m_bytesPerSample != static_cast<std::size_t>(bytesRead))
+        m_stream->seek(m_position);
+
+    return samplesRead;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundFileReaderWav::parseHeader(Info& info)
 {
@@ -289,6 +535,7 @@ bool SoundFileReaderWav::parseHeader(Info& info)
             // Store the start and end position of samples in the file
             m_dataStart = m_stream->tell();
             m_dataEnd = m_dataStart + info.sampleCount * m_bytesPerSample;
+            m_position = m_dataStart;
 
             dataChunkFound = true;
         }
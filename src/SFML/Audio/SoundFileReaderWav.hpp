@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -96,6 +97,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floating point numbers
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 readFloat(float* samples, Uint64 maxCount);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -108,13 +120,26 @@ private:
     ////////////////////////////////////////////////////////////
     bool parseHeader(Info& info);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a block of raw samples from the data chunk
+    ///
+    /// \param destination Memory to fill with the raw samples
+    /// \param maxCount    Maximum number of samples to read
+    ///
+    /// \return Number of whole samples actually read
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t readBlock(void* destination, std::size_t maxCount);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    InputStream* m_stream;         ///< Source stream to read from
-    unsigned int m_bytesPerSample; ///< Size of a sample, in bytes
-    Uint64       m_dataStart;      ///< Starting position of the audio data in the open file
-    Uint64       m_dataEnd;        ///< Position one byte past the end of the audio data in the open file
+    InputStream*       m_stream;         ///< Source stream to read from
+    unsigned int       m_bytesPerSample; ///< Size of a sample, in bytes
+    Uint64             m_dataStart;      ///< Starting position of the audio data in the open file
+    Uint64             m_dataEnd;        ///< Position one byte past the end of the audio data in the open file
+    Uint64             m_position;       ///< Current read position in the open file
+    std::vector<Uint8> m_block;          ///< Block of raw samples read from the file, before conversion
 };
 
 } // namespace priv
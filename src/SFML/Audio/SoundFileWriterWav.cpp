@@ -132,8 +132,22 @@ void SoundFileWriterWav::write(const Int16* samples, Uint64 count)
 
     m_sampleCount += count;
 
-    while (count--)
-        encode(m_file, *samples++);
+    // Convert the samples to little endian by blocks, so that the stream
+    // receives a few large writes instead of two bytes at a time
+    char bytes[8192];
+    while (count > 0)
+    {
+        std::size_t blockCount = static_cast<std::size_t>(std::min(count, static_cast<Uint64>(sizeof(bytes) / 2)));
+        for (std::size_t i = 0; i < blockCount; ++i)
+        {
+            bytes[i * 2]     = static_cast<char>(samples[i] & 0xFF);
+            bytes[i * 2 + 1] = static_cast<char>(samples[i] >> 8);
+        }
+
+        m_file.write(bytes, blockCount * 2);
+        samples += blockCount;
+        count -= blockCount;
+    }
 }
 
 
@@ -191,7 +205,8 @@ void SoundFileWriterWav::close()
         m_file.flush();
 
         // Update the main chunk size and data sub-chunk size
-        Uint32 dataChunkSize = static_cast<Uint32>(m_sampleCount * m_channelCount * 2);
+        // (m_sampleCount already counts the samples of all the channels)
+        Uint32 dataChunkSize = static_cast<Uint32>(m_sampleCount * 2);
         Uint32 mainChunkSize = dataChunkSize + 36;
         m_file.seekp(4);
         encode(m_file, mainChunkSize);
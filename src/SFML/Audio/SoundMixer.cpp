@@ -0,0 +1,580 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundMixer.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_MIXER_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_MIXER_NEON
+#endif
+
+
+namespace
+{
+    // Number of frames mixed at once; bounds the size of the scratch buffers
+    const std::size_t blockFrames = 256;
+
+    // Layout of the polyphase filter bank
+    const int filterTaps       = 8;
+    const int filterPhaseBits  = 7;
+    const int filterPhases     = 1 << filterPhaseBits;
+
+    const float pi = 3.141592654f;
+
+    // Add src * gain to acc; gains alternate between the two
+    // output channels, so that stereo panning is applied for free
+    void accumulate(float* acc, const float* src, float gain0, float gain1, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_MIXER_SSE2)
+        __m128 gains = _mm_setr_ps(gain0, gain1, gain0, gain1);
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(_mm_loadu_ps(src + i), gains)));
+#elif defined(SFML_MIXER_NEON)
+        const float gainArray[4] = {gain0, gain1, gain0, gain1};
+        float32x4_t gains = vld1q_f32(gainArray);
+        for (; i + 4 <= count; i += 4)
+            vst1q_f32(acc + i, vmlaq_f32(vld1q_f32(acc + i), vld1q_f32(src + i), gains));
+#endif
+
+        for (; i < count; ++i)
+            acc[i] += src[i] * ((i % 2 == 0) ? gain0 : gain1);
+    }
+
+    // Convert the mix to 16-bits samples, with saturation
+    void convert(const float* acc, sf::Int16* output, std::size_t count)
+    {
+        std::size_t i = 0;
+
+        // All the paths clamp, then truncate toward zero like the scalar cast, so
+        // that the output doesn't depend on the alignment or on the platform
+#if defined(SFML_MIXER_SSE2)
+        __m128 scale   = _mm_set1_ps(32767.f);
+        __m128 minimum = _mm_set1_ps(-32768.f);
+        __m128 maximum = _mm_set1_ps(32767.f);
+        for (; i + 8 <= count; i += 8)
+        {
+            // Out of range values would convert to 0x80000000, clamp them first
+            __m128 lowSamples  = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(acc + i), scale), minimum), maximum);
+            __m128 highSamples = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(acc + i + 4), scale), minimum), maximum);
+            __m128i low  = _mm_cvttps_epi32(lowSamples);
+            __m128i high = _mm_cvttps_epi32(highSamples);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(low, high));
+        }
+#elif defined(SFML_MIXER_NEON)
+        // vcvtq_s32_f32 truncates and saturates, vqmovn_s32 saturates to 16 bits
+        float32x4_t scale = vdupq_n_f32(32767.f);
+        for (; i + 8 <= count; i += 8)
+        {
+            int32x4_t low  = vcvtq_s32_f32(vmulq_f32(vld1q_f32(acc + i), scale));
+            int32x4_t high = vcvtq_s32_f32(vmulq_f32(vld1q_f32(acc + i + 4), scale));
+            vst1q_s16(output + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            float sample = acc[i] * 32767.f;
+            if (sample > 32767.f)
+                sample = 32767.f;
+            else if (sample < -32768.f)
+                sample = -32768.f;
+            output[i] = static_cast<sf::Int16>(sample);
+        }
+    }
+
+    // Blackman-windowed sinc, over the interval [-filterTaps / 2, filterTaps / 2]
+    float windowedSinc(float x)
+    {
+        const float halfWidth = filterTaps / 2.f;
+        if (std::fabs(x) >= halfWidth)
+            return 0.f;
+
+        float sinc = (std::fabs(x) < 1e-6f) ? 1.f : std::sin(pi * x) / (pi * x);
+        float window = 0.42f + 0.5f * std::cos(pi * x / halfWidth) + 0.08f * std::cos(2.f * pi * x / halfWidth);
+
+        return sinc * window;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoundMixer::VoiceSettings::VoiceSettings() :
+volume  (100.f),
+pitch   (1.f),
+pan     (0.f),
+loop    (false),
+priority(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::SoundMixer(unsigned int channelCount, unsigned int sampleRate, std::size_t maxVoices) :
+m_channelCount  (channelCount),
+m_sampleRate    (sampleRate),
+m_voices        (maxVoices),
+m_nextId        (1),
+m_masterVolume  (1.f),
+m_resampler     (Linear),
+m_accumulator   (),
+m_voiceBuffer   (),
+m_filters       (filterPhases * filterTaps),
+m_mixingTime    (Time::Zero),
+m_renderedFrames(0)
+{
+    if ((m_channelCount != 1) && (m_channelCount != 2))
+    {
+        err() << "Unsupported number of channels for the sound mixer (" << m_channelCount << "), using stereo" << std::endl;
+        m_channelCount = 2;
+    }
+
+    if (m_sampleRate == 0)
+    {
+        err() << "Invalid sample rate for the sound mixer, using 44100 Hz" << std::endl;
+        m_sampleRate = 44100;
+    }
+
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+        m_voices[i].id = 0;
+
+    m_accumulator.resize(blockFrames * m_channelCount);
+    m_voiceBuffer.resize(blockFrames * m_channelCount);
+
+    // Build the filter bank: each phase is the sinc kernel shifted by a fraction
+    // of sample, normalized so that it doesn't change the level of the signal
+    for (int phase = 0; phase < filterPhases; ++phase)
+    {
+        float fraction = static_cast<float>(phase) / filterPhases;
+        float* filter = &m_filters[phase * filterTaps];
+
+        float sum = 0.f;
+        for (int tap = 0; tap < filterTaps; ++tap)
+        {
+            filter[tap] = windowedSinc(tap - (filterTaps / 2 - 1) - fraction);
+            sum += filter[tap];
+        }
+
+        for (int tap = 0; tap < filterTaps; ++tap)
+            filter[tap] /= sum;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::VoiceId SoundMixer::play(const SoundBuffer& buffer, const VoiceSettings& settings)
+{
+    return play(buffer.getSamples(), buffer.getSampleCount(), buffer.getChannelCount(), buffer.getSampleRate(), settings);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::VoiceId SoundMixer::play(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate, const VoiceSettings& settings)
+{
+    if (!samples || (sampleCount == 0) || (sampleRate == 0))
+        return 0;
+
+    if ((channelCount != 1) && (channelCount != 2))
+    {
+        err() << "Failed to play sound on the mixer: unsupported number of channels (" << channelCount << ")" << std::endl;
+        return 0;
+    }
+
+    Lock lock(m_mutex);
+
+    // Look for a free voice
+    Voice* slot = NULL;
+    for (std::size_t i = 0; (i < m_voices.size()) && !slot; ++i)
+    {
+        if (m_voices[i].id == 0)
+            slot = &m_voices[i];
+    }
+
+    // If there is none, steal the least important voice
+    if (!slot)
+    {
+        Uint64 slotRemaining = 0;
+        for (std::size_t i = 0; i < m_voices.size(); ++i)
+        {
+            Voice& voice = m_voices[i];
+            Uint64 remaining = voice.loop ? static_cast<Uint64>(-1) : voice.frameCount - (voice.position >> 32);
+
+            if (!slot || (voice.priority < slot->priority) || ((voice.priority == slot->priority) && (remaining < slotRemaining)))
+            {
+                slot = &voice;
+                slotRemaining = remaining;
+            }
+        }
+
+        if (!slot || (slot->priority > settings.priority))
+            return 0;
+    }
+
+    slot->id           = m_nextId;
+    slot->samples      = samples;
+    slot->frameCount   = sampleCount / channelCount;
+    slot->channelCount = channelCount;
+    slot->sampleRate   = sampleRate;
+    slot->position     = 0;
+    slot->volume       = settings.volume * 0.01f;
+    slot->pitch        = settings.pitch;
+    slot->pan          = settings.pan;
+    slot->loop         = settings.loop;
+    slot->priority     = settings.priority;
+
+    // Skip 0, which is reserved for invalid voices
+    if (++m_nextId == 0)
+        m_nextId = 1;
+
+    return slot->id;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::stop(VoiceId voice)
+{
+    Lock lock(m_mutex);
+
+    if (Voice* found = findVoice(voice))
+        found->id = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::stopAll()
+{
+    Lock lock(m_mutex);
+
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+        m_voices[i].id = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundMixer::isPlaying(VoiceId voice) const
+{
+    Lock lock(m_mutex);
+
+    return const_cast<SoundMixer*>(this)->findVoice(voice) != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setVolume(VoiceId voice, float volume)
+{
+    Lock lock(m_mutex);
+
+    if (Voice* found = findVoice(voice))
+        found->volume = volume * 0.01f;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setPitch(VoiceId voice, float pitch)
+{
+    Lock lock(m_mutex);
+
+    if (Voice* found = findVoice(voice))
+        found->pitch = pitch;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setPan(VoiceId voice, float pan)
+{
+    Lock lock(m_mutex);
+
+    if (Voice* found = findVoice(voice))
+        found->pan = pan;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setLoop(VoiceId voice, bool loop)
+{
+    Lock lock(m_mutex);
+
+    if (Voice* found = findVoice(voice))
+        found->loop = loop;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundMixer::getVoiceCount() const
+{
+    Lock lock(m_mutex);
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+    {
+        if (m_voices[i].id != 0)
+            ++count;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setMasterVolume(float volume)
+{
+    Lock lock(m_mutex);
+    m_masterVolume = volume * 0.01f;
+}
+
+
+////////////////////////////////////////////////////////////
+float SoundMixer::getMasterVolume() const
+{
+    Lock lock(m_mutex);
+    return m_masterVolume * 100.f;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setResampler(Resampler resampler)
+{
+    Lock lock(m_mutex);
+    m_resampler = resampler;
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::Resampler SoundMixer::getResampler() const
+{
+    Lock lock(m_mutex);
+    return m_resampler;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundMixer::getChannelCount() const
+{
+    return m_channelCount;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundMixer::getSampleRate() const
+{
+    return m_sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::render(Int16* samples, std::size_t frameCount)
+{
+    Lock lock(m_mutex);
+
+    Clock clock;
+    m_renderedFrames += frameCount;
+
+    while (frameCount > 0)
+    {
+        std::size_t frames = std::min(frameCount, blockFrames);
+        std::size_t count = frames * m_channelCount;
+
+        std::fill(m_accumulator.begin(), m_accumulator.begin() + count, 0.f);
+
+        for (std::size_t i = 0; i < m_voices.size(); ++i)
+        {
+            if (m_voices[i].id != 0)
+                mixVoice(m_voices[i], frames);
+        }
+
+        convert(&m_accumulator[0], samples, count);
+
+        samples += count;
+        frameCount -= frames;
+    }
+
+    m_mixingTime += clock.getElapsedTime();
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundMixer::getMixingTime() const
+{
+    Lock lock(m_mutex);
+    return m_mixingTime;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundMixer::getRenderedFrameCount() const
+{
+    Lock lock(m_mutex);
+    return m_renderedFrames;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::resetStatistics()
+{
+    Lock lock(m_mutex);
+    m_mixingTime = Time::Zero;
+    m_renderedFrames = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::Voice* SoundMixer::findVoice(VoiceId voice)
+{
+    if (voice == 0)
+        return NULL;
+
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+    {
+        if (m_voices[i].id == voice)
+            return &m_voices[i];
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::mixVoice(Voice& voice, std::size_t frameCount)
+{
+    const Int64 frames = static_cast<Int64>(voice.frameCount);
+    const unsigned int channels = voice.channelCount;
+    const Int16* data = voice.samples;
+    const float scale = 1.f / 32768.f;
+
+    // Fixed-point step between two output frames, in source frames
+    double ratio = static_cast<double>(voice.sampleRate) / m_sampleRate * std::max(voice.pitch, 0.f);
+    Uint64 step = static_cast<Uint64>(ratio * 4294967296.0);
+    Uint64 end = static_cast<Uint64>(frames) << 32;
+
+    const int halfTaps = (m_resampler == Polyphase) ? filterTaps / 2 : 1;
+    bool finished = false;
+    std::size_t frame = 0;
+
+    for (; frame < frameCount; ++frame)
+    {
+        if (voice.position >= end)
+        {
+            if (!voice.loop || (end == 0))
+            {
+                finished = true;
+                break;
+            }
+            voice.position %= end;
+        }
+
+        Int64 index = static_cast<Int64>(voice.position >> 32);
+        Uint32 fraction = static_cast<Uint32>(voice.position);
+        float left = 0.f;
+        float right = 0.f;
+
+        // Take the fast path when the whole filter fits inside the samples;
+        // otherwise wrap around (when looping) or pad with silence
+        bool inside = (index - halfTaps + 1 >= 0) && (index + halfTaps < frames);
+
+        if (m_resampler == Linear)
+        {
+            Int64 next = index + 1;
+            if (!inside && (next >= frames))
+                next = voice.loop ? next - frames : -1;
+
+            float t = fraction * (1.f / 4294967296.f);
+            for (unsigned int c = 0; c < channels; ++c)
+            {
+                float s0 = data[index * channels + c];
+                float s1 = (next >= 0) ? data[next * channels + c] : 0.f;
+                (c == 0 ? left : right) = (s0 + (s1 - s0) * t) * scale;
+            }
+        }
+        else
+        {
+            const float* filter = &m_filters[(fraction >> (32 - filterPhaseBits)) * filterTaps];
+            for (int tap = 0; tap < filterTaps; ++tap)
+            {
+                Int64 source = index - (filterTaps / 2 - 1) + tap;
+                if (!inside)
+                {
+                    if (voice.loop)
+                        source = ((source % frames) + frames) % frames;
+                    else if ((source < 0) || (source >= frames))
+                        continue;
+                }
+
+                left += data[source * channels] * filter[tap];
+                if (channels == 2)
+                    right += data[source * channels + 1] * filter[tap];
+            }
+            left *= scale;
+            right *= scale;
+        }
+
+        if (channels == 1)
+            right = left;
+
+        // Map the voice channels to the output channels
+        if (m_channelCount == 2)
+        {
+            m_voiceBuffer[frame * 2]     = left;
+            m_voiceBuffer[frame * 2 + 1] = right;
+        }
+        else
+        {
+            m_voiceBuffer[frame] = (left + right) * 0.5f;
+        }
+
+        voice.position += step;
+    }
+
+    // Apply the volume and the panning, and add the voice to the mix
+    float gain = voice.volume * m_masterVolume;
+    if (m_channelCount == 2)
+    {
+        float pan = std::max(-1.f, std::min(voice.pan, 1.f));
+        accumulate(&m_accumulator[0], &m_voiceBuffer[0], gain * std::min(1.f, 1.f - pan), gain * std::min(1.f, 1.f + pan), frame * 2);
+    }
+    else
+    {
+        accumulate(&m_accumulator[0], &m_voiceBuffer[0], gain, gain, frame);
+    }
+
+    if (finished)
+        voice.id = 0;
+}
+
+} // namespace sf
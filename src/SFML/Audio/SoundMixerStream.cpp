@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundMixerStream.hpp>
+#include <SFML/Audio/SoundMixer.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoundMixerStream::SoundMixerStream(SoundMixer& mixer, Time chunkDuration) :
+m_mixer  (mixer),
+m_samples()
+{
+    std::size_t frameCount = static_cast<std::size_t>(chunkDuration.asSeconds() * mixer.getSampleRate());
+    if (frameCount == 0)
+        frameCount = 1;
+
+    m_samples.resize(frameCount * mixer.getChannelCount());
+
+    setChunkDuration(chunkDuration);
+    initialize(mixer.getChannelCount(), mixer.getSampleRate());
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixerStream::~SoundMixerStream()
+{
+    // We must stop before destroying the samples buffer
+    stop();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundMixerStream::onGetData(Chunk& data)
+{
+    m_mixer.render(&m_samples[0], m_samples.size() / m_mixer.getChannelCount());
+
+    data.samples = &m_samples[0];
+    data.sampleCount = m_samples.size();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixerStream::onSeek(Time)
+{
+    // Nothing to do, a mix can't be seeked
+}
+
+} // namespace sf
@@ -28,8 +28,10 @@
 #include <SFML/Audio/SoundRecorder.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
 #include <cstring>
 #include <cassert>
 
@@ -52,7 +54,11 @@ m_sampleRate        (0),
 m_processingInterval(milliseconds(100)),
 m_isCapturing       (false),
 m_deviceName        (getDefaultDevice()),
-m_channelCount      (1)
+m_channelCount      (1),
+m_mutex             (),
+m_wakeUp            (),
+m_statistics        (),
+m_totalJitter       ()
 {
 
 }
@@ -98,8 +104,8 @@ bool SoundRecorder::start(unsigned int sampleRate)
         return false;
     }
 
-    // Clear the array of samples
-    m_samples.clear();
+    // Allocate the array of samples once, it can hold the whole capture buffer (1 second)
+    m_samples.resize(sampleRate * m_channelCount);
 
     // Store the sample rate
     m_sampleRate = sampleRate;
@@ -128,6 +134,7 @@ void SoundRecorder::stop()
     if (m_isCapturing)
     {
         m_isCapturing = false;
+        m_wakeUp.notify();
         m_thread.wait();
 
         // Notify derived class
@@ -182,6 +189,7 @@ bool SoundRecorder::setDevice(const std::string& name)
     {
         // Stop the capturing thread
         m_isCapturing = false;
+        m_wakeUp.notify();
         m_thread.wait();
 
         // Determine the recording format
@@ -251,10 +259,34 @@ bool SoundRecorder::isAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+SoundRecorder::Statistics SoundRecorder::getStatistics() const
+{
+    Lock lock(m_mutex);
+
+    Statistics statistics = m_statistics;
+    if (statistics.processedChunkCount > 0)
+        statistics.jitter = m_totalJitter / static_cast<Int64>(statistics.processedChunkCount);
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundRecorder::resetStatistics()
+{
+    Lock lock(m_mutex);
+
+    m_statistics = Statistics();
+    m_totalJitter = Time::Zero;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundRecorder::setProcessingInterval(Time interval)
 {
-    m_processingInterval = interval;
+    Lock lock(m_mutex);
+    m_processingInterval = std::max(interval, milliseconds(1));
 }
 
 
@@ -276,13 +308,47 @@ void SoundRecorder::onStop()
 ////////////////////////////////////////////////////////////
 void SoundRecorder::record()
 {
+    // The wake-ups follow a fixed schedule, so that the processing time doesn't accumulate
+    Clock clock;
+    Time deadline = Time::Zero;
+
     while (m_isCapturing)
     {
+        Time delay = clock.getElapsedTime() - deadline;
+
         // Process available samples
-        processCapturedSamples();
+        unsigned int frameCount = processCapturedSamples();
+
+        Time interval;
+        {
+            Lock lock(m_mutex);
+
+            if (frameCount > 0)
+            {
+                Time latency = seconds(static_cast<float>(frameCount) / m_sampleRate);
+                m_statistics.processedChunkCount++;
+                m_statistics.latency = latency;
+                m_statistics.maxLatency = std::max(m_statistics.maxLatency, latency);
+                m_statistics.maxJitter = std::max(m_statistics.maxJitter, delay);
+                m_totalJitter += delay;
+
+                // The capture buffer holds one second of audio: if it was full, samples were dropped
+                if (frameCount >= m_sampleRate)
+                    m_statistics.overrunCount++;
+            }
+
+            interval = m_processingInterval;
+        }
+
+        // Schedule the next wake-up; if we are late by more than an interval, don't try to catch up
+        Time now = clock.getElapsedTime();
+        deadline += interval;
+        if (deadline + interval < now)
+            deadline = now;
 
         // Don't bother the CPU while waiting for more captured data
-        sleep(m_processingInterval);
+        if (deadline > now)
+            m_wakeUp.wait(deadline - now);
     }
 
     // Capture is finished: clean up everything
@@ -291,7 +357,7 @@ void SoundRecorder::record()
 
 
 ////////////////////////////////////////////////////////////
-void SoundRecorder::processCapturedSamples()
+unsigned int SoundRecorder::processCapturedSamples()
 {
     // Get the number of samples available
     ALCint samplesAvailable;
@@ -299,17 +365,21 @@ void SoundRecorder::processCapturedSamples()
 
     if (samplesAvailable > 0)
     {
-        // Get the recorded samples
-        m_samples.resize(samplesAvailable * getChannelCount());
-        alcCaptureSamples(captureDevice, &m_samples[0], samplesAvailable);
+        // Get the recorded samples, without exceeding the array allocated when the capture started
+        ALCint frameCount = std::min(samplesAvailable, static_cast<ALCint>(m_samples.size() / m_channelCount));
+        alcCaptureSamples(captureDevice, &m_samples[0], frameCount);
 
         // Forward them to the derived class
-        if (!onProcessSamples(&m_samples[0], m_samples.size()))
+        if (!onProcessSamples(&m_samples[0], frameCount * m_channelCount))
         {
             // The user wants to stop the capture
             m_isCapturing = false;
         }
+
+        return static_cast<unsigned int>(samplesAvailable);
     }
+
+    return 0;
 }
 
 
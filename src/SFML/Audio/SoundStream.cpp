@@ -27,33 +27,61 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundStream.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/StreamScheduler.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/System/Lock.hpp>
+#include <algorithm>
 
 #ifdef _MSC_VER
     #pragma warning(disable: 4355) // 'this' used in base member initializer list
 #endif
 
 
+namespace
+{
+    const unsigned int defaultBufferCount = 3;
+    const unsigned int minBufferCount     = 2;
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 SoundStream::SoundStream() :
-m_thread          (&SoundStream::streamData, this),
-m_threadMutex     (),
-m_threadStartState(Stopped),
-m_isStreaming     (false),
-m_buffers         (),
-m_channelCount    (0),
-m_sampleRate      (0),
-m_format          (0),
-m_loop            (false),
-m_samplesProcessed(0),
-m_endBuffers      ()
+m_thread           (&SoundStream::streamData, this),
+m_threadMutex      (),
+m_wakeUp           (),
+m_threadStartState (Stopped),
+m_isStreaming      (false),
+m_dedicatedThread  (false),
+m_requestStop      (false),
+m_seekPending      (false),
+m_seekOffset       (),
+m_bufferCount      (defaultBufferCount),
+m_activeBufferCount(defaultBufferCount),
+m_chunkDuration    (seconds(1)),
+m_buffers          (),
+m_channelCount     (0),
+m_sampleRate       (0),
+m_format           (0),
+m_floatSamples     (false),
+m_floatFormat      (0),
+m_loop             (false),
+m_samplesProcessed (0),
+m_endBuffers       (),
+m_bufferFrames     (),
+m_queue            (),
+m_queueStart       (0),
+m_queueSize        (0),
+m_statistics       ()
 {
+    // The streaming thread must never miss a refill; ask for a realtime
+    // priority (silently ignored if the system doesn't allow it)
+    m_thread.setPriority(Thread::Realtime);
 
+    resetStatistics();
 }
 
 
@@ -66,24 +94,29 @@ SoundStream::~SoundStream()
     {
         Lock lock(m_threadMutex);
         m_isStreaming = false;
+        m_seekPending = false;
     }
 
     // Wait for the thread to terminate
-    m_thread.wait();
+    waitStreaming();
 }
 
 
 ////////////////////////////////////////////////////////////
-void SoundStream::initialize(unsigned int channelCount, unsigned int sampleRate)
+void SoundStream::initialize(unsigned int channelCount, unsigned int sampleRate, bool floatSamples)
 {
     m_channelCount = channelCount;
     m_sampleRate = sampleRate;
     m_samplesProcessed = 0;
     m_isStreaming = false;
+    m_floatSamples = floatSamples;
 
     // Deduce the format from the number of channels
     m_format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
 
+    // Floating point samples are converted if the device can't take them directly
+    m_floatFormat = floatSamples ? priv::AudioDevice::getFloatFormatFromChannelCount(channelCount) : 0;
+
     // Check if the format is valid
     if (m_format == 0)
     {
@@ -128,11 +161,16 @@ void SoundStream::play()
         // If the sound is playing, stop it and continue as if it was stopped
         stop();
     }
+    else
+    {
+        // The stream may have just reached its end, make sure it has been released
+        waitStreaming();
+    }
 
     // Start updating the stream in a separate thread to avoid blocking the application
     m_isStreaming = true;
     m_threadStartState = Playing;
-    m_thread.launch();
+    launchStreaming();
 }
 
 
@@ -163,7 +201,7 @@ void SoundStream::stop()
     }
 
     // Wait for the thread to terminate
-    m_thread.wait();
+    waitStreaming();
 
     // Move to the beginning
     onSeek(Time::Zero);
@@ -208,6 +246,26 @@ SoundStream::Status SoundStream::getStatus() const
 ////////////////////////////////////////////////////////////
 void SoundStream::setPlayingOffset(Time timeOffset)
 {
+    // If the stream is running, let the streaming loop seek without stopping it
+    bool isStreaming = false;
+    {
+        Lock lock(m_threadMutex);
+
+        isStreaming = m_isStreaming;
+        if (isStreaming)
+        {
+            m_seekOffset  = timeOffset;
+            m_seekPending = true;
+        }
+    }
+
+    if (isStreaming)
+    {
+        m_wakeUp.notify();
+        priv::StreamScheduler::wake(*this);
+        return;
+    }
+
     // Get old playing status
     Status oldStatus = getStatus();
 
@@ -225,13 +283,20 @@ void SoundStream::setPlayingOffset(Time timeOffset)
 
     m_isStreaming = true;
     m_threadStartState = oldStatus;
-    m_thread.launch();
+    launchStreaming();
 }
 
 
 ////////////////////////////////////////////////////////////
 Time SoundStream::getPlayingOffset() const
 {
+    // Report the requested position until the streaming loop has performed the seek
+    {
+        Lock lock(m_threadMutex);
+        if (m_seekPending)
+            return m_seekOffset;
+    }
+
     if (m_sampleRate && m_channelCount)
     {
         ALfloat secs = 0.f;
@@ -260,11 +325,154 @@ bool SoundStream::getLoop() const
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundStream::setBufferCount(unsigned int count)
+{
+    Lock lock(m_threadMutex);
+    m_bufferCount = std::min(std::max(count, minBufferCount), static_cast<unsigned int>(MaxBufferCount));
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getBufferCount() const
+{
+    Lock lock(m_threadMutex);
+    return m_bufferCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setChunkDuration(Time duration)
+{
+    Lock lock(m_threadMutex);
+    m_chunkDuration = std::max(duration, milliseconds(1));
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getChunkDuration() const
+{
+    Lock lock(m_threadMutex);
+    return m_chunkDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setDedicatedThread(bool dedicated)
+{
+    Lock lock(m_threadMutex);
+    m_dedicatedThread = dedicated;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStream::hasDedicatedThread() const
+{
+    Lock lock(m_threadMutex);
+    return m_dedicatedThread;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setSharedThreadCount(unsigned int count)
+{
+    priv::StreamScheduler::setThreadCount(count);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getSharedThreadCount()
+{
+    return priv::StreamScheduler::getThreadCount();
+}
+
+
+////////////////////////////////////////////////////////////
+SoundStream::Statistics SoundStream::getStatistics() const
+{
+    Lock lock(m_threadMutex);
+
+    Statistics statistics = m_statistics;
+
+    // The minimum is negative until the streaming loop has measured anything
+    if (statistics.minQueuedDuration < Time::Zero)
+        statistics.minQueuedDuration = Time::Zero;
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::resetStatistics()
+{
+    Lock lock(m_threadMutex);
+    m_statistics.underrunCount     = 0;
+    m_statistics.queuedDuration    = Time::Zero;
+    m_statistics.minQueuedDuration = microseconds(-1);
+    m_statistics.queuedBufferCount = 0;
+    m_statistics.decodedChunkCount = 0;
+    m_statistics.decodeTime        = Time::Zero;
+    m_statistics.maxDecodeTime     = Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStream::onGetFloatData(FloatChunk&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::launchStreaming()
+{
+    bool dedicated = false;
+    {
+        Lock lock(m_threadMutex);
+        dedicated = m_dedicatedThread;
+    }
+
+    if (dedicated)
+        m_thread.launch();
+    else
+        priv::StreamScheduler::add(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::waitStreaming()
+{
+    // Wake up the dedicated thread if it's waiting for the queue to drain
+    m_wakeUp.notify();
+    m_thread.wait();
+
+    // Or wait until the shared workers have released the stream
+    priv::StreamScheduler::remove(*this);
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundStream::streamData()
 {
-    bool requestStop = false;
+    if (!startStreaming())
+        return;
+
+    Time delay;
+    Time queued;
+    while (updateStream(delay, queued))
+    {
+        // Sleep until the oldest buffer has been played, unless we are interrupted
+        if (delay > Time::Zero)
+            m_wakeUp.wait(delay);
+    }
+
+    finishStreaming();
+}
 
+
+////////////////////////////////////////////////////////////
+bool SoundStream::startStreaming()
+{
     {
         Lock lock(m_threadMutex);
 
@@ -272,17 +480,24 @@ void SoundStream::streamData()
         if (m_threadStartState == Stopped)
         {
             m_isStreaming = false;
-            return;
+            return false;
         }
+
+        m_activeBufferCount = m_bufferCount;
     }
 
     // Create the buffers
-    alCheck(alGenBuffers(BufferCount, m_buffers));
-    for (int i = 0; i < BufferCount; ++i)
-        m_endBuffers[i] = false;
+    alCheck(alGenBuffers(m_activeBufferCount, m_buffers));
+    for (unsigned int i = 0; i < m_activeBufferCount; ++i)
+    {
+        m_endBuffers[i]   = false;
+        m_bufferFrames[i] = 0;
+    }
+    m_queueStart = 0;
+    m_queueSize  = 0;
 
     // Fill the queue
-    requestStop = fillQueue();
+    m_requestStop = fillQueue();
 
     // Play the sound
     alCheck(alSourcePlay(m_source));
@@ -295,93 +510,127 @@ void SoundStream::streamData()
             alCheck(alSourcePause(m_source));
     }
 
-    for (;;)
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStream::updateStream(Time& delay, Time& queued)
+{
+    bool seekPending = false;
+    Time seekOffset;
     {
-        {
-            Lock lock(m_threadMutex);
-            if (!m_isStreaming)
-                break;
-        }
+        Lock lock(m_threadMutex);
+        if (!m_isStreaming)
+            return false;
+
+        seekPending = m_seekPending;
+        seekOffset  = m_seekOffset;
+    }
+
+    if (seekPending)
+    {
+        seekStreaming(seekOffset);
+
+        // Another seek may have been requested in the meantime
+        Lock lock(m_threadMutex);
+        if (m_seekOffset == seekOffset)
+            m_seekPending = false;
+    }
 
-        // The stream has been interrupted!
-        if (SoundSource::getStatus() == Stopped)
+    // The stream has been interrupted!
+    if (SoundSource::getStatus() == Stopped)
+    {
+        if (!m_requestStop)
         {
-            if (!requestStop)
+            // The queue ran dry before we could refill it: just continue
             {
-                // Just continue
-                alCheck(alSourcePlay(m_source));
-            }
-            else
-            {
-                // End streaming
                 Lock lock(m_threadMutex);
-                m_isStreaming = false;
+                m_statistics.underrunCount++;
             }
+            alCheck(alSourcePlay(m_source));
         }
+        else
+        {
+            // End streaming, unless a seek has just been requested
+            Lock lock(m_threadMutex);
+            if (!m_seekPending)
+                m_isStreaming = false;
+        }
+    }
+
+    // Get the number of buffers that have been processed (i.e. ready for reuse)
+    ALint nbProcessed = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+
+    while (nbProcessed--)
+    {
+        // Pop the first unused buffer from the queue
+        ALuint buffer;
+        alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
 
-        // Get the number of buffers that have been processed (i.e. ready for reuse)
-        ALint nbProcessed = 0;
-        alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+        // Buffers are played in the order they were queued, so it's the oldest one
+        unsigned int bufferNum = m_queue[m_queueStart];
+        m_queueStart = (m_queueStart + 1) % m_activeBufferCount;
+        m_queueSize--;
 
-        while (nbProcessed--)
+        // Retrieve its size and add it to the samples count
+        if (m_endBuffers[bufferNum])
         {
-            // Pop the first unused buffer from the queue
-            ALuint buffer;
-            alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
-
-            // Find its number
-            unsigned int bufferNum = 0;
-            for (int i = 0; i < BufferCount; ++i)
-                if (m_buffers[i] == buffer)
-                {
-                    bufferNum = i;
-                    break;
-                }
-
-            // Retrieve its size and add it to the samples count
-            if (m_endBuffers[bufferNum])
+            // This was the last buffer: reset the sample count
+            m_samplesProcessed = 0;
+            m_endBuffers[bufferNum] = false;
+        }
+        else
+        {
+            ALint size, bits;
+            alCheck(alGetBufferi(buffer, AL_SIZE, &size));
+            alCheck(alGetBufferi(buffer, AL_BITS, &bits));
+
+            // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
+            if (bits == 0)
             {
-                // This was the last buffer: reset the sample count
-                m_samplesProcessed = 0;
-                m_endBuffers[bufferNum] = false;
+                err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
+                      << "and initialize() has been called correctly" << std::endl;
+
+                // Abort streaming (exit main loop)
+                Lock lock(m_threadMutex);
+                m_isStreaming = false;
+                m_requestStop = true;
+                break;
             }
             else
             {
-                ALint size, bits;
-                alCheck(alGetBufferi(buffer, AL_SIZE, &size));
-                alCheck(alGetBufferi(buffer, AL_BITS, &bits));
-
-                // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
-                if (bits == 0)
-                {
-                    err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
-                          << "and initialize() has been called correctly" << std::endl;
-
-                    // Abort streaming (exit main loop)
-                    Lock lock(m_threadMutex);
-                    m_isStreaming = false;
-                    requestStop = true;
-                    break;
-                }
-                else
-                {
-                    m_samplesProcessed += size / (bits / 8);
-                }
+                m_samplesProcessed += size / (bits / 8);
             }
+        }
 
-            // Fill it and push it back into the playing queue
-            if (!requestStop)
-            {
-                if (fillAndPushBuffer(bufferNum))
-                    requestStop = true;
-            }
+        // Fill it and push it back into the playing queue
+        if (!m_requestStop)
+        {
+            if (fillAndPushBuffer(bufferNum))
+                m_requestStop = true;
         }
+    }
 
-        // Leave some time for the other threads if the stream is still playing
-        if (SoundSource::getStatus() != Stopped)
-            sleep(milliseconds(10));
+    // Schedule the next update if the stream is still playing, otherwise ask for an immediate one
+    if (SoundSource::getStatus() != Stopped)
+    {
+        delay = getRefillDelay(queued);
+    }
+    else
+    {
+        delay  = Time::Zero;
+        queued = Time::Zero;
     }
 
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::finishStreaming()
+{
     // Stop the playback
     alCheck(alSourceStop(m_source));
 
@@ -390,7 +639,7 @@ void SoundStream::streamData()
 
     // Delete the buffers
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
-    alCheck(alDeleteBuffers(BufferCount, m_buffers));
+    alCheck(alDeleteBuffers(m_activeBufferCount, m_buffers));
 }
 
 
@@ -400,8 +649,10 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
     bool requestStop = false;
 
     // Acquire audio data, also address EOF and error cases if they occur
+    Clock clock;
     Chunk data = {NULL, 0};
-    for (Uint32 retryCount = 0; !onGetData(data) && (retryCount < BufferRetries); ++retryCount)
+    FloatChunk floatData = {NULL, 0};
+    for (Uint32 retryCount = 0; !getData(data, floatData) && (retryCount < BufferRetries); ++retryCount)
     {
         // Mark the buffer as the last one (so that we know when to reset the playing position)
         m_endBuffers[bufferNum] = true;
@@ -418,7 +669,7 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
         onSeek(Time::Zero);
 
         // If we got data, break and process it, else try to fill the buffer once again
-        if (data.samples && data.sampleCount)
+        if ((data.samples && data.sampleCount) || (floatData.samples && floatData.sampleCount))
             break;
 
         // If immediateLoop is specified, we have to immediately adjust the sample count
@@ -432,17 +683,55 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
         // We're a looping sound that got no data, so we retry onGetData()
     }
 
+    // Convert floating point samples if the device doesn't support them
+    if (floatData.samples && floatData.sampleCount && !m_floatFormat)
+    {
+        m_conversionBuffer.resize(floatData.sampleCount);
+        for (std::size_t i = 0; i < floatData.sampleCount; ++i)
+        {
+            float sample = floatData.samples[i] * 32768.f;
+            sample = std::min(std::max(sample, -32768.f), 32767.f);
+            m_conversionBuffer[i] = static_cast<Int16>(sample);
+        }
+
+        data.samples      = &m_conversionBuffer[0];
+        data.sampleCount  = floatData.sampleCount;
+        floatData.samples = NULL;
+    }
+
+    // Account for the time spent in the stream source
+    Time decodeTime = clock.getElapsedTime();
+    {
+        Lock lock(m_threadMutex);
+        m_statistics.decodedChunkCount++;
+        m_statistics.decodeTime += decodeTime;
+        m_statistics.maxDecodeTime = std::max(m_statistics.maxDecodeTime, decodeTime);
+    }
+
     // Fill the buffer if some data was returned
-    if (data.samples && data.sampleCount)
+    std::size_t sampleCount = floatData.samples ? floatData.sampleCount : data.sampleCount;
+    if ((data.samples || floatData.samples) && sampleCount)
     {
         unsigned int buffer = m_buffers[bufferNum];
 
         // Fill the buffer
-        ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(Int16);
-        alCheck(alBufferData(buffer, m_format, data.samples, size, m_sampleRate));
+        if (floatData.samples)
+        {
+            ALsizei size = static_cast<ALsizei>(sampleCount) * sizeof(float);
+            alCheck(alBufferData(buffer, m_floatFormat, floatData.samples, size, m_sampleRate));
+        }
+        else
+        {
+            ALsizei size = static_cast<ALsizei>(sampleCount) * sizeof(Int16);
+            alCheck(alBufferData(buffer, m_format, data.samples, size, m_sampleRate));
+        }
 
         // Push it into the sound queue
         alCheck(alSourceQueueBuffers(m_source, 1, &buffer));
+
+        m_bufferFrames[bufferNum] = sampleCount / m_channelCount;
+        m_queue[(m_queueStart + m_queueSize) % m_activeBufferCount] = bufferNum;
+        m_queueSize++;
     }
     else
     {
@@ -454,12 +743,45 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
 }
 
 
+////////////////////////////////////////////////////////////
+bool SoundStream::getData(Chunk& data, FloatChunk& floatData)
+{
+    if (m_floatSamples)
+        return onGetFloatData(floatData);
+    else
+        return onGetData(data);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::seekStreaming(Time timeOffset)
+{
+    // Stopping the source marks all the queued buffers as processed, so they can be dequeued
+    alCheck(alSourceStop(m_source));
+    clearQueue();
+    for (unsigned int i = 0; i < m_activeBufferCount; ++i)
+        m_endBuffers[i] = false;
+
+    // Let the derived class update the current position
+    onSeek(timeOffset);
+    m_samplesProcessed = static_cast<Uint64>(timeOffset.asSeconds() * m_sampleRate * m_channelCount);
+
+    // Refill the queue and resume the playback in its current state
+    m_requestStop = fillQueue();
+    alCheck(alSourcePlay(m_source));
+
+    Lock lock(m_threadMutex);
+    if (m_threadStartState == Paused)
+        alCheck(alSourcePause(m_source));
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundStream::fillQueue()
 {
     // Fill and enqueue all the available buffers
     bool requestStop = false;
-    for (int i = 0; (i < BufferCount) && !requestStop; ++i)
+    for (unsigned int i = 0; (i < m_activeBufferCount) && !requestStop; ++i)
     {
         // Since no sound has been loaded yet, we can't schedule loop seeks preemptively,
         // So if we start on EOF or Loop End, we let fillAndPushBuffer() adjust the sample count
@@ -482,6 +804,45 @@ void SoundStream::clearQueue()
     ALuint buffer;
     for (ALint i = 0; i < nbQueued; ++i)
         alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
+
+    m_queueStart = 0;
+    m_queueSize  = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getRefillDelay(Time& queued)
+{
+    // Count the frames that are queued but not played yet; the sample offset
+    // is relative to the oldest buffer still in the queue
+    ALint offset = 0;
+    alCheck(alGetSourcei(m_source, AL_SAMPLE_OFFSET, &offset));
+
+    Uint64 queuedFrames = 0;
+    for (unsigned int i = 0; i < m_queueSize; ++i)
+        queuedFrames += m_bufferFrames[m_queue[(m_queueStart + i) % m_activeBufferCount]];
+
+    Uint64 played          = static_cast<Uint64>(std::max(offset, 0));
+    Uint64 remainingFrames = queuedFrames > played ? queuedFrames - played : 0;
+    Uint64 headFrames      = m_queueSize > 0 ? m_bufferFrames[m_queue[m_queueStart]] : 0;
+    Uint64 headRemaining   = headFrames > played ? headFrames - played : 0;
+
+    queued = microseconds(static_cast<Int64>(remainingFrames * 1000000 / m_sampleRate));
+
+    {
+        Lock lock(m_threadMutex);
+        m_statistics.queuedDuration    = queued;
+        m_statistics.queuedBufferCount = m_queueSize;
+        if ((m_statistics.minQueuedDuration < Time::Zero) || (queued < m_statistics.minQueuedDuration))
+            m_statistics.minQueuedDuration = queued;
+    }
+
+    // Wake up as soon as the oldest buffer is free, but never let more than
+    // half of the remaining audio play out before checking again
+    Uint64 waitFrames = std::min(headRemaining, remainingFrames / 2);
+    Time delay = microseconds(static_cast<Int64>(waitFrames * 1000000 / m_sampleRate));
+
+    return std::max(delay, milliseconds(1));
 }
 
 } // namespace sf
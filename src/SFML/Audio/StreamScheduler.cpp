@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/StreamScheduler.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Signal.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // The unique instance, shared by all the streams
+    sf::priv::StreamScheduler scheduler;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+struct StreamScheduler::Worker
+{
+    Worker(StreamScheduler& scheduler) :
+    owner (scheduler),
+    thread(&StreamScheduler::run, this),
+    signal()
+    {
+        thread.setPriority(Thread::Realtime);
+    }
+
+    StreamScheduler& owner;  ///< Scheduler owning the worker
+    Thread           thread; ///< Thread running StreamScheduler::run
+    Signal           signal; ///< Signal used to wake up the worker
+};
+
+
+////////////////////////////////////////////////////////////
+StreamScheduler::StreamScheduler() :
+m_mutex      (),
+m_clock      (),
+m_entries    (),
+m_workers    (),
+m_threadCount(2),
+m_exit       (false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+StreamScheduler::~StreamScheduler()
+{
+    {
+        Lock lock(m_mutex);
+        m_exit = true;
+        notifyWorkers();
+    }
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->thread.wait();
+        delete *it;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::add(SoundStream& stream)
+{
+    Lock lock(scheduler.m_mutex);
+
+    if (scheduler.find(&stream) != scheduler.m_entries.end())
+        return;
+
+    // Start the workers the first time a stream is added
+    if (scheduler.m_workers.empty())
+    {
+        for (unsigned int i = 0; i < scheduler.m_threadCount; ++i)
+        {
+            scheduler.m_workers.push_back(new Worker(scheduler));
+            scheduler.m_workers.back()->thread.launch();
+        }
+    }
+
+    // The new stream must be started right away
+    Int64 now = scheduler.m_clock.getElapsedTime().asMicroseconds();
+    Entry entry = {&stream, false, false, false, now, now};
+    scheduler.m_entries.push_back(entry);
+
+    scheduler.notifyWorkers();
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::remove(SoundStream& stream)
+{
+    for (;;)
+    {
+        {
+            Lock lock(scheduler.m_mutex);
+
+            std::vector<Entry>::iterator entry = scheduler.find(&stream);
+            if (entry == scheduler.m_entries.end())
+                return;
+
+            // A stream that no worker has touched yet can be dropped directly
+            if (!entry->started && !entry->busy)
+            {
+                scheduler.m_entries.erase(entry);
+                return;
+            }
+
+            // Otherwise let a worker tear it down as soon as possible; if a worker
+            // is updating it, make sure that it doesn't reschedule it for later
+            entry->wakeTime     = 0;
+            entry->underrunTime = 0;
+            entry->woken        = entry->busy;
+            scheduler.notifyWorkers();
+        }
+
+        // The worker notifies the stream once it has released it
+        stream.m_wakeUp.wait();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::wake(SoundStream& stream)
+{
+    Lock lock(scheduler.m_mutex);
+
+    std::vector<Entry>::iterator entry = scheduler.find(&stream);
+    if (entry == scheduler.m_entries.end())
+        return;
+
+    // If a worker is updating the stream, it will reschedule it right away when it's done
+    entry->wakeTime = 0;
+    entry->woken    = entry->busy;
+    scheduler.notifyWorkers();
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::setThreadCount(unsigned int count)
+{
+    Lock lock(scheduler.m_mutex);
+    scheduler.m_threadCount = std::max(count, 1u);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int StreamScheduler::getThreadCount()
+{
+    Lock lock(scheduler.m_mutex);
+    return scheduler.m_threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::run(Worker* worker)
+{
+    StreamScheduler& self = worker->owner;
+
+    for (;;)
+    {
+        SoundStream* stream = NULL;
+        bool started = false;
+        Int64 nextWake = -1;
+        Int64 now = 0;
+
+        // Pick the stream that is due and closest to running dry
+        {
+            Lock lock(self.m_mutex);
+
+            if (self.m_exit)
+                return;
+
+            now = self.m_clock.getElapsedTime().asMicroseconds();
+
+            std::vector<Entry>::iterator next = self.m_entries.end();
+            for (std::vector<Entry>::iterator it = self.m_entries.begin(); it != self.m_entries.end(); ++it)
+            {
+                if (it->busy)
+                    continue;
+
+                if (it->wakeTime <= now)
+                {
+                    if ((next == self.m_entries.end()) || (it->underrunTime < next->underrunTime))
+                        next = it;
+                }
+                else if ((nextWake < 0) || (it->wakeTime < nextWake))
+                {
+                    nextWake = it->wakeTime;
+                }
+            }
+
+            if (next != self.m_entries.end())
+            {
+                stream        = next->stream;
+                started       = next->started;
+                next->busy    = true;
+                next->started = true;
+            }
+        }
+
+        // Nothing to do yet: sleep until the next deadline, or until something changes
+        if (!stream)
+        {
+            if (nextWake < 0)
+                worker->signal.wait();
+            else
+                worker->signal.wait(microseconds(nextWake - now));
+
+            continue;
+        }
+
+        // Update the stream, without holding the lock
+        Time delay;
+        Time queued;
+        bool running = started || stream->startStreaming();
+        if (running)
+        {
+            running = stream->updateStream(delay, queued);
+            if (!running)
+                stream->finishStreaming();
+        }
+
+        {
+            Lock lock(self.m_mutex);
+
+            std::vector<Entry>::iterator entry = self.find(stream);
+            if (running)
+            {
+                now = self.m_clock.getElapsedTime().asMicroseconds();
+                entry->busy         = false;
+                entry->wakeTime     = entry->woken ? now : now + delay.asMicroseconds();
+                entry->underrunTime = now + queued.asMicroseconds();
+                entry->woken        = false;
+            }
+            else
+            {
+                // Notify while holding the lock: once the entry is gone,
+                // remove() may return and the stream may be destroyed
+                self.m_entries.erase(entry);
+                stream->m_wakeUp.notify();
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<StreamScheduler::Entry>::iterator StreamScheduler::find(SoundStream* stream)
+{
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->stream == stream)
+            return it;
+    }
+
+    return m_entries.end();
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::notifyWorkers()
+{
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        (*it)->signal.notify();
+}
+
+} // namespace priv
+
+} // namespace sf
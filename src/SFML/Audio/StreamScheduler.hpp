@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_STREAMSCHEDULER_HPP
+#define SFML_STREAMSCHEDULER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class SoundStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Pool of worker threads shared by all the sound
+///        streams that don't use a dedicated thread
+///
+/// Each stream is updated when its oldest buffer has been
+/// played; when several streams are due at the same time,
+/// the one that is closest to running dry goes first.
+///
+////////////////////////////////////////////////////////////
+class StreamScheduler : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    StreamScheduler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Stops and waits for the worker threads.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~StreamScheduler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start streaming a sound stream with the shared workers
+    ///
+    /// The workers are started on the first call.
+    ///
+    /// \param stream Stream to start
+    ///
+    ////////////////////////////////////////////////////////////
+    static void add(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the shared workers have released a stream
+    ///
+    /// The stream must have been requested to stop (its
+    /// m_isStreaming flag set to false) before calling this
+    /// function. Returns immediately if the stream is not
+    /// handled by the shared workers.
+    ///
+    /// \param stream Stream to release
+    ///
+    ////////////////////////////////////////////////////////////
+    static void remove(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a stream as soon as possible
+    ///
+    /// Does nothing if the stream is not handled by the shared workers.
+    ///
+    /// \param stream Stream to update
+    ///
+    ////////////////////////////////////////////////////////////
+    static void wake(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of worker threads
+    ///
+    /// Has no effect once the workers are running.
+    ///
+    /// \param count Number of worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of worker threads
+    ///
+    /// \return Number of worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getThreadCount();
+
+private:
+
+    struct Worker;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stream handled by the workers
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        SoundStream* stream;       ///< The stream
+        bool         started;      ///< Have the buffers been created and queued?
+        bool         busy;         ///< Is a worker currently updating the stream?
+        bool         woken;        ///< Was an update requested while the stream was busy?
+        Int64        wakeTime;     ///< Time of the next update, in microseconds
+        Int64        underrunTime; ///< Time at which the stream will run dry, in microseconds
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker threads
+    ///
+    /// \param worker Worker running the function
+    ///
+    ////////////////////////////////////////////////////////////
+    static void run(Worker* worker);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the entry of a stream
+    ///
+    /// \param stream Stream to look for
+    ///
+    /// \return Iterator to the entry, or m_entries.end()
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector<Entry>::iterator find(SoundStream* stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up all the workers so that they re-evaluate the deadlines
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyWorkers();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex                m_mutex;       ///< Mutex protecting the entries and workers
+    Clock                m_clock;       ///< Time reference for the deadlines
+    std::vector<Entry>   m_entries;     ///< Streams handled by the workers
+    std::vector<Worker*> m_workers;     ///< Worker threads
+    unsigned int         m_threadCount; ///< Number of workers to start
+    bool                 m_exit;        ///< Have the workers been requested to exit?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_STREAMSCHEDULER_HPP
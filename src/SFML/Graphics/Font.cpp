@@ -32,6 +32,7 @@
 #endif
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Profiler.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
@@ -518,6 +519,9 @@ void Font::cleanup()
 ////////////////////////////////////////////////////////////
 Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
+    SFML_PROFILE_ZONE("Font::loadGlyph");
+    SFML_PROFILE_COUNTER("Glyph cache misses", 1);
+
     // The glyph to return
     Glyph glyph;
 
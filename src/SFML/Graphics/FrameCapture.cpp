@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FrameCapture.hpp>
+#include <SFML/Graphics/FramebufferCache.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Window/Window.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct FrameCapture::Slot
+{
+    Slot() :
+    texture(),
+    pending(false)
+    {
+    }
+
+    Texture texture; ///< Copy of the captured frame
+    bool    pending; ///< Does the slot contain a frame not delivered yet?
+};
+
+
+////////////////////////////////////////////////////////////
+FrameCapture::FrameCapture() :
+m_slots   (),
+m_next    (0),
+m_pixels  (),
+m_callback(NULL),
+m_userData(NULL)
+{
+    setLatency(2);
+}
+
+
+////////////////////////////////////////////////////////////
+FrameCapture::~FrameCapture()
+{
+    for (std::vector<Slot*>::iterator it = m_slots.begin(); it != m_slots.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameCapture::setCallback(Callback callback, void* userData)
+{
+    m_callback = callback;
+    m_userData = userData;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameCapture::setLatency(std::size_t frames)
+{
+    flush();
+
+    for (std::vector<Slot*>::iterator it = m_slots.begin(); it != m_slots.end(); ++it)
+        delete *it;
+
+    // The frame captured in a slot is delivered when all the other slots have been written
+    m_slots.resize(frames + 1);
+    for (std::vector<Slot*>::iterator it = m_slots.begin(); it != m_slots.end(); ++it)
+        *it = new Slot;
+
+    m_next = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FrameCapture::getLatency() const
+{
+    return m_slots.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameCapture::capture(const Window& window)
+{
+    SFML_PROFILE_ZONE("FrameCapture::capture");
+
+    Slot& slot = *m_slots[m_next];
+
+    // Adapt the texture to the size of the window
+    Vector2u size = window.getSize();
+    if ((slot.texture.getSize() != size) && !slot.texture.create(size.x, size.y))
+        return false;
+
+    // Copy the back buffer, this only queues a copy on the GPU
+    slot.texture.update(window);
+    slot.pending = true;
+
+    m_next = (m_next + 1) % m_slots.size();
+
+    // The next slot contains the oldest frame, captured latency frames ago
+    if (m_slots[m_next]->pending)
+        deliver(*m_slots[m_next]);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameCapture::flush()
+{
+    // Deliver the frames from the oldest to the most recent
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        Slot& slot = *m_slots[(m_next + i) % m_slots.size()];
+        if (slot.pending)
+            deliver(slot);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FrameCapture::getPendingCount() const
+{
+    std::size_t count = 0;
+    for (std::vector<Slot*>::const_iterator it = m_slots.begin(); it != m_slots.end(); ++it)
+    {
+        if ((*it)->pending)
+            ++count;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameCapture::deliver(Slot& slot)
+{
+    SFML_PROFILE_ZONE("FrameCapture::deliver");
+
+    slot.pending = false;
+
+    Vector2u size = slot.texture.getSize();
+    m_pixels.resize(size.x * size.y * 4);
+
+    // The copy of the back buffer is stored bottom-up
+    bool success;
+    {
+        TransientContextLock lock;
+        success = priv::readTexturePixels(slot.texture.getNativeHandle(), size.x, size.y, true, &m_pixels[0]);
+    }
+
+    // Without framebuffers, let the texture read itself back
+    if (!success)
+    {
+        Image image = slot.texture.copyToImage();
+        std::memcpy(&m_pixels[0], image.getPixelsPtr(), m_pixels.size());
+    }
+
+    if (m_callback)
+        m_callback(&m_pixels[0], size.x, size.y, m_userData);
+}
+
+} // namespace sf
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FramebufferCache.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <map>
+
+
+namespace
+{
+    // Framebuffer of each context, indexed by context identifier; never destroyed,
+    // since contexts may still be destroyed during static destruction
+    sf::Mutex&                    mutex        = *new sf::Mutex;
+    std::map<sf::Uint64, GLuint>& framebuffers = *new std::map<sf::Uint64, GLuint>;
+
+    // Has removeFramebuffer been registered? Protected by its own mutex
+    sf::Mutex                     callbackMutex;
+    bool                          callbackRegistered = false;
+
+    // Forget the framebuffer of a destroyed context; the framebuffer
+    // itself was destroyed with the context, which doesn't share it
+    void removeFramebuffer(sf::Uint64 contextId, void*)
+    {
+        sf::Lock lock(mutex);
+        framebuffers.erase(contextId);
+    }
+
+    // Gives access to the context destruction callbacks of sf::GlResource
+    struct ContextObserver : sf::GlResource
+    {
+        static void registerCallback()
+        {
+            registerContextDestroyCallback(&removeFramebuffer, NULL);
+        }
+    };
+
+    // Get the framebuffer of the active context, creating it if needed
+    GLuint getFramebuffer()
+    {
+        sf::Uint64 contextId = sf::Context::getActiveContextId();
+        if (contextId == 0)
+            return 0;
+
+        // The callback is called with the internal lock of the contexts held, and
+        // locks the mutex, so it must not be registered while holding the mutex
+        {
+            sf::Lock lock(callbackMutex);
+            if (!callbackRegistered)
+            {
+                ContextObserver::registerCallback();
+                callbackRegistered = true;
+            }
+        }
+
+        sf::Lock lock(mutex);
+
+        std::map<sf::Uint64, GLuint>::const_iterator it = framebuffers.find(contextId);
+        if (it != framebuffers.end())
+            return it->second;
+
+        GLuint framebuffer = 0;
+        glCheck(GLEXT_glGenFramebuffers(1, &framebuffer));
+        if (framebuffer)
+            framebuffers[contextId] = framebuffer;
+
+        return framebuffer;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool readTexturePixels(unsigned int texture, unsigned int width, unsigned int height, bool flipped, Uint8* pixels)
+{
+    ensureExtensionsInit();
+
+    if (!GLEXT_framebuffer_object)
+        return false;
+
+    GLuint framebuffer = getFramebuffer();
+    if (!framebuffer)
+        return false;
+
+    GLint previousFramebuffer;
+    glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &previousFramebuffer));
+
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, framebuffer));
+    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0));
+    glCheck(glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+
+    // Detach the texture, so that the framebuffer doesn't keep it alive
+    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0));
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFramebuffer));
+
+    // Put the rows back in top-down order
+    if (flipped)
+    {
+        std::size_t pitch = width * 4;
+        for (unsigned int i = 0; i < height / 2; ++i)
+            std::swap_ranges(pixels + i * pitch, pixels + (i + 1) * pitch, pixels + (height - 1 - i) * pitch);
+    }
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FRAMEBUFFERCACHE_HPP
+#define SFML_FRAMEBUFFERCACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Read the pixels of a texture back through a framebuffer
+///
+/// The texture is attached to a framebuffer object owned by
+/// the active context. OpenGL can't share framebuffers between
+/// contexts, so each context gets its own, created the first
+/// time it is needed and then reused by all the reads; it is
+/// forgotten when the context is destroyed.
+/// The current framebuffer binding is preserved.
+///
+/// \param texture OpenGL name of the texture to read
+/// \param width   Width of the area to read, from the origin of the texture
+/// \param height  Height of the area to read, from the origin of the texture
+/// \param flipped Are the rows of the texture stored bottom-up?
+/// \param pixels  Array of width * height * 4 bytes receiving the RGBA pixels
+///
+/// \return True on success, false if framebuffers are not supported
+///
+////////////////////////////////////////////////////////////
+bool readTexturePixels(unsigned int texture, unsigned int width, unsigned int height, bool flipped, Uint8* pixels);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_FRAMEBUFFERCACHE_HPP
@@ -143,6 +143,14 @@
         #define GLEXT_GL_SRGB8_ALPHA8                     0
     #endif
 
+    // Core since 3.0 - OES_element_index_uint
+    #ifdef GL_OES_element_index_uint
+        #define GLEXT_element_index_uint                  GL_OES_element_index_uint
+    #else
+        #define GLEXT_element_index_uint                  false
+    #endif
+    #define GLEXT_GL_UNSIGNED_INT                     0x1405
+
 #else
 
     #include <SFML/Graphics/GLLoader.hpp>
@@ -154,6 +162,8 @@
     // Core since 1.1
     #define GLEXT_GL_DEPTH_COMPONENT                  GL_DEPTH_COMPONENT
     #define GLEXT_GL_CLAMP                            GL_CLAMP
+    #define GLEXT_element_index_uint                  true
+    #define GLEXT_GL_UNSIGNED_INT                     GL_UNSIGNED_INT
 
     // The following extensions are listed chronologically
     // Extension macro first, followed by tokens then
@@ -26,15 +26,201 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageThreadPool.hpp>
 #include <SFML/System/Err.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 
 
+namespace
+{
+    // Fixed point weights of a resampling pass along one axis
+    struct Contributions
+    {
+        std::size_t               tapCount; ///< Number of source pixels contributing to each destination pixel
+        std::vector<unsigned int> starts;   ///< First contributing source pixel of each destination pixel
+        std::vector<sf::Int16>    weights;  ///< tapCount weights per destination pixel
+    };
+
+    // Precision of the fixed point weights, must match ImageKernels
+    const int weightOne = 1 << 14;
+
+    float boxFilter(float x)
+    {
+        return ((x > -0.5f) && (x <= 0.5f)) ? 1.f : 0.f;
+    }
+
+    float triangleFilter(float x)
+    {
+        x = std::fabs(x);
+        return (x < 1.f) ? 1.f - x : 0.f;
+    }
+
+    float sinc(float x)
+    {
+        if (x == 0.f)
+            return 1.f;
+
+        x *= 3.141592654f;
+        return std::sin(x) / x;
+    }
+
+    float lanczosFilter(float x)
+    {
+        return ((x > -3.f) && (x < 3.f)) ? sinc(x) * sinc(x / 3.f) : 0.f;
+    }
+
+    // Compute the weights of the source pixels for each destination pixel
+    void computeContributions(unsigned int sourceSize, unsigned int destinationSize, sf::Image::ResampleFilter filter, Contributions& contributions)
+    {
+        float (*function)(float) = &triangleFilter;
+        float radius = 1.f;
+        switch (filter)
+        {
+            case sf::Image::Box:      function = &boxFilter;     radius = 0.5f; break;
+            case sf::Image::Bilinear: function = &triangleFilter; radius = 1.f; break;
+            case sf::Image::Lanczos:  function = &lanczosFilter; radius = 3.f;  break;
+        }
+
+        // When shrinking, the filter is stretched to cover all the source pixels
+        float scale = static_cast<float>(sourceSize) / destinationSize;
+        float filterScale = std::max(scale, 1.f);
+        float support = radius * filterScale;
+
+        std::vector<int> firsts(destinationSize);
+        std::vector<int> counts(destinationSize);
+        std::size_t tapCount = 1;
+        for (unsigned int i = 0; i < destinationSize; ++i)
+        {
+            float center = (i + 0.5f) * scale;
+            int first = std::max(static_cast<int>(center - support + 0.5f), 0);
+            int last = std::min(static_cast<int>(center + support + 0.5f), static_cast<int>(sourceSize));
+            firsts[i] = first;
+            counts[i] = std::max(last - first, 1);
+            tapCount = std::max(tapCount, static_cast<std::size_t>(counts[i]));
+        }
+
+        // All the destination pixels use the same number of taps, so that the kernels don't
+        // need per-pixel bounds; the pixels close to the right edge start earlier and get
+        // null weights on their left
+        contributions.tapCount = tapCount;
+        contributions.starts.resize(destinationSize);
+        contributions.weights.assign(destinationSize * tapCount, 0);
+
+        std::vector<float> weights(tapCount);
+        for (unsigned int i = 0; i < destinationSize; ++i)
+        {
+            float center = (i + 0.5f) * scale;
+            int first = std::min(firsts[i], static_cast<int>(sourceSize) - counts[i]);
+            int offset = std::min(first, static_cast<int>(sourceSize - tapCount));
+
+            float total = 0.f;
+            for (int k = 0; k < counts[i]; ++k)
+            {
+                weights[k] = function((first + k + 0.5f - center) / filterScale);
+                total += weights[k];
+            }
+
+            // Convert the normalized weights to fixed point, and give the rounding error to the
+            // largest one so that the weights always sum to exactly 1 (flat areas stay flat)
+            sf::Int16* fixed = &contributions.weights[i * tapCount + (first - offset)];
+            int sum = 0;
+            int largest = 0;
+            for (int k = 0; k < counts[i]; ++k)
+            {
+                float weight = (total != 0.f) ? weights[k] / total : (k == 0 ? 1.f : 0.f);
+                fixed[k] = static_cast<sf::Int16>(std::floor(weight * weightOne + 0.5f));
+                sum += fixed[k];
+                if (fixed[k] > fixed[largest])
+                    largest = k;
+            }
+            fixed[largest] = static_cast<sf::Int16>(fixed[largest] + weightOne - sum);
+
+            contributions.starts[i] = static_cast<unsigned int>(offset);
+        }
+    }
+
+    // Shared data of the rows resampled in parallel
+    struct ResampleJob
+    {
+        const sf::priv::ImageKernels* kernels;
+        const sf::Uint8*              source;
+        sf::Uint8*                    destination;
+        std::size_t                   sourceStride;
+        std::size_t                   destinationStride;
+        unsigned int                  width;
+        const Contributions*          contributions;
+    };
+
+    void resampleRowsHorizontally(void* data, unsigned int begin, unsigned int end)
+    {
+        const ResampleJob& job = *static_cast<const ResampleJob*>(data);
+        const Contributions& contributions = *job.contributions;
+
+        for (unsigned int y = begin; y < end; ++y)
+        {
+            job.kernels->resampleHorizontal(job.source + y * job.sourceStride, job.destination + y * job.destinationStride, job.width,
+                                            &contributions.starts[0], &contributions.weights[0], contributions.tapCount);
+        }
+    }
+
+    void resampleRowsVertically(void* data, unsigned int begin, unsigned int end)
+    {
+        const ResampleJob& job = *static_cast<const ResampleJob*>(data);
+        const Contributions& contributions = *job.contributions;
+
+        for (unsigned int y = begin; y < end; ++y)
+        {
+            job.kernels->resampleVertical(job.source + contributions.starts[y] * job.sourceStride, job.sourceStride,
+                                          &contributions.weights[y * contributions.tapCount], contributions.tapCount,
+                                          job.destination + y * job.destinationStride, job.width * 4);
+        }
+    }
+
+    // Resample premultiplied pixels, with a horizontal pass followed by a vertical one
+    void resample(const std::vector<sf::Uint8>& source, const sf::Vector2u& sourceSize,
+                  std::vector<sf::Uint8>& destination, const sf::Vector2u& destinationSize,
+                  sf::Image::ResampleFilter filter)
+    {
+        const sf::priv::ImageKernels& kernels = sf::priv::getImageKernels();
+        Contributions contributions;
+
+        // Horizontal pass
+        std::vector<sf::Uint8> buffer;
+        const std::vector<sf::Uint8>* columns = &source;
+        if (destinationSize.x != sourceSize.x)
+        {
+            computeContributions(sourceSize.x, destinationSize.x, filter, contributions);
+            buffer.resize(destinationSize.x * sourceSize.y * 4);
+
+            ResampleJob job = {&kernels, &source[0], &buffer[0], sourceSize.x * 4, destinationSize.x * 4, destinationSize.x, &contributions};
+            sf::priv::ImageThreadPool::run(&resampleRowsHorizontally, &job, sourceSize.y);
+            columns = &buffer;
+        }
+
+        // Vertical pass
+        if (destinationSize.y != sourceSize.y)
+        {
+            computeContributions(sourceSize.y, destinationSize.y, filter, contributions);
+            destination.resize(destinationSize.x * destinationSize.y * 4);
+
+            ResampleJob job = {&kernels, &(*columns)[0], &destination[0], destinationSize.x * 4, destinationSize.x * 4, destinationSize.x, &contributions};
+            sf::priv::ImageThreadPool::run(&resampleRowsVertically, &job, destinationSize.y);
+        }
+        else
+        {
+            destination = *columns;
+        }
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -70,15 +256,8 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
         std::vector<Uint8> newPixels(width * height * 4);
     
         // Fill it with the specified color
-        Uint8* ptr = &newPixels[0];
-        Uint8* end = ptr + newPixels.size();
-        while (ptr < end)
-        {
-            *ptr++ = color.r;
-            *ptr++ = color.g;
-            *ptr++ = color.b;
-            *ptr++ = color.a;
-        }
+        const Uint8 components[] = {color.r, color.g, color.b, color.a};
+        priv::getImageKernels().fill(&newPixels[0], width * height, components);
     
         // Commit the new pixel buffer
         m_pixels.swap(newPixels);
@@ -126,6 +305,52 @@ void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
 }
 
 
+////////////////////////////////////////////////////////////
+void Image::createFromBgra(unsigned int width, unsigned int height, const Uint8* pixels)
+{
+    if (pixels && width && height)
+    {
+        // Create a new pixel buffer first for exception safety's sake
+        std::vector<Uint8> newPixels(width * height * 4);
+        priv::getImageKernels().swapRedBlue(pixels, &newPixels[0], width * height);
+
+        // Commit the new pixel buffer
+        m_pixels.swap(newPixels);
+
+        // Assign the new size
+        m_size.x = width;
+        m_size.y = height;
+    }
+    else
+    {
+        create(0, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::createFromRgb565(unsigned int width, unsigned int height, const Uint16* pixels)
+{
+    if (pixels && width && height)
+    {
+        // Create a new pixel buffer first for exception safety's sake
+        std::vector<Uint8> newPixels(width * height * 4);
+        priv::getImageKernels().fromRgb565(pixels, &newPixels[0], width * height);
+
+        // Commit the new pixel buffer
+        m_pixels.swap(newPixels);
+
+        // Assign the new size
+        m_size.x = width;
+        m_size.y = height;
+    }
+    else
+    {
+        create(0, 0);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Image::loadFromFile(const std::string& filename)
 {
@@ -180,14 +405,8 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
     if (!m_pixels.empty())
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        const Uint8 components[] = {color.r, color.g, color.b, color.a};
+        priv::getImageKernels().mask(&m_pixels[0], m_pixels.size() / 4, components, alpha);
     }
 }
 
@@ -237,23 +456,11 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Interpolation using alpha values, row by row (slower)
+        const priv::ImageKernels& kernels = priv::getImageKernels();
         for (int i = 0; i < rows; ++i)
         {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
-
+            kernels.blend(srcPixels, dstPixels, width);
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
@@ -311,20 +518,10 @@ void Image::flipHorizontally()
     if (!m_pixels.empty())
     {
         std::size_t rowSize = m_size.x * 4;
+        const priv::ImageKernels& kernels = priv::getImageKernels();
 
         for (std::size_t y = 0; y < m_size.y; ++y)
-        {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
-
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
-
-                left += 4;
-                right -= 4;
-            }
-        }
+            kernels.reverse(&m_pixels[y * rowSize], m_size.x);
     }
 }
 
@@ -336,12 +533,16 @@ void Image::flipVertically()
     {
         std::size_t rowSize = m_size.x * 4;
 
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        // Swap the rows through a temporary row, memcpy is much faster than a byte by byte swap
+        std::vector<Uint8> row(rowSize);
+        Uint8* top = &m_pixels[0];
+        Uint8* bottom = &m_pixels[0] + m_pixels.size() - rowSize;
 
         for (std::size_t y = 0; y < m_size.y / 2; ++y)
         {
-            std::swap_ranges(top, top + rowSize, bottom);
+            std::memcpy(&row[0], top, rowSize);
+            std::memcpy(top, bottom, rowSize);
+            std::memcpy(bottom, &row[0], rowSize);
 
             top += rowSize;
             bottom -= rowSize;
@@ -349,4 +550,115 @@ void Image::flipVertically()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Image::premultiplyAlpha()
+{
+    if (!m_pixels.empty())
+        priv::getImageKernels().premultiply(&m_pixels[0], m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::unpremultiplyAlpha()
+{
+    if (!m_pixels.empty())
+        priv::getImageKernels().unpremultiply(&m_pixels[0], m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::copyToBgra(Uint8* pixels) const
+{
+    if (pixels && !m_pixels.empty())
+        priv::getImageKernels().swapRedBlue(&m_pixels[0], pixels, m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::copyToRgb565(Uint16* pixels) const
+{
+    if (pixels && !m_pixels.empty())
+        priv::getImageKernels().toRgb565(&m_pixels[0], pixels, m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::resize(unsigned int width, unsigned int height, ResampleFilter filter)
+{
+    if (!width || !height)
+    {
+        create(0, 0);
+        return;
+    }
+
+    if (m_pixels.empty() || ((width == m_size.x) && (height == m_size.y)))
+        return;
+
+    const priv::ImageKernels& kernels = priv::getImageKernels();
+
+    // Filter premultiplied colors, so that transparent pixels don't bleed into the others
+    std::vector<Uint8> source(m_pixels);
+    kernels.premultiply(&source[0], source.size() / 4);
+
+    std::vector<Uint8> newPixels;
+    resample(source, m_size, newPixels, Vector2u(width, height), filter);
+    kernels.unpremultiply(&newPixels[0], newPixels.size() / 4);
+
+    m_pixels.swap(newPixels);
+    m_size.x = width;
+    m_size.y = height;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::buildMipChain(std::vector<Image>& levels, ResampleFilter filter) const
+{
+    levels.clear();
+    if (m_pixels.empty())
+        return;
+
+    // Count the levels first, so that the vector is allocated only once
+    std::size_t count = 0;
+    for (Vector2u size = m_size; (size.x > 1) || (size.y > 1); size = Vector2u(std::max(size.x / 2, 1u), std::max(size.y / 2, 1u)))
+        ++count;
+    levels.resize(count);
+
+    const priv::ImageKernels& kernels = priv::getImageKernels();
+
+    // Each level is computed from the previous one; they all stay premultiplied until
+    // the end, so that the precision is lost only once
+    std::vector<Uint8> source(m_pixels);
+    kernels.premultiply(&source[0], source.size() / 4);
+
+    const std::vector<Uint8>* previousPixels = &source;
+    Vector2u previousSize = m_size;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Image& level = levels[i];
+        level.m_size = Vector2u(std::max(previousSize.x / 2, 1u), std::max(previousSize.y / 2, 1u));
+        resample(*previousPixels, previousSize, level.m_pixels, level.m_size, filter);
+
+        previousPixels = &level.m_pixels;
+        previousSize = level.m_size;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+        kernels.unpremultiply(&levels[i].m_pixels[0], levels[i].m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::setThreadCount(unsigned int count)
+{
+    priv::ImageThreadPool::setThreadCount(count);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Image::getThreadCount()
+{
+    return priv::ImageThreadPool::getThreadCount();
+}
+
 } // namespace sf
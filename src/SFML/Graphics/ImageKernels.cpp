@@ -0,0 +1,800 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    // Compile the SSE2 kernels even if the rest of the library doesn't
+    // target SSE2, they are only selected if the CPU supports them
+    #include <emmintrin.h>
+    #define SFML_IMAGE_SSE2 __attribute__((target("sse2")))
+#elif defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_IMAGE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_IMAGE_NEON
+#endif
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Scalar kernels, used on any CPU and for the pixels left
+    // over by the SIMD kernels
+    ////////////////////////////////////////////////////////////
+
+    // Round x / 255 to the nearest integer, for x in [0, 255 * 255]
+    inline sf::Uint8 roundDivide255(unsigned int x)
+    {
+        x += 128;
+        return static_cast<sf::Uint8>((x + (x >> 8)) >> 8);
+    }
+
+    void fillScalar(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            *pixels++ = color[0];
+            *pixels++ = color[1];
+            *pixels++ = color[2];
+            *pixels++ = color[3];
+        }
+    }
+
+    void blendScalar(const sf::Uint8* source, sf::Uint8* destination, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const sf::Uint8* src = source + i * 4;
+            sf::Uint8*       dst = destination + i * 4;
+
+            // Interpolate RGBA components using the alpha value of the source pixel
+            sf::Uint8 alpha = src[3];
+            dst[0] = static_cast<sf::Uint8>((src[0] * alpha + dst[0] * (255 - alpha)) / 255);
+            dst[1] = static_cast<sf::Uint8>((src[1] * alpha + dst[1] * (255 - alpha)) / 255);
+            dst[2] = static_cast<sf::Uint8>((src[2] * alpha + dst[2] * (255 - alpha)) / 255);
+            dst[3] = static_cast<sf::Uint8>(alpha + dst[3] * (255 - alpha) / 255);
+        }
+    }
+
+    void maskScalar(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color, sf::Uint8 alpha)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if ((pixels[0] == color[0]) && (pixels[1] == color[1]) && (pixels[2] == color[2]) && (pixels[3] == color[3]))
+                pixels[3] = alpha;
+            pixels += 4;
+        }
+    }
+
+    void reverseScalar(sf::Uint8* pixels, std::size_t count)
+    {
+        sf::Uint8* left = pixels;
+        sf::Uint8* right = pixels + count * 4;
+        while (right - left >= 8)
+        {
+            right -= 4;
+            std::swap_ranges(left, left + 4, right);
+            left += 4;
+        }
+    }
+
+    void premultiplyScalar(sf::Uint8* pixels, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            unsigned int alpha = pixels[3];
+            pixels[0] = roundDivide255(pixels[0] * alpha);
+            pixels[1] = roundDivide255(pixels[1] * alpha);
+            pixels[2] = roundDivide255(pixels[2] * alpha);
+            pixels += 4;
+        }
+    }
+
+    void unpremultiplyScalar(sf::Uint8* pixels, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            unsigned int alpha = pixels[3];
+            if (alpha == 0)
+            {
+                pixels[0] = 0;
+                pixels[1] = 0;
+                pixels[2] = 0;
+            }
+            else if (alpha < 255)
+            {
+                for (int j = 0; j < 3; ++j)
+                    pixels[j] = static_cast<sf::Uint8>(std::min((pixels[j] * 255 + alpha / 2) / alpha, 255u));
+            }
+            pixels += 4;
+        }
+    }
+
+    void swapRedBlueScalar(const sf::Uint8* source, sf::Uint8* destination, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Uint8 red = source[0];
+            destination[0] = source[2];
+            destination[1] = source[1];
+            destination[2] = red;
+            destination[3] = source[3];
+            source += 4;
+            destination += 4;
+        }
+    }
+
+    void toRgb565Scalar(const sf::Uint8* source, sf::Uint16* destination, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            destination[i] = static_cast<sf::Uint16>(((source[0] >> 3) << 11) | ((source[1] >> 2) << 5) | (source[2] >> 3));
+            source += 4;
+        }
+    }
+
+    void fromRgb565Scalar(const sf::Uint16* source, sf::Uint8* destination, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // Replicate the high bits into the low bits, so that 0 maps to 0 and the maximum to 255
+            unsigned int red   = source[i] >> 11;
+            unsigned int green = (source[i] >> 5) & 0x3F;
+            unsigned int blue  = source[i] & 0x1F;
+            *destination++ = static_cast<sf::Uint8>((red << 3) | (red >> 2));
+            *destination++ = static_cast<sf::Uint8>((green << 2) | (green >> 4));
+            *destination++ = static_cast<sf::Uint8>((blue << 3) | (blue >> 2));
+            *destination++ = 255;
+        }
+    }
+
+    // Convert 4 RGBA components to a 32-bit word having the same memory representation
+    sf::Uint32 toWord(const sf::Uint8* color)
+    {
+        sf::Uint32 word;
+        std::memcpy(&word, color, sizeof(word));
+        return word;
+    }
+
+    // Precision of the resampling weights
+    const int weightBits = 14;
+
+    // Convert a sum of weighted components back to a component
+    inline sf::Uint8 toComponent(int sum)
+    {
+        sum >>= weightBits;
+        return static_cast<sf::Uint8>(sum < 0 ? 0 : (sum > 255 ? 255 : sum));
+    }
+
+    void resampleHorizontalScalar(const sf::Uint8* source, sf::Uint8* destination, std::size_t count,
+                                  const unsigned int* starts, const sf::Int16* weights, std::size_t tapCount)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const sf::Uint8* src = source + starts[i] * 4;
+            const sf::Int16* weight = weights + i * tapCount;
+
+            int sums[4] = {1 << (weightBits - 1), 1 << (weightBits - 1), 1 << (weightBits - 1), 1 << (weightBits - 1)};
+            for (std::size_t k = 0; k < tapCount; ++k)
+            {
+                for (int j = 0; j < 4; ++j)
+                    sums[j] += src[k * 4 + j] * weight[k];
+            }
+
+            for (int j = 0; j < 4; ++j)
+                *destination++ = toComponent(sums[j]);
+        }
+    }
+
+    void resampleVerticalScalar(const sf::Uint8* source, std::size_t stride, const sf::Int16* weights, std::size_t tapCount,
+                                sf::Uint8* destination, std::size_t byteCount)
+    {
+        for (std::size_t i = 0; i < byteCount; ++i)
+        {
+            int sum = 1 << (weightBits - 1);
+            for (std::size_t k = 0; k < tapCount; ++k)
+                sum += source[k * stride + i] * weights[k];
+
+            destination[i] = toComponent(sum);
+        }
+    }
+
+#if defined(SFML_IMAGE_SSE2)
+
+    ////////////////////////////////////////////////////////////
+    // SSE2 kernels: 4 pixels per register; the components
+    // are widened to 16 bits for the multiplications
+    ////////////////////////////////////////////////////////////
+
+    // Broadcast the alpha of the 2 widened pixels of a register to their 4 components
+    SFML_IMAGE_SSE2 inline __m128i broadcastAlpha(__m128i pixels)
+    {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    SFML_IMAGE_SSE2 inline __m128i blendSse2(__m128i source, __m128i destination)
+    {
+        const __m128i colorMask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+        const __m128i alphaMask = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+
+        // Same formula as the scalar version: the alpha lane only keeps the destination term,
+        // and the source alpha is added after the division
+        __m128i alpha = broadcastAlpha(source);
+        __m128i x = _mm_add_epi16(_mm_mullo_epi16(source, _mm_and_si128(alpha, colorMask)),
+                                  _mm_mullo_epi16(destination, _mm_sub_epi16(_mm_set1_epi16(255), alpha)));
+
+        // x / 255, rounded down, is exactly (x + 1 + ((x + 1) >> 8)) >> 8
+        x = _mm_add_epi16(x, _mm_set1_epi16(1));
+        x = _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+
+        return _mm_add_epi16(x, _mm_and_si128(source, alphaMask));
+    }
+
+    SFML_IMAGE_SSE2 inline __m128i premultiplySse2(__m128i pixels)
+    {
+        const __m128i colorMask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+        const __m128i alphaFactor = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+
+        // The alpha lane is multiplied by 255, so that it is left unchanged by the division
+        __m128i factor = _mm_or_si128(_mm_and_si128(broadcastAlpha(pixels), colorMask), alphaFactor);
+        __m128i x = _mm_add_epi16(_mm_mullo_epi16(pixels, factor), _mm_set1_epi16(128));
+
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    SFML_IMAGE_SSE2 inline __m128i toRgb565Sse2(__m128i pixels)
+    {
+        // Little endian words: red in bits 0-7, green in 8-15, blue in 16-23
+        __m128i red   = _mm_slli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0x0000F8)), 8);
+        __m128i green = _mm_srli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0x00FC00)), 5);
+        __m128i blue  = _mm_srli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0xF80000)), 19);
+        __m128i rgb = _mm_or_si128(_mm_or_si128(red, green), blue);
+
+        // Sign-extend the 16-bit values so that the signed saturating pack keeps them unchanged
+        return _mm_srai_epi32(_mm_slli_epi32(rgb, 16), 16);
+    }
+
+    SFML_IMAGE_SSE2 inline __m128i fromRgb565Sse2(__m128i pixels)
+    {
+        __m128i red   = _mm_srli_epi32(pixels, 11);
+        __m128i green = _mm_and_si128(_mm_srli_epi32(pixels, 5), _mm_set1_epi32(0x3F));
+        __m128i blue  = _mm_and_si128(pixels, _mm_set1_epi32(0x1F));
+
+        red   = _mm_or_si128(_mm_slli_epi32(red, 3), _mm_srli_epi32(red, 2));
+        green = _mm_or_si128(_mm_slli_epi32(green, 2), _mm_srli_epi32(green, 4));
+        blue  = _mm_or_si128(_mm_slli_epi32(blue, 3), _mm_srli_epi32(blue, 2));
+
+        return _mm_or_si128(_mm_or_si128(red, _mm_slli_epi32(green, 8)),
+                            _mm_or_si128(_mm_slli_epi32(blue, 16), _mm_set1_epi32(static_cast<int>(0xFF000000u))));
+    }
+
+    SFML_IMAGE_SSE2 void fillSimd(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color)
+    {
+        const __m128i value = _mm_set1_epi32(static_cast<int>(toWord(color)));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), value);
+
+        fillScalar(pixels + i * 4, count - i, color);
+    }
+
+    SFML_IMAGE_SSE2 void blendSimd(const sf::Uint8* source, sf::Uint8* destination, std::size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+            __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i * 4));
+            __m128i low  = blendSse2(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero));
+            __m128i high = blendSse2(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_packus_epi16(low, high));
+        }
+
+        blendScalar(source + i * 4, destination + i * 4, count - i);
+    }
+
+    SFML_IMAGE_SSE2 void maskSimd(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color, sf::Uint8 alpha)
+    {
+        const sf::Uint8 alphaBytes[] = {0, 0, 0, alpha};
+        const sf::Uint8 alphaMaskBytes[] = {0, 0, 0, 255};
+        const __m128i key = _mm_set1_epi32(static_cast<int>(toWord(color)));
+        const __m128i alphaValue = _mm_set1_epi32(static_cast<int>(toWord(alphaBytes)));
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(toWord(alphaMaskBytes)));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i* ptr = reinterpret_cast<__m128i*>(pixels + i * 4);
+            __m128i value = _mm_loadu_si128(ptr);
+            __m128i replaced = _mm_and_si128(_mm_cmpeq_epi32(value, key), alphaMask);
+            _mm_storeu_si128(ptr, _mm_or_si128(_mm_andnot_si128(replaced, value), _mm_and_si128(replaced, alphaValue)));
+        }
+
+        maskScalar(pixels + i * 4, count - i, color, alpha);
+    }
+
+    SFML_IMAGE_SSE2 void reverseSimd(sf::Uint8* pixels, std::size_t count)
+    {
+        // Swap blocks of 4 pixels from both ends, then reverse what is left in the middle
+        sf::Uint8* left = pixels;
+        sf::Uint8* right = pixels + count * 4;
+        while (right - left >= 32)
+        {
+            right -= 16;
+            __m128i leftValue = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+            __m128i rightValue = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(left), _mm_shuffle_epi32(rightValue, _MM_SHUFFLE(0, 1, 2, 3)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(right), _mm_shuffle_epi32(leftValue, _MM_SHUFFLE(0, 1, 2, 3)));
+            left += 16;
+        }
+
+        reverseScalar(left, static_cast<std::size_t>(right - left) / 4);
+    }
+
+    SFML_IMAGE_SSE2 void premultiplySimd(sf::Uint8* pixels, std::size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i* ptr = reinterpret_cast<__m128i*>(pixels + i * 4);
+            __m128i value = _mm_loadu_si128(ptr);
+            __m128i low  = premultiplySse2(_mm_unpacklo_epi8(value, zero));
+            __m128i high = premultiplySse2(_mm_unpackhi_epi8(value, zero));
+            _mm_storeu_si128(ptr, _mm_packus_epi16(low, high));
+        }
+
+        premultiplyScalar(pixels + i * 4, count - i);
+    }
+
+    SFML_IMAGE_SSE2 void swapRedBlueSimd(const sf::Uint8* source, sf::Uint8* destination, std::size_t count)
+    {
+        const __m128i redBlueMask = _mm_set1_epi32(0x00FF00FF);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+            __m128i redBlue = _mm_and_si128(value, redBlueMask);
+            __m128i swapped = _mm_or_si128(_mm_slli_epi32(redBlue, 16), _mm_srli_epi32(redBlue, 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_or_si128(_mm_andnot_si128(redBlueMask, value), swapped));
+        }
+
+        swapRedBlueScalar(source + i * 4, destination + i * 4, count - i);
+    }
+
+    SFML_IMAGE_SSE2 void toRgb565Simd(const sf::Uint8* source, sf::Uint16* destination, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i low  = toRgb565Sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4)));
+            __m128i high = toRgb565Sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4 + 16)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packs_epi32(low, high));
+        }
+
+        toRgb565Scalar(source + i * 4, destination + i, count - i);
+    }
+
+    SFML_IMAGE_SSE2 void fromRgb565Simd(const sf::Uint16* source, sf::Uint8* destination, std::size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), fromRgb565Sse2(_mm_unpacklo_epi16(value, zero)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4 + 16), fromRgb565Sse2(_mm_unpackhi_epi16(value, zero)));
+        }
+
+        fromRgb565Scalar(source + i, destination + i * 4, count - i);
+    }
+
+    // Load a pixel in the low 32 bits of a register
+    SFML_IMAGE_SSE2 inline __m128i loadPixel(const sf::Uint8* pixel)
+    {
+        return _mm_cvtsi32_si128(static_cast<int>(toWord(pixel)));
+    }
+
+    // Broadcast a pair of 16-bit weights, for _mm_madd_epi16
+    SFML_IMAGE_SSE2 inline __m128i weightPair(sf::Int16 first, sf::Int16 second)
+    {
+        return _mm_set1_epi32(static_cast<int>((static_cast<sf::Uint32>(static_cast<sf::Uint16>(second)) << 16) | static_cast<sf::Uint16>(first)));
+    }
+
+    SFML_IMAGE_SSE2 void resampleHorizontalSimd(const sf::Uint8* source, sf::Uint8* destination, std::size_t count,
+                                                const unsigned int* starts, const sf::Int16* weights, std::size_t tapCount)
+    {
+        const __m128i zero = _mm_setzero_si128();
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const sf::Uint8* src = source + starts[i] * 4;
+            const sf::Int16* weight = weights + i * tapCount;
+            __m128i sums = _mm_set1_epi32(1 << (weightBits - 1));
+
+            // Interleave the components of 2 pixels (r0 r1 g0 g1 ...) so that
+            // _mm_madd_epi16 applies both weights and adds the products at once
+            std::size_t k = 0;
+            for (; k + 2 <= tapCount; k += 2)
+            {
+                __m128i pixels = _mm_unpacklo_epi8(_mm_unpacklo_epi8(loadPixel(src + k * 4), loadPixel(src + k * 4 + 4)), zero);
+                sums = _mm_add_epi32(sums, _mm_madd_epi16(pixels, weightPair(weight[k], weight[k + 1])));
+            }
+
+            if (k < tapCount)
+            {
+                __m128i pixel = _mm_unpacklo_epi8(_mm_unpacklo_epi8(loadPixel(src + k * 4), zero), zero);
+                sums = _mm_add_epi32(sums, _mm_madd_epi16(pixel, weightPair(weight[k], 0)));
+            }
+
+            sums = _mm_srai_epi32(sums, weightBits);
+            sums = _mm_packs_epi32(sums, sums);
+            sf::Uint32 result = static_cast<sf::Uint32>(_mm_cvtsi128_si32(_mm_packus_epi16(sums, sums)));
+            std::memcpy(destination + i * 4, &result, sizeof(result));
+        }
+    }
+
+    SFML_IMAGE_SSE2 void resampleVerticalSimd(const sf::Uint8* source, std::size_t stride, const sf::Int16* weights, std::size_t tapCount,
+                                              sf::Uint8* destination, std::size_t byteCount)
+    {
+        const __m128i zero = _mm_setzero_si128();
+
+        std::size_t i = 0;
+        for (; i + 8 <= byteCount; i += 8)
+        {
+            __m128i low = _mm_set1_epi32(1 << (weightBits - 1));
+            __m128i high = low;
+
+            // Same as the horizontal version: interleave the bytes of 2 rows
+            std::size_t k = 0;
+            for (; k + 2 <= tapCount; k += 2)
+            {
+                __m128i first = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + k * stride + i));
+                __m128i second = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + (k + 1) * stride + i));
+                __m128i bytes = _mm_unpacklo_epi8(first, second);
+                __m128i weight = weightPair(weights[k], weights[k + 1]);
+                low = _mm_add_epi32(low, _mm_madd_epi16(_mm_unpacklo_epi8(bytes, zero), weight));
+                high = _mm_add_epi32(high, _mm_madd_epi16(_mm_unpackhi_epi8(bytes, zero), weight));
+            }
+
+            if (k < tapCount)
+            {
+                __m128i bytes = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + k * stride + i)), zero);
+                __m128i weight = weightPair(weights[k], 0);
+                low = _mm_add_epi32(low, _mm_madd_epi16(_mm_unpacklo_epi8(bytes, zero), weight));
+                high = _mm_add_epi32(high, _mm_madd_epi16(_mm_unpackhi_epi8(bytes, zero), weight));
+            }
+
+            __m128i result = _mm_packs_epi32(_mm_srai_epi32(low, weightBits), _mm_srai_epi32(high, weightBits));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(result, result));
+        }
+
+        resampleVerticalScalar(source + i, stride, weights, tapCount, destination + i, byteCount - i);
+    }
+
+    const char* simdName = "SSE2";
+
+#elif defined(SFML_IMAGE_NEON)
+
+    ////////////////////////////////////////////////////////////
+    // NEON kernels: the structure loads/stores deinterleave
+    // the components, so that each register holds a single
+    // component of 8 or 16 pixels
+    ////////////////////////////////////////////////////////////
+
+    // x / 255, rounded down, is exactly (x + 1 + ((x + 1) >> 8)) >> 8
+    inline uint8x8_t floorDivide255(uint16x8_t x)
+    {
+        x = vaddq_u16(x, vdupq_n_u16(1));
+        return vshrn_n_u16(vsraq_n_u16(x, x, 8), 8);
+    }
+
+    // x / 255, rounded to nearest
+    inline uint8x8_t roundDivide255(uint16x8_t x)
+    {
+        return vraddhn_u16(x, vrshrq_n_u16(x, 8));
+    }
+
+    // Reverse the order of the 4 pixels of a register
+    inline uint8x16_t reversePixels(uint8x16_t pixels)
+    {
+        uint32x4_t swapped = vrev64q_u32(vreinterpretq_u32_u8(pixels));
+        return vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(swapped), vget_low_u32(swapped)));
+    }
+
+    void fillSimd(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color)
+    {
+        const uint8x16_t value = vreinterpretq_u8_u32(vdupq_n_u32(toWord(color)));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            vst1q_u8(pixels + i * 4, value);
+
+        fillScalar(pixels + i * 4, count - i, color);
+    }
+
+    void blendSimd(const sf::Uint8* source, sf::Uint8* destination, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t src = vld4_u8(source + i * 4);
+            uint8x8x4_t dst = vld4_u8(destination + i * 4);
+            uint8x8_t inverseAlpha = vmvn_u8(src.val[3]);
+
+            for (int j = 0; j < 3; ++j)
+                dst.val[j] = floorDivide255(vmlal_u8(vmull_u8(src.val[j], src.val[3]), dst.val[j], inverseAlpha));
+            dst.val[3] = vadd_u8(src.val[3], floorDivide255(vmull_u8(dst.val[3], inverseAlpha)));
+
+            vst4_u8(destination + i * 4, dst);
+        }
+
+        blendScalar(source + i * 4, destination + i * 4, count - i);
+    }
+
+    void maskSimd(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color, sf::Uint8 alpha)
+    {
+        const sf::Uint8 alphaBytes[] = {0, 0, 0, alpha};
+        const sf::Uint8 alphaMaskBytes[] = {0, 0, 0, 255};
+        const uint32x4_t key = vdupq_n_u32(toWord(color));
+        const uint32x4_t alphaValue = vdupq_n_u32(toWord(alphaBytes));
+        const uint32x4_t alphaMask = vdupq_n_u32(toWord(alphaMaskBytes));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            uint32x4_t value = vreinterpretq_u32_u8(vld1q_u8(pixels + i * 4));
+            uint32x4_t replaced = vandq_u32(vceqq_u32(value, key), alphaMask);
+            vst1q_u8(pixels + i * 4, vreinterpretq_u8_u32(vbslq_u32(replaced, alphaValue, value)));
+        }
+
+        maskScalar(pixels + i * 4, count - i, color, alpha);
+    }
+
+    void reverseSimd(sf::Uint8* pixels, std::size_t count)
+    {
+        // Swap blocks of 4 pixels from both ends, then reverse what is left in the middle
+        sf::Uint8* left = pixels;
+        sf::Uint8* right = pixels + count * 4;
+        while (right - left >= 32)
+        {
+            right -= 16;
+            uint8x16_t leftValue = vld1q_u8(left);
+            uint8x16_t rightValue = vld1q_u8(right);
+            vst1q_u8(left, reversePixels(rightValue));
+            vst1q_u8(right, reversePixels(leftValue));
+            left += 16;
+        }
+
+        reverseScalar(left, static_cast<std::size_t>(right - left) / 4);
+    }
+
+    void premultiplySimd(sf::Uint8* pixels, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t value = vld4_u8(pixels + i * 4);
+            for (int j = 0; j < 3; ++j)
+                value.val[j] = roundDivide255(vmull_u8(value.val[j], value.val[3]));
+            vst4_u8(pixels + i * 4, value);
+        }
+
+        premultiplyScalar(pixels + i * 4, count - i);
+    }
+
+    void swapRedBlueSimd(const sf::Uint8* source, sf::Uint8* destination, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x4_t value = vld4q_u8(source + i * 4);
+            uint8x16_t red = value.val[0];
+            value.val[0] = value.val[2];
+            value.val[2] = red;
+            vst4q_u8(destination + i * 4, value);
+        }
+
+        swapRedBlueScalar(source + i * 4, destination + i * 4, count - i);
+    }
+
+    void toRgb565Simd(const sf::Uint8* source, sf::Uint16* destination, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            // Insert the high bits of each component under the previous ones
+            uint8x8x4_t value = vld4_u8(source + i * 4);
+            uint16x8_t rgb = vshll_n_u8(value.val[0], 8);
+            rgb = vsriq_n_u16(rgb, vshll_n_u8(value.val[1], 8), 5);
+            rgb = vsriq_n_u16(rgb, vshll_n_u8(value.val[2], 8), 11);
+            vst1q_u16(destination + i, rgb);
+        }
+
+        toRgb565Scalar(source + i * 4, destination + i, count - i);
+    }
+
+    void fromRgb565Simd(const sf::Uint16* source, sf::Uint8* destination, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            uint16x8_t value = vld1q_u16(source + i);
+            uint8x8_t red   = vmovn_u16(vshrq_n_u16(value, 11));
+            uint8x8_t green = vmovn_u16(vandq_u16(vshrq_n_u16(value, 5), vdupq_n_u16(0x3F)));
+            uint8x8_t blue  = vmovn_u16(vandq_u16(value, vdupq_n_u16(0x1F)));
+
+            uint8x8x4_t rgba;
+            rgba.val[0] = vorr_u8(vshl_n_u8(red, 3), vshr_n_u8(red, 2));
+            rgba.val[1] = vorr_u8(vshl_n_u8(green, 2), vshr_n_u8(green, 4));
+            rgba.val[2] = vorr_u8(vshl_n_u8(blue, 3), vshr_n_u8(blue, 2));
+            rgba.val[3] = vdup_n_u8(255);
+            vst4_u8(destination + i * 4, rgba);
+        }
+
+        fromRgb565Scalar(source + i, destination + i * 4, count - i);
+    }
+
+    void resampleHorizontalSimd(const sf::Uint8* source, sf::Uint8* destination, std::size_t count,
+                                const unsigned int* starts, const sf::Int16* weights, std::size_t tapCount)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const sf::Uint8* src = source + starts[i] * 4;
+            const sf::Int16* weight = weights + i * tapCount;
+            int32x4_t sums = vdupq_n_s32(1 << (weightBits - 1));
+
+            for (std::size_t k = 0; k < tapCount; ++k)
+            {
+                uint8x8_t pixel = vreinterpret_u8_u32(vdup_n_u32(toWord(src + k * 4)));
+                sums = vmlal_n_s16(sums, vget_low_s16(vreinterpretq_s16_u16(vmovl_u8(pixel))), weight[k]);
+            }
+
+            int16x4_t narrowed = vqshrn_n_s32(sums, weightBits);
+            uint8x8_t result = vqmovun_s16(vcombine_s16(narrowed, narrowed));
+            sf::Uint32 word = vget_lane_u32(vreinterpret_u32_u8(result), 0);
+            std::memcpy(destination + i * 4, &word, sizeof(word));
+        }
+    }
+
+    void resampleVerticalSimd(const sf::Uint8* source, std::size_t stride, const sf::Int16* weights, std::size_t tapCount,
+                              sf::Uint8* destination, std::size_t byteCount)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= byteCount; i += 8)
+        {
+            int32x4_t low = vdupq_n_s32(1 << (weightBits - 1));
+            int32x4_t high = low;
+
+            for (std::size_t k = 0; k < tapCount; ++k)
+            {
+                int16x8_t bytes = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(source + k * stride + i)));
+                low = vmlal_n_s16(low, vget_low_s16(bytes), weights[k]);
+                high = vmlal_n_s16(high, vget_high_s16(bytes), weights[k]);
+            }
+
+            int16x8_t result = vcombine_s16(vqshrn_n_s32(low, weightBits), vqshrn_n_s32(high, weightBits));
+            vst1_u8(destination + i, vqmovun_s16(result));
+        }
+
+        resampleVerticalScalar(source + i, stride, weights, tapCount, destination + i, byteCount - i);
+    }
+
+    const char* simdName = "NEON";
+
+#endif
+
+    const sf::priv::ImageKernels scalarKernels =
+    {
+        "scalar",
+        &fillScalar,
+        &blendScalar,
+        &maskScalar,
+        &reverseScalar,
+        &premultiplyScalar,
+        &unpremultiplyScalar,
+        &swapRedBlueScalar,
+        &toRgb565Scalar,
+        &fromRgb565Scalar,
+        &resampleHorizontalScalar,
+        &resampleVerticalScalar
+    };
+
+#if defined(SFML_IMAGE_SSE2) || defined(SFML_IMAGE_NEON)
+
+    // Unpremultiplying needs a division per component, there's
+    // no SIMD version so the scalar one is used in both sets
+    const sf::priv::ImageKernels simdKernels =
+    {
+        simdName,
+        &fillSimd,
+        &blendSimd,
+        &maskSimd,
+        &reverseSimd,
+        &premultiplySimd,
+        &unpremultiplyScalar,
+        &swapRedBlueSimd,
+        &toRgb565Simd,
+        &fromRgb565Simd,
+        &resampleHorizontalSimd,
+        &resampleVerticalSimd
+    };
+
+#endif
+
+    const sf::priv::ImageKernels& selectKernels()
+    {
+    #if defined(SFML_IMAGE_SSE2) && defined(__GNUC__)
+
+        // The SSE2 kernels may have been compiled for a CPU that the rest of the library doesn't require
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse2"))
+            return simdKernels;
+
+    #elif defined(SFML_IMAGE_SSE2) || defined(SFML_IMAGE_NEON)
+
+        // The compiler only enables these instructions if the target CPU is known to support them
+        return simdKernels;
+
+    #endif
+
+        return scalarKernels;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+const ImageKernels& getImageKernels()
+{
+    static const ImageKernels& kernels = selectKernels();
+    return kernels;
+}
+
+
+////////////////////////////////////////////////////////////
+const ImageKernels& getScalarImageKernels()
+{
+    return scalarKernels;
+}
+
+} // namespace priv
+
+} // namespace sf
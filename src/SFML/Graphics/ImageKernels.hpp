@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGEKERNELS_HPP
+#define SFML_IMAGEKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Set of functions processing arrays of RGBA pixels
+///
+/// All the functions take a number of pixels, not bytes.
+/// The SIMD versions give exactly the same results as the
+/// scalar ones; the best set supported by the CPU is
+/// selected at runtime by getImageKernels().
+///
+////////////////////////////////////////////////////////////
+struct ImageKernels
+{
+    const char* name; ///< Name of the instruction set used by the kernels
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fill pixels with a color
+    ///
+    /// \a color contains the 4 components in memory order.
+    ///
+    ////////////////////////////////////////////////////////////
+    void (*fill)(Uint8* pixels, std::size_t count, const Uint8* color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Blend source pixels over destination pixels using the source alpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void (*blend)(const Uint8* source, Uint8* destination, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the alpha of the pixels equal to \a color
+    ///
+    ////////////////////////////////////////////////////////////
+    void (*mask)(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reverse the order of pixels, in place
+    ///
+    ////////////////////////////////////////////////////////////
+    void (*reverse)(Uint8* pixels, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the color components by the alpha component, in place
+    ///
+    ////////////////////////////////////////////////////////////
+    void (*premultiply)(Uint8* pixels, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Divide the color components by the alpha component, in place
+    ///
+    ////////////////////////////////////////////////////////////
+    void (*unpremultiply)(Uint8* pixels, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the red and blue components (RGBA <-> BGRA)
+    ///
+    /// \a source and \a destination may be the same array.
+    ///
+    ////////////////////////////////////////////////////////////
+    void (*swapRedBlue)(const Uint8* source, Uint8* destination, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert RGBA pixels to 16-bit RGB565, dropping alpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void (*toRgb565)(const Uint8* source, Uint16* destination, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert 16-bit RGB565 pixels to opaque RGBA
+    ///
+    ////////////////////////////////////////////////////////////
+    void (*fromRgb565)(const Uint16* source, Uint8* destination, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resample a row of pixels horizontally
+    ///
+    /// Each destination pixel \a i is the sum of the \a tapCount
+    /// source pixels starting at \a starts[i], weighted by the
+    /// \a tapCount weights starting at \a weights[i * tapCount].
+    /// The weights are fixed point numbers with 14 fractional bits.
+    ///
+    ////////////////////////////////////////////////////////////
+    void (*resampleHorizontal)(const Uint8* source, Uint8* destination, std::size_t count,
+                               const unsigned int* starts, const Int16* weights, std::size_t tapCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resample rows of pixels vertically
+    ///
+    /// Each destination byte is the sum of the bytes at the same
+    /// position in \a tapCount consecutive source rows, weighted
+    /// by \a weights (fixed point numbers with 14 fractional bits).
+    ///
+    ////////////////////////////////////////////////////////////
+    void (*resampleVertical)(const Uint8* source, std::size_t stride, const Int16* weights, std::size_t tapCount,
+                             Uint8* destination, std::size_t byteCount);
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Get the fastest kernels supported by the CPU
+///
+/// \return Kernels selected for the CPU
+///
+////////////////////////////////////////////////////////////
+const ImageKernels& getImageKernels();
+
+////////////////////////////////////////////////////////////
+/// \brief Get the portable scalar kernels
+///
+/// \return Scalar kernels
+///
+////////////////////////////////////////////////////////////
+const ImageKernels& getScalarImageKernels();
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEKERNELS_HPP
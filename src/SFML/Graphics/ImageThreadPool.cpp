@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageThreadPool.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // The unique instance, shared by all the images
+    sf::priv::ImageThreadPool* instance = NULL;
+    sf::Mutex instanceMutex;
+
+    // Jobs with fewer rows than this are not worth waking up the workers
+    const unsigned int minRowsPerThread = 16;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+struct ImageThreadPool::Worker
+{
+    Worker(ImageThreadPool& pool) :
+    owner (pool),
+    thread(&ImageThreadPool::runWorker, this),
+    signal()
+    {
+    }
+
+    ImageThreadPool& owner;  ///< Pool owning the worker
+    Thread           thread; ///< Thread running ImageThreadPool::runWorker
+    Signal           signal; ///< Signal used to wake up the worker
+};
+
+
+////////////////////////////////////////////////////////////
+ImageThreadPool::ImageThreadPool() :
+m_runMutex   (),
+m_mutex      (),
+m_done       (),
+m_workers    (),
+m_threadCount(4),
+m_exit       (false),
+m_function   (NULL),
+m_data       (NULL),
+m_rowCount   (0),
+m_nextRow    (0),
+m_bandSize   (1),
+m_busyCount  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageThreadPool::run(RowFunction function, void* data, unsigned int rowCount)
+{
+    ImageThreadPool& pool = getInstance();
+    Lock runLock(pool.m_runMutex);
+
+    // Small jobs are processed directly by the calling thread
+    unsigned int threadCount = std::min(pool.m_threadCount, rowCount / minRowsPerThread);
+    if (threadCount <= 1)
+    {
+        function(data, 0, rowCount);
+        return;
+    }
+
+    // Start the workers the first time they are needed
+    if (pool.m_workers.empty())
+    {
+        for (unsigned int i = 1; i < pool.m_threadCount; ++i)
+        {
+            pool.m_workers.push_back(new Worker(pool));
+            pool.m_workers.back()->thread.launch();
+        }
+    }
+
+    {
+        Lock lock(pool.m_mutex);
+        pool.m_function  = function;
+        pool.m_data      = data;
+        pool.m_rowCount  = rowCount;
+        pool.m_nextRow   = 0;
+        pool.m_bandSize  = std::max(rowCount / (threadCount * 4), 1u);
+        pool.m_busyCount = threadCount - 1;
+    }
+
+    // Wake up as many workers as needed, and help them
+    for (unsigned int i = 0; i < threadCount - 1; ++i)
+        pool.m_workers[i]->signal.notify();
+
+    pool.processBands();
+
+    // Wait until the workers have finished their last band
+    for (;;)
+    {
+        {
+            Lock lock(pool.m_mutex);
+            if (pool.m_busyCount == 0)
+                break;
+        }
+
+        pool.m_done.wait();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageThreadPool::setThreadCount(unsigned int count)
+{
+    ImageThreadPool& pool = getInstance();
+    Lock lock(pool.m_runMutex);
+
+    // The next job starts the new number of workers
+    pool.stopWorkers();
+    pool.m_threadCount = std::max(count, 1u);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ImageThreadPool::getThreadCount()
+{
+    ImageThreadPool& pool = getInstance();
+    Lock lock(pool.m_runMutex);
+    return pool.m_threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+ImageThreadPool& ImageThreadPool::getInstance()
+{
+    Lock lock(instanceMutex);
+
+    // Never deleted, see the class description
+    if (!instance)
+        instance = new ImageThreadPool;
+
+    return *instance;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageThreadPool::stopWorkers()
+{
+    {
+        Lock lock(m_mutex);
+        m_exit = true;
+    }
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->signal.notify();
+        (*it)->thread.wait();
+        delete *it;
+    }
+
+    m_workers.clear();
+
+    Lock lock(m_mutex);
+    m_exit = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageThreadPool::runWorker(Worker* worker)
+{
+    ImageThreadPool& owner = worker->owner;
+
+    for (;;)
+    {
+        worker->signal.wait();
+
+        {
+            Lock lock(owner.m_mutex);
+            if (owner.m_exit)
+                return;
+        }
+
+        owner.processBands();
+
+        Lock lock(owner.m_mutex);
+        if (--owner.m_busyCount == 0)
+            owner.m_done.notify();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageThreadPool::processBands()
+{
+    for (;;)
+    {
+        unsigned int begin;
+        unsigned int end;
+        {
+            Lock lock(m_mutex);
+            if (m_nextRow >= m_rowCount)
+                return;
+
+            begin = m_nextRow;
+            end = std::min(begin + m_bandSize, m_rowCount);
+            m_nextRow = end;
+        }
+
+        m_function(m_data, begin, end);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGETHREADPOOL_HPP
+#define SFML_IMAGETHREADPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Signal.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Pool of worker threads processing the rows of
+///        images in parallel
+///
+/// The rows are split in bands that the workers and the
+/// calling thread pick until there's none left.
+///
+/// The unique pool is created on first use and never
+/// destroyed, so that no thread has to be joined during
+/// static destruction (which may deadlock, for example
+/// under the loader lock of a Windows DLL). Its workers
+/// are stopped explicitly by setThreadCount.
+///
+////////////////////////////////////////////////////////////
+class ImageThreadPool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function processing the rows [begin, end)
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*RowFunction)(void* data, unsigned int begin, unsigned int end);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process rows in parallel
+    ///
+    /// Returns once all the rows have been processed. The
+    /// workers are started on the first call.
+    ///
+    /// \param function Function to call on each band of rows
+    /// \param data     User data passed to \a function
+    /// \param rowCount Total number of rows
+    ///
+    ////////////////////////////////////////////////////////////
+    static void run(RowFunction function, void* data, unsigned int rowCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads processing the rows
+    ///
+    /// The running workers, if any, are stopped and waited
+    /// for; the next call to run starts the new number of
+    /// workers. A count of 1 stops all the workers.
+    ///
+    /// \param count Number of threads, including the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads processing the rows
+    ///
+    /// \return Number of threads, including the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getThreadCount();
+
+private:
+
+    struct Worker;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageThreadPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the unique pool, creating it if needed
+    ///
+    /// \return Reference to the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    static ImageThreadPool& getInstance();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop and wait for the worker threads
+    ///
+    /// m_runMutex must be locked.
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopWorkers();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker threads
+    ///
+    /// \param worker Worker running the function
+    ///
+    ////////////////////////////////////////////////////////////
+    static void runWorker(Worker* worker);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process bands of rows of the current job until there's none left
+    ///
+    ////////////////////////////////////////////////////////////
+    void processBands();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex                m_runMutex;    ///< Mutex serializing the calls to run()
+    Mutex                m_mutex;       ///< Mutex protecting the current job
+    Signal               m_done;        ///< Signal raised when the last busy worker is done
+    std::vector<Worker*> m_workers;     ///< Worker threads
+    unsigned int         m_threadCount; ///< Number of threads to use, including the calling thread
+    bool                 m_exit;        ///< Must the workers exit?
+    RowFunction          m_function;    ///< Function of the current job
+    void*                m_data;        ///< User data of the current job
+    unsigned int         m_rowCount;    ///< Number of rows of the current job
+    unsigned int         m_nextRow;     ///< First row not picked yet by a thread
+    unsigned int         m_bandSize;    ///< Number of rows picked at once
+    unsigned int         m_busyCount;   ///< Number of workers still processing the current job
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGETHREADPOOL_HPP
@@ -32,11 +32,23 @@
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 namespace
 {
+    // Texture matrix of the draws that have no texture
+    const float identityMatrix[16] = {1.f, 0.f, 0.f, 0.f,
+                                      0.f, 1.f, 0.f, 0.f,
+                                      0.f, 0.f, 1.f, 0.f,
+                                      0.f, 0.f, 0.f, 1.f};
+
     // Convert an sf::BlendMode::Factor constant to the corresponding OpenGL constant.
     sf::Uint32 factorToGlConstant(sf::BlendMode::Factor blendFactor)
     {
@@ -74,6 +86,43 @@ namespace
         assert(false);
         return GLEXT_GL_FUNC_ADD;
     }
+
+
+    // OpenGL primitive type of each sf::PrimitiveType (sf::Quads are drawn as indexed triangles)
+    const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                            GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN};
+
+
+    // Number of quads that can be addressed with 16-bit indices
+    const std::size_t maxQuadCount = 65536 / 4;
+
+    // Indices drawing quads (in sf::Quads order) as pairs of triangles, shared by all the render targets
+    sf::Mutex              quadIndicesMutex;
+    std::vector<sf::Uint16> quadIndices;
+
+    // Get the shared quad indices, creating them on first use; they cover maxQuadCount quads
+    const sf::Uint16* getQuadIndices()
+    {
+        sf::Lock lock(quadIndicesMutex);
+
+        if (quadIndices.empty())
+        {
+            quadIndices.resize(maxQuadCount * 6);
+            for (std::size_t i = 0; i < maxQuadCount; ++i)
+            {
+                sf::Uint16 first = static_cast<sf::Uint16>(i * 4);
+                sf::Uint16* indices = &quadIndices[i * 6];
+                indices[0] = first;
+                indices[1] = static_cast<sf::Uint16>(first + 1);
+                indices[2] = static_cast<sf::Uint16>(first + 2);
+                indices[3] = first;
+                indices[4] = static_cast<sf::Uint16>(first + 2);
+                indices[5] = static_cast<sf::Uint16>(first + 3);
+            }
+        }
+
+        return &quadIndices[0];
+    }
 }
 
 
@@ -81,11 +130,13 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 RenderTarget::RenderTarget() :
-m_defaultView(),
-m_view       (),
-m_cache      ()
+m_defaultView (),
+m_view        (),
+m_cache       (),
+m_shortIndices()
 {
     m_cache.glStatesSet = false;
+    m_cache.elidedCalls = 0;
 }
 
 
@@ -204,112 +255,66 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
     if (!vertices || (vertexCount == 0))
         return;
 
-    // GL_QUADS is unavailable on OpenGL ES
-    #ifdef SFML_OPENGL_ES
-        if (type == Quads)
+    // GL_QUADS is deprecated and unavailable on OpenGL ES, so quads are drawn
+    // as pairs of triangles sharing 2 vertices, with the shared quad indices
+    if (type == Quads)
+    {
+        const Uint16* indices = getQuadIndices();
+        std::size_t quadCount = vertexCount / 4;
+
+        // 16-bit indices can't address all the quads at once if there are too many
+        for (std::size_t first = 0; first < quadCount; first += maxQuadCount)
         {
-            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
-            return;
+            std::size_t count = std::min(quadCount - first, maxQuadCount);
+            draw(vertices + first * 4, count * 4, indices, count * 6, Triangles, states);
         }
-        #define GL_QUADS 0
-    #endif
+
+        return;
+    }
 
     if (setActive(true))
     {
-        // First set the persistent OpenGL states if it's the very first call
-        if (!m_cache.glStatesSet)
-            resetGLStates();
+        SFML_PROFILE_ZONE("RenderTarget::draw");
+        SFML_PROFILE_COUNTER("Draw calls", 1);
 
-        // Check if the vertex count is low enough so that we can pre-transform them
-        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
-        if (useVertexCache)
-        {
-            // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
-            {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
-            }
+        setupDraw(vertices, vertexCount, states);
 
-            // Since vertices are transformed, we must use an identity transform to render them
-            if (!m_cache.useVertexCache)
-                applyTransform(Transform::Identity);
-        }
-        else
-        {
-            applyTransform(states.transform);
-        }
-
-        // Apply the view
-        if (m_cache.viewChanged)
-            applyCurrentView();
-
-        // Apply the blend mode
-        if (states.blendMode != m_cache.lastBlendMode)
-            applyBlendMode(states.blendMode);
+        // Draw the primitives
+        glCheck(glDrawArrays(modes[type], 0, vertexCount));
 
-        // Apply the texture
-        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
-        if (textureId != m_cache.lastTextureId)
-            applyTexture(states.texture);
+        cleanupDraw(states);
+    }
+}
 
-        // Apply the shader
-        if (states.shader)
-            applyShader(states.shader);
 
-        // If we pre-transform the vertices, we must use our internal vertex cache
-        if (useVertexCache)
-        {
-            // ... and if we already used it previously, we don't need to set the pointers again
-            if (!m_cache.useVertexCache)
-                vertices = m_cache.vertexCache;
-            else
-                vertices = NULL;
-        }
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, const Uint16* indices, std::size_t indexCount,
+                        PrimitiveType type, const RenderStates& states)
+{
+    drawElements(vertices, vertexCount, indices, indexCount, GL_UNSIGNED_SHORT, type, states);
+}
 
-        // Check if texture coordinates array is needed, and update client state accordingly
-        bool enableTexCoordsArray = (states.texture || states.shader);
-        if (enableTexCoordsArray != m_cache.texCoordsArrayEnabled)
-        {
-            if (enableTexCoordsArray)
-                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
-            else
-                glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
-            m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
-        }
 
-        // Setup the pointers to the vertices' components
-        if (vertices)
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, const Uint32* indices, std::size_t indexCount,
+                        PrimitiveType type, const RenderStates& states)
+{
+    // Without 32-bit indices support, fall back to 16-bit indices if they are enough
+    if (!GLEXT_element_index_uint)
+    {
+        if (vertexCount > 65536)
         {
-            const char* data = reinterpret_cast<const char*>(vertices);
-            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
-            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
-            if (enableTexCoordsArray)
-                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            err() << "32-bit indices are not supported by the OpenGL implementation, drawing skipped" << std::endl;
+            return;
         }
 
-        // Find the OpenGL primitive type
-        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
-                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
-        GLenum mode = modes[type];
-
-        // Draw the primitives
-        glCheck(glDrawArrays(mode, 0, vertexCount));
-
-        // Unbind the shader, if any
-        if (states.shader)
-            applyShader(NULL);
-
-        // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
-        // This prevents a bug where some drivers do not clear RenderTextures properly.
-        if (states.texture && states.texture->m_fboAttachment)
-            applyTexture(NULL);
-
-        // Update the cache
-        m_cache.useVertexCache = useVertexCache;
+        // The conversion buffer keeps its capacity, so that it doesn't allocate at every draw
+        m_shortIndices.assign(indices, indices + indexCount);
+        draw(vertices, vertexCount, m_shortIndices.empty() ? NULL : &m_shortIndices[0], indexCount, type, states);
+        return;
     }
+
+    drawElements(vertices, vertexCount, indices, indexCount, GLEXT_GL_UNSIGNED_INT, type, states);
 }
 
 
@@ -361,6 +366,12 @@ void RenderTarget::popGLStates()
             glCheck(glPopAttrib());
         #endif
     }
+
+    // The restored matrices and vertex pointers may not be the cached ones
+    m_cache.transformSet = false;
+    m_cache.textureMatrixSet = false;
+    m_cache.vertexPointer = NULL;
+    m_cache.texCoordsPointer = NULL;
 }
 
 
@@ -395,6 +406,13 @@ void RenderTarget::resetGLStates()
         glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
         m_cache.glStatesSet = true;
 
+        // Forget the cached states, the user may have changed them
+        m_cache.transformSet = false;
+        m_cache.textureMatrixSet = false;
+        m_cache.vertexPointer = NULL;
+        m_cache.texCoordsPointer = NULL;
+        m_cache.shaderBound = false;
+
         // Apply the default SFML states
         applyBlendMode(BlendAlpha);
         applyTransform(Transform::Identity);
@@ -404,14 +422,19 @@ void RenderTarget::resetGLStates()
 
         m_cache.texCoordsArrayEnabled = true;
 
-        m_cache.useVertexCache = false;
-
         // Set the default view
         setView(getView());
     }
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 RenderTarget::getElidedGlCallCount() const
+{
+    return m_cache.elidedCalls;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::initialize()
 {
@@ -446,6 +469,8 @@ void RenderTarget::applyCurrentView()
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyBlendMode(const BlendMode& mode)
 {
+    SFML_PROFILE_COUNTER("Blend mode changes", 1);
+
     // Apply the blend mode, falling back to the non-separate versions if necessary
     if (GLEXT_blend_func_separate)
     {
@@ -494,18 +519,70 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTransform(const Transform& transform)
 {
+    // Consecutive draws often use the same transform (the identity for pre-transformed vertices)
+    if (m_cache.transformSet && (std::memcmp(transform.getMatrix(), m_cache.lastTransform.getMatrix(), 16 * sizeof(float)) == 0))
+    {
+        addElidedCalls(1);
+        return;
+    }
+
     // No need to call glMatrixMode(GL_MODELVIEW), it is always the
     // current mode (for optimization purpose, since it's the most used)
     glCheck(glLoadMatrixf(transform.getMatrix()));
+
+    m_cache.lastTransform = transform;
+    m_cache.transformSet = true;
+
+    SFML_PROFILE_COUNTER("Transform loads", 1);
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTexture(const Texture* texture)
 {
-    Texture::bind(texture, Texture::Pixels);
+    // This is Texture::bind(texture, Texture::Pixels), without the texture matrix
+    // changes that are not needed
+    if (texture && texture->m_texture)
+    {
+        glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
+
+        // The matrix only depends on the size and orientation of the texture,
+        // textures of the same size (or the same texture rebound) share it
+        GLfloat matrix[16];
+        texture->getTextureMatrix(Texture::Pixels, matrix);
+        applyTextureMatrix(matrix);
+    }
+    else
+    {
+        // The fixed pipeline ignores the texture matrix without a texture; shaders
+        // may still read it, setupDraw resets it for them
+        glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+        addElidedCalls(3);
+    }
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+
+    SFML_PROFILE_COUNTER("Texture changes", 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyTextureMatrix(const float* matrix)
+{
+    if (m_cache.textureMatrixSet && (std::memcmp(matrix, m_cache.textureMatrix, sizeof(m_cache.textureMatrix)) == 0))
+    {
+        addElidedCalls(3);
+        return;
+    }
+
+    glCheck(glMatrixMode(GL_TEXTURE));
+    glCheck(glLoadMatrixf(matrix));
+
+    // Go back to model-view mode (sf::RenderTarget relies on it)
+    glCheck(glMatrixMode(GL_MODELVIEW));
+
+    std::memcpy(m_cache.textureMatrix, matrix, sizeof(m_cache.textureMatrix));
+    m_cache.textureMatrixSet = true;
 }
 
 
@@ -513,6 +590,171 @@ void RenderTarget::applyTexture(const Texture* texture)
 void RenderTarget::applyShader(const Shader* shader)
 {
     Shader::bind(shader);
+
+    m_cache.shaderBound = (shader != NULL);
+
+    SFML_PROFILE_COUNTER("Shader changes", 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::addElidedCalls(unsigned int count)
+{
+    m_cache.elidedCalls += count;
+
+    SFML_PROFILE_COUNTER("Elided GL calls", count);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setupDraw(const Vertex* vertices, std::size_t vertexCount, const RenderStates& states)
+{
+    // First set the persistent OpenGL states if it's the very first call
+    if (!m_cache.glStatesSet)
+        resetGLStates();
+
+    // Check if the vertex count is low enough so that we can pre-transform them
+    if (vertexCount <= StatesCache::VertexCacheSize)
+    {
+        // Pre-transform the vertices and store them into the vertex cache
+        // (all the positions are transformed at once, with a single call)
+        Vector2f positions[StatesCache::VertexCacheSize];
+        for (std::size_t i = 0; i < vertexCount; ++i)
+            positions[i] = vertices[i].position;
+
+        states.transform.transformPoints(positions, positions, vertexCount);
+
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            Vertex& vertex = m_cache.vertexCache[i];
+            vertex.position = positions[i];
+            vertex.color = vertices[i].color;
+            vertex.texCoords = vertices[i].texCoords;
+        }
+
+        // Since vertices are transformed, we must use an identity transform to render them
+        applyTransform(Transform::Identity);
+
+        vertices = m_cache.vertexCache;
+    }
+    else
+    {
+        applyTransform(states.transform);
+    }
+
+    // Apply the view
+    if (m_cache.viewChanged)
+        applyCurrentView();
+
+    // Apply the blend mode
+    if (states.blendMode != m_cache.lastBlendMode)
+        applyBlendMode(states.blendMode);
+    else
+        addElidedCalls(1);
+
+    // Apply the texture
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if (textureId != m_cache.lastTextureId)
+        applyTexture(states.texture);
+    else
+        addElidedCalls(1);
+
+    // Apply the shader; the previous one is left bound after a draw, and
+    // only unbound when a draw doesn't use any
+    if (states.shader)
+    {
+        if (m_cache.shaderBound)
+            addElidedCalls(1);
+
+        applyShader(states.shader);
+    }
+    else if (m_cache.shaderBound)
+    {
+        applyShader(NULL);
+    }
+
+    // A shader may transform its texture coordinates by gl_TextureMatrix[0] even
+    // without a texture, it must not get the matrix of the previous texture
+    if (states.shader && !states.texture)
+        applyTextureMatrix(identityMatrix);
+
+    // Check if texture coordinates array is needed, and update client state accordingly
+    bool enableTexCoordsArray = (states.texture || states.shader);
+    if (enableTexCoordsArray != m_cache.texCoordsArrayEnabled)
+    {
+        if (enableTexCoordsArray)
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        else
+            glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+        m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
+    }
+
+    // Setup the pointers to the vertices' components; the arrays are only read when
+    // drawing, so the pointers don't need to be set again if the array is the same
+    const char* data = reinterpret_cast<const char*>(vertices);
+    if (vertices != m_cache.vertexPointer)
+    {
+        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+        m_cache.vertexPointer = vertices;
+    }
+    else
+    {
+        addElidedCalls(2);
+    }
+
+    if (enableTexCoordsArray)
+    {
+        if (vertices != m_cache.texCoordsPointer)
+        {
+            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            m_cache.texCoordsPointer = vertices;
+        }
+        else
+        {
+            addElidedCalls(1);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::cleanupDraw(const RenderStates& states)
+{
+    // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
+    // This prevents a bug where some drivers do not clear RenderTextures properly.
+    if (states.texture && states.texture->m_fboAttachment)
+        applyTexture(NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawElements(const Vertex* vertices, std::size_t vertexCount, const void* indices, std::size_t indexCount,
+                                unsigned int indexType, PrimitiveType type, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0) || !indices || (indexCount == 0))
+        return;
+
+    // Indexed quads would have to be converted to triangles
+    if (type == Quads)
+    {
+        err() << "sf::Quads primitive type is not supported by indexed draws, drawing skipped" << std::endl;
+        return;
+    }
+
+    if (setActive(true))
+    {
+        SFML_PROFILE_ZONE("RenderTarget::draw");
+        SFML_PROFILE_COUNTER("Draw calls", 1);
+
+        setupDraw(vertices, vertexCount, states);
+
+        // Draw the primitives
+        glCheck(glDrawElements(modes[type], static_cast<GLsizei>(indexCount), indexType, indices));
+
+        cleanupDraw(states);
+    }
 }
 
 } // namespace sf
@@ -0,0 +1,391 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+
+namespace
+{
+    // Each sprite is a quad, that the render target draws as 2 indexed triangles
+    const std::size_t verticesPerSprite = 4;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() :
+m_texture             (NULL),
+m_positions           (),
+m_origins             (),
+m_scales              (),
+m_rotations           (),
+m_cosines             (),
+m_sines               (),
+m_textureRects        (),
+m_colors              (),
+m_vertices            (),
+m_positionsNeedUpdate (false),
+m_attributesNeedUpdate(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch(const Texture& texture) :
+m_texture             (&texture),
+m_positions           (),
+m_origins             (),
+m_scales              (),
+m_rotations           (),
+m_cosines             (),
+m_sines               (),
+m_textureRects        (),
+m_colors              (),
+m_vertices            (),
+m_positionsNeedUpdate (false),
+m_attributesNeedUpdate(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTexture(const Texture& texture)
+{
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* SpriteBatch::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::add(const IntRect& textureRect, const Vector2f& position, float rotation, const Vector2f& scale, const Color& color)
+{
+    // An empty rectangle selects the whole texture
+    IntRect rectangle = textureRect;
+    if ((rectangle == IntRect()) && m_texture)
+        rectangle = IntRect(0, 0, m_texture->getSize().x, m_texture->getSize().y);
+
+    m_positions.push_back(position);
+    m_origins.push_back(Vector2f(0, 0));
+    m_scales.push_back(scale);
+    m_rotations.push_back(0.f);
+    m_cosines.push_back(1.f);
+    m_sines.push_back(0.f);
+    m_textureRects.push_back(rectangle);
+    m_colors.push_back(color);
+
+    std::size_t index = m_positions.size() - 1;
+    if (rotation != 0.f)
+        setRotation(index, rotation);
+
+    m_vertices.resize(m_positions.size() * verticesPerSprite);
+    m_positionsNeedUpdate = true;
+    m_attributesNeedUpdate = true;
+
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::remove(std::size_t index)
+{
+    std::size_t last = m_positions.size() - 1;
+    if (index != last)
+    {
+        m_positions[index]    = m_positions[last];
+        m_origins[index]      = m_origins[last];
+        m_scales[index]       = m_scales[last];
+        m_rotations[index]    = m_rotations[last];
+        m_cosines[index]      = m_cosines[last];
+        m_sines[index]        = m_sines[last];
+        m_textureRects[index] = m_textureRects[last];
+        m_colors[index]       = m_colors[last];
+    }
+
+    m_positions.pop_back();
+    m_origins.pop_back();
+    m_scales.pop_back();
+    m_rotations.pop_back();
+    m_cosines.pop_back();
+    m_sines.pop_back();
+    m_textureRects.pop_back();
+    m_colors.pop_back();
+
+    m_vertices.resize(m_positions.size() * verticesPerSprite);
+    m_positionsNeedUpdate = true;
+    m_attributesNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear()
+{
+    m_positions.clear();
+    m_origins.clear();
+    m_scales.clear();
+    m_rotations.clear();
+    m_cosines.clear();
+    m_sines.clear();
+    m_textureRects.clear();
+    m_colors.clear();
+    m_vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::reserve(std::size_t count)
+{
+    m_positions.reserve(count);
+    m_origins.reserve(count);
+    m_scales.reserve(count);
+    m_rotations.reserve(count);
+    m_cosines.reserve(count);
+    m_sines.reserve(count);
+    m_textureRects.reserve(count);
+    m_colors.reserve(count);
+    m_vertices.reserve(count * verticesPerSprite);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getSpriteCount() const
+{
+    return m_positions.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setPosition(std::size_t index, const Vector2f& position)
+{
+    m_positions[index] = position;
+    m_positionsNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& SpriteBatch::getPosition(std::size_t index) const
+{
+    return m_positions[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setRotation(std::size_t index, float angle)
+{
+    float rotation = static_cast<float>(std::fmod(angle, 360));
+    if (rotation < 0)
+        rotation += 360.f;
+
+    // The sine and cosine are computed here rather than for every sprite when the vertices are updated
+    float radians = rotation * 3.141592654f / 180.f;
+    m_rotations[index] = rotation;
+    m_cosines[index] = static_cast<float>(std::cos(radians));
+    m_sines[index] = static_cast<float>(std::sin(radians));
+    m_positionsNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+float SpriteBatch::getRotation(std::size_t index) const
+{
+    return m_rotations[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setScale(std::size_t index, const Vector2f& factors)
+{
+    m_scales[index] = factors;
+    m_positionsNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& SpriteBatch::getScale(std::size_t index) const
+{
+    return m_scales[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setOrigin(std::size_t index, const Vector2f& origin)
+{
+    m_origins[index] = origin;
+    m_positionsNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& SpriteBatch::getOrigin(std::size_t index) const
+{
+    return m_origins[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTextureRect(std::size_t index, const IntRect& textureRect)
+{
+    m_textureRects[index] = textureRect;
+    m_positionsNeedUpdate = true;
+    m_attributesNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& SpriteBatch::getTextureRect(std::size_t index) const
+{
+    return m_textureRects[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setColor(std::size_t index, const Color& color)
+{
+    m_colors[index] = color;
+    m_attributesNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& SpriteBatch::getColor(std::size_t index) const
+{
+    return m_colors[index];
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect SpriteBatch::getBounds() const
+{
+    if (m_vertices.empty())
+        return FloatRect();
+
+    ensureVerticesUpdate();
+
+    float left   = m_vertices[0].position.x;
+    float top    = m_vertices[0].position.y;
+    float right  = m_vertices[0].position.x;
+    float bottom = m_vertices[0].position.y;
+
+    for (std::size_t i = 1; i < m_vertices.size(); ++i)
+    {
+        Vector2f position = m_vertices[i].position;
+
+        left   = std::min(left, position.x);
+        right  = std::max(right, position.x);
+        top    = std::min(top, position.y);
+        bottom = std::max(bottom, position.y);
+    }
+
+    return FloatRect(left, top, right - left, bottom - top);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_texture && !m_vertices.empty())
+    {
+        ensureVerticesUpdate();
+
+        states.texture = m_texture;
+        target.draw(&m_vertices[0], m_vertices.size(), Quads, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::ensureVerticesUpdate() const
+{
+    std::size_t count = m_positions.size();
+
+    if (m_positionsNeedUpdate)
+    {
+        // The corners of a sprite are (0, 0), (w, 0), (0, h) and (w, h), transformed by
+        // its origin, scale, rotation and position: the first corner plus a combination
+        // of the two transformed axes. The loop reads each attribute array linearly and
+        // has no branch, so that the compiler can vectorize the arithmetic part.
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float width  = static_cast<float>(std::abs(m_textureRects[i].width));
+            float height = static_cast<float>(std::abs(m_textureRects[i].height));
+
+            float axisXx =  m_scales[i].x * m_cosines[i];
+            float axisXy =  m_scales[i].x * m_sines[i];
+            float axisYx = -m_scales[i].y * m_sines[i];
+            float axisYy =  m_scales[i].y * m_cosines[i];
+
+            Vector2f topLeft(m_positions[i].x - m_origins[i].x * axisXx - m_origins[i].y * axisYx,
+                             m_positions[i].y - m_origins[i].x * axisXy - m_origins[i].y * axisYy);
+            Vector2f right(width * axisXx, width * axisXy);
+            Vector2f down(height * axisYx, height * axisYy);
+
+            Vertex* vertices = &m_vertices[i * verticesPerSprite];
+            vertices[0].position = topLeft;
+            vertices[1].position = topLeft + right;
+            vertices[2].position = topLeft + right + down;
+            vertices[3].position = topLeft + down;
+        }
+
+        m_positionsNeedUpdate = false;
+    }
+
+    if (m_attributesNeedUpdate)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float left   = static_cast<float>(m_textureRects[i].left);
+            float right  = left + m_textureRects[i].width;
+            float top    = static_cast<float>(m_textureRects[i].top);
+            float bottom = top + m_textureRects[i].height;
+            Color color  = m_colors[i];
+
+            Vertex* vertices = &m_vertices[i * verticesPerSprite];
+            vertices[0].texCoords = Vector2f(left, top);
+            vertices[1].texCoords = Vector2f(right, top);
+            vertices[2].texCoords = Vector2f(right, bottom);
+            vertices[3].texCoords = Vector2f(left, bottom);
+
+            for (std::size_t j = 0; j < verticesPerSprite; ++j)
+                vertices[j].color = color;
+        }
+
+        m_attributesNeedUpdate = false;
+    }
+}
+
+} // namespace sf
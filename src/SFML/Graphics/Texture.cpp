@@ -29,11 +29,14 @@
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/FramebufferCache.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -243,8 +246,30 @@ bool Texture::loadFromStream(InputStream& stream, const IntRect& area)
 
 
 ////////////////////////////////////////////////////////////
-bool Texture::loadFromImage(const Image& image, const IntRect& area)
+bool Texture::loadFromImage(const Image& image, const IntRect& area, bool buildMipmap)
 {
+    if (buildMipmap)
+    {
+        // Load the pixels first, then compute the levels from the area actually loaded
+        if (!loadFromImage(image, area, false))
+            return false;
+
+        std::vector<Image> levels;
+        if (m_size == image.getSize())
+        {
+            image.buildMipChain(levels);
+        }
+        else
+        {
+            Image base;
+            base.create(m_size.x, m_size.y);
+            base.copy(image, 0, 0, IntRect(std::max(area.left, 0), std::max(area.top, 0), m_size.x, m_size.y));
+            base.buildMipChain(levels);
+        }
+
+        return updateMipmap(levels);
+    }
+
     // Retrieve the image size
     int width = static_cast<int>(image.getSize().x);
     int height = static_cast<int>(image.getSize().y);
@@ -279,6 +304,9 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
         // Create the texture and upload the pixels
         if (create(rectangle.width, rectangle.height))
         {
+            SFML_PROFILE_ZONE("Texture::update");
+            SFML_PROFILE_COUNTER("Texture upload bytes", static_cast<Int64>(rectangle.width) * rectangle.height * 4);
+
             TransientContextLock lock;
 
             // Make sure that the current texture binding will be preserved
@@ -336,20 +364,7 @@ Image Texture::copyToImage() const
 
     // OpenGL ES doesn't have the glGetTexImage function, the only way to read
     // from a texture is to bind it to a FBO and use glReadPixels
-    GLuint frameBuffer = 0;
-    glCheck(GLEXT_glGenFramebuffers(1, &frameBuffer));
-    if (frameBuffer)
-    {
-        GLint previousFrameBuffer;
-        glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &previousFrameBuffer));
-
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
-        glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0));
-        glCheck(glReadPixels(0, 0, m_size.x, m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
-        glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
-
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFrameBuffer));
-    }
+    priv::readTexturePixels(m_texture, m_size.x, m_size.y, m_pixelsFlipped, &pixels[0]);
 
 #else
 
@@ -415,6 +430,9 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
 
     if (pixels && m_texture)
     {
+        SFML_PROFILE_ZONE("Texture::update");
+        SFML_PROFILE_COUNTER("Texture upload bytes", static_cast<Int64>(width) * height * 4);
+
         TransientContextLock lock;
 
         // Make sure that the current texture binding will be preserved
@@ -699,6 +717,89 @@ bool Texture::generateMipmap()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::updateMipmap(const std::vector<Image>& levels)
+{
+    if (!m_texture)
+        return false;
+
+    // Make sure that each level fits in the texture
+    Vector2u size = m_actualSize;
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        size.x = std::max(size.x / 2, 1u);
+        size.y = std::max(size.y / 2, 1u);
+
+        if ((levels[i].getSize().x > size.x) || (levels[i].getSize().y > size.y))
+        {
+            err() << "Failed to update mipmap, level " << (i + 1) << " is too large "
+                  << "(" << levels[i].getSize().x << "x" << levels[i].getSize().y << ", "
+                  << "maximum is " << size.x << "x" << size.y << ")" << std::endl;
+            return false;
+        }
+    }
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // Allocate all the levels down to 1x1, so that the texture is complete,
+    // and fill the ones we have
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    size = m_actualSize;
+    for (GLint level = 1; (size.x > 1) || (size.y > 1); ++level)
+    {
+        size.x = std::max(size.x / 2, 1u);
+        size.y = std::max(size.y / 2, 1u);
+
+        glCheck(glTexImage2D(GL_TEXTURE_2D, level, (m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA), size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+
+        const Image* image = (static_cast<std::size_t>(level) <= levels.size()) ? &levels[level - 1] : NULL;
+        if (image && image->getPixelsPtr())
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, image->getSize().x, image->getSize().y, GL_RGBA, GL_UNSIGNED_BYTE, image->getPixelsPtr()));
+    }
+
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+    m_hasMipmap = true;
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::getTextureMatrix(CoordinateType coordinateType, float* matrix) const
+{
+    static const float identity[16] = {1.f, 0.f, 0.f, 0.f,
+                                       0.f, 1.f, 0.f, 0.f,
+                                       0.f, 0.f, 1.f, 0.f,
+                                       0.f, 0.f, 0.f, 1.f};
+
+    std::memcpy(matrix, identity, sizeof(identity));
+
+    // If non-normalized coordinates (= pixels) are requested, we need to
+    // setup scale factors that convert the range [0 .. size] to [0 .. 1]
+    if (coordinateType == Pixels)
+    {
+        matrix[0] = 1.f / m_actualSize.x;
+        matrix[5] = 1.f / m_actualSize.y;
+    }
+
+    // If pixels are flipped we must invert the Y axis
+    if (m_pixelsFlipped)
+    {
+        matrix[5] = -matrix[5];
+        matrix[13] = static_cast<float>(m_size.y) / m_actualSize.y;
+    }
+
+    return (coordinateType == Pixels) || m_pixelsFlipped;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::invalidateMipmap()
 {
@@ -728,28 +829,9 @@ void Texture::bind(const Texture* texture, CoordinateType coordinateType)
         glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
 
         // Check if we need to define a special texture matrix
-        if ((coordinateType == Pixels) || texture->m_pixelsFlipped)
+        GLfloat matrix[16];
+        if (texture->getTextureMatrix(coordinateType, matrix))
         {
-            GLfloat matrix[16] = {1.f, 0.f, 0.f, 0.f,
-                                  0.f, 1.f, 0.f, 0.f,
-                                  0.f, 0.f, 1.f, 0.f,
-                                  0.f, 0.f, 0.f, 1.f};
-
-            // If non-normalized coordinates (= pixels) are requested, we need to
-            // setup scale factors that convert the range [0 .. size] to [0 .. 1]
-            if (coordinateType == Pixels)
-            {
-                matrix[0] = 1.f / texture->m_actualSize.x;
-                matrix[5] = 1.f / texture->m_actualSize.y;
-            }
-
-            // If pixels are flipped we must invert the Y axis
-            if (texture->m_pixelsFlipped)
-            {
-                matrix[5] = -matrix[5];
-                matrix[13] = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
-            }
-
             // Load the matrix
             glCheck(glMatrixMode(GL_TEXTURE));
             glCheck(glLoadMatrixf(matrix));
@@ -28,6 +28,41 @@
 #include <SFML/Graphics/Transform.hpp>
 #include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_TRANSFORM_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_TRANSFORM_NEON
+#endif
+
+
+namespace
+{
+    // Multiply a 4x4 matrix, in place, by the 4x4 form of an affine 2D transform:
+    //
+    //   | b00 b01 b02 |
+    //   | b10 b11 b12 |
+    //   |  0   0   1  |
+    //
+    // Only the 6 meaningful coefficients of each of the 3 rows are computed,
+    // instead of a full 3x3 multiplication (this is exact for any left matrix)
+    void combineAffine(float* m, float b00, float b01, float b02,
+                                 float b10, float b11, float b12)
+    {
+        const int rows[] = {0, 1, 3};
+        for (int i = 0; i < 3; ++i)
+        {
+            float* row = m + rows[i];
+            float a0 = row[0];
+            float a1 = row[4];
+            row[0]   = a0 * b00 + a1 * b10;
+            row[4]   = a0 * b01 + a1 * b11;
+            row[12] += a0 * b02 + a1 * b12;
+        }
+    }
+}
+
 
 namespace sf
 {
@@ -109,17 +144,74 @@ Vector2f Transform::transformPoint(const Vector2f& point) const
 }
 
 
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vector2f* points, Vector2f* result, std::size_t count) const
+{
+    const float a00 = m_matrix[0];
+    const float a01 = m_matrix[4];
+    const float a02 = m_matrix[12];
+    const float a10 = m_matrix[1];
+    const float a11 = m_matrix[5];
+    const float a12 = m_matrix[13];
+
+    std::size_t i = 0;
+
+#if defined(SFML_TRANSFORM_SSE2)
+
+    // Two interleaved points per register: x0 y0 x1 y1
+    const __m128 colX = _mm_setr_ps(a00, a10, a00, a10);
+    const __m128 colY = _mm_setr_ps(a01, a11, a01, a11);
+    const __m128 offset = _mm_setr_ps(a02, a12, a02, a12);
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128 xy = _mm_loadu_ps(&points[i].x);
+        __m128 xx = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 yy = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 transformed = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xx, colX), _mm_mul_ps(yy, colY)), offset);
+        _mm_storeu_ps(&result[i].x, transformed);
+    }
+
+#elif defined(SFML_TRANSFORM_NEON)
+
+    // Four points per iteration, deinterleaved into an x and a y register; the
+    // operations are done in the same order as in transformPoint, so that the
+    // results are the same
+    const float32x4_t offsetX = vdupq_n_f32(a02);
+    const float32x4_t offsetY = vdupq_n_f32(a12);
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4x2_t xy = vld2q_f32(&points[i].x);
+        float32x4x2_t transformed;
+        transformed.val[0] = vaddq_f32(vaddq_f32(vmulq_n_f32(xy.val[0], a00), vmulq_n_f32(xy.val[1], a01)), offsetX);
+        transformed.val[1] = vaddq_f32(vaddq_f32(vmulq_n_f32(xy.val[0], a10), vmulq_n_f32(xy.val[1], a11)), offsetY);
+        vst2q_f32(&result[i].x, transformed);
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        float x = points[i].x;
+        float y = points[i].y;
+        result[i].x = a00 * x + a01 * y + a02;
+        result[i].y = a10 * x + a11 * y + a12;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Transform::transformRect(const FloatRect& rectangle) const
 {
-    // Transform the 4 corners of the rectangle
-    const Vector2f points[] =
+    // Transform the 4 corners of the rectangle in a single batch
+    const Vector2f corners[] =
     {
-        transformPoint(rectangle.left, rectangle.top),
-        transformPoint(rectangle.left, rectangle.top + rectangle.height),
-        transformPoint(rectangle.left + rectangle.width, rectangle.top),
-        transformPoint(rectangle.left + rectangle.width, rectangle.top + rectangle.height)
+        Vector2f(rectangle.left, rectangle.top),
+        Vector2f(rectangle.left, rectangle.top + rectangle.height),
+        Vector2f(rectangle.left + rectangle.width, rectangle.top),
+        Vector2f(rectangle.left + rectangle.width, rectangle.top + rectangle.height)
     };
+    Vector2f points[4];
+    transformPoints(corners, points, 4);
 
     // Compute the bounding rectangle of the transformed points
     float left = points[0].x;
@@ -144,6 +236,14 @@ Transform& Transform::combine(const Transform& transform)
     const float* a = m_matrix;
     const float* b = transform.m_matrix;
 
+    // Most transforms are affine: skip the projective part of the multiplication
+    if ((b[3] == 0.f) && (b[7] == 0.f) && (b[15] == 1.f))
+    {
+        combineAffine(m_matrix, b[0], b[4], b[12],
+                                b[1], b[5], b[13]);
+        return *this;
+    }
+
     *this = Transform(a[0] * b[0]  + a[4] * b[1]  + a[12] * b[3],
                       a[0] * b[4]  + a[4] * b[5]  + a[12] * b[7],
                       a[0] * b[12] + a[4] * b[13] + a[12] * b[15],
@@ -161,11 +261,12 @@ Transform& Transform::combine(const Transform& transform)
 ////////////////////////////////////////////////////////////
 Transform& Transform::translate(float x, float y)
 {
-    Transform translation(1, 0, x,
-                          0, 1, y,
-                          0, 0, 1);
+    // Only the last column changes
+    m_matrix[12] += m_matrix[0] * x + m_matrix[4] * y;
+    m_matrix[13] += m_matrix[1] * x + m_matrix[5] * y;
+    m_matrix[15] += m_matrix[3] * x + m_matrix[7] * y;
 
-    return combine(translation);
+    return *this;
 }
 
 
@@ -183,11 +284,10 @@ Transform& Transform::rotate(float angle)
     float cos = std::cos(rad);
     float sin = std::sin(rad);
 
-    Transform rotation(cos, -sin, 0,
-                       sin,  cos, 0,
-                       0,    0,   1);
+    combineAffine(m_matrix, cos, -sin, 0,
+                            sin,  cos, 0);
 
-    return combine(rotation);
+    return *this;
 }
 
 
@@ -198,11 +298,10 @@ Transform& Transform::rotate(float angle, float centerX, float centerY)
     float cos = std::cos(rad);
     float sin = std::sin(rad);
 
-    Transform rotation(cos, -sin, centerX * (1 - cos) + centerY * sin,
-                       sin,  cos, centerY * (1 - cos) - centerX * sin,
-                       0,    0,   1);
+    combineAffine(m_matrix, cos, -sin, centerX * (1 - cos) + centerY * sin,
+                            sin,  cos, centerY * (1 - cos) - centerX * sin);
 
-    return combine(rotation);
+    return *this;
 }
 
 
@@ -216,22 +315,22 @@ Transform& Transform::rotate(float angle, const Vector2f& center)
 ////////////////////////////////////////////////////////////
 Transform& Transform::scale(float scaleX, float scaleY)
 {
-    Transform scaling(scaleX, 0,      0,
-                      0,      scaleY, 0,
-                      0,      0,      1);
+    // Only the first two columns change
+    m_matrix[0] *= scaleX; m_matrix[4] *= scaleY;
+    m_matrix[1] *= scaleX; m_matrix[5] *= scaleY;
+    m_matrix[3] *= scaleX; m_matrix[7] *= scaleY;
 
-    return combine(scaling);
+    return *this;
 }
 
 
 ////////////////////////////////////////////////////////////
 Transform& Transform::scale(float scaleX, float scaleY, float centerX, float centerY)
 {
-    Transform scaling(scaleX, 0,      centerX * (1 - scaleX),
-                      0,      scaleY, centerY * (1 - scaleY),
-                      0,      0,      1);
+    combineAffine(m_matrix, scaleX, 0,      centerX * (1 - scaleX),
+                            0,      scaleY, centerY * (1 - scaleY));
 
-    return combine(scaling);
+    return *this;
 }
 
 
@@ -26,19 +26,30 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Packet.hpp>
+#include <SFML/Network/PacketPipeline.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Err.hpp>
 #include <cstring>
 #include <cwchar>
 
 
+namespace
+{
+    // Sent in place of the encoded data when the pipeline encoded a packet
+    // to nothing, so that the sockets don't mistake it for an encoding failure
+    const char emptyData = 0;
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Packet::Packet() :
-m_readPos(0),
-m_sendPos(0),
-m_isValid(true)
+m_readPos (0),
+m_sendPos (0),
+m_isValid (true),
+m_pipeline(NULL)
 {
 
 }
@@ -93,6 +104,20 @@ bool Packet::endOfPacket() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Packet::setPipeline(PacketPipeline* pipeline)
+{
+    m_pipeline = pipeline;
+}
+
+
+////////////////////////////////////////////////////////////
+PacketPipeline* Packet::getPipeline() const
+{
+    return m_pipeline;
+}
+
+
 ////////////////////////////////////////////////////////////
 Packet::operator BoolType() const
 {
@@ -582,15 +607,47 @@ bool Packet::checkSize(std::size_t size)
 ////////////////////////////////////////////////////////////
 const void* Packet::onSend(std::size_t& size)
 {
-    size = getDataSize();
-    return getData();
+    if (!m_pipeline)
+    {
+        size = getDataSize();
+        return getData();
+    }
+
+    // When resuming a partial send, the data must not be encoded again:
+    // some transforms (like encryption) don't produce the same output twice
+    if ((m_sendPos == 0) && !m_pipeline->encode(getData(), getDataSize(), m_encoded))
+    {
+        err() << "Failed to send packet (the packet pipeline couldn't encode its data)" << std::endl;
+        m_encoded.clear();
+        size = 0;
+        return NULL;
+    }
+
+    size = m_encoded.size();
+    return !m_encoded.empty() ? &m_encoded[0] : &emptyData;
 }
 
 
 ////////////////////////////////////////////////////////////
 void Packet::onReceive(const void* data, std::size_t size)
 {
-    append(data, size);
+    if (!m_pipeline)
+    {
+        append(data, size);
+        return;
+    }
+
+    const char* decoded = NULL;
+    std::size_t decodedSize = 0;
+    if (m_pipeline->decode(data, size, decoded, decodedSize))
+    {
+        append(decoded, decodedSize);
+    }
+    else
+    {
+        clear();
+        m_isValid = false;
+    }
 }
 
 } // namespace sf
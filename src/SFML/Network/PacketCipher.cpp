@@ -0,0 +1,435 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/PacketCipher.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+    #include <ntsecapi.h>
+#else
+    #include <cstdio>
+#endif
+
+
+namespace
+{
+    const std::size_t nonceSize = 12;
+    const std::size_t tagSize   = 16;
+    const std::size_t blockSize = 64;
+
+    sf::Uint32 load32(const sf::Uint8* data)
+    {
+        return static_cast<sf::Uint32>(data[0])         |
+               (static_cast<sf::Uint32>(data[1]) << 8)  |
+               (static_cast<sf::Uint32>(data[2]) << 16) |
+               (static_cast<sf::Uint32>(data[3]) << 24);
+    }
+
+    void store32(sf::Uint8* data, sf::Uint32 value)
+    {
+        data[0] = static_cast<sf::Uint8>(value);
+        data[1] = static_cast<sf::Uint8>(value >> 8);
+        data[2] = static_cast<sf::Uint8>(value >> 16);
+        data[3] = static_cast<sf::Uint8>(value >> 24);
+    }
+
+    void store64(sf::Uint8* data, sf::Uint64 value)
+    {
+        store32(data, static_cast<sf::Uint32>(value));
+        store32(data + 4, static_cast<sf::Uint32>(value >> 32));
+    }
+
+    // Fill a buffer with bytes from the system's cryptographically secure generator
+    bool generateRandom(void* data, std::size_t size)
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+        return RtlGenRandom(data, static_cast<ULONG>(size)) != FALSE;
+    #else
+        std::FILE* file = std::fopen("/dev/urandom", "rb");
+        if (!file)
+            return false;
+
+        std::size_t read = std::fread(data, 1, size, file);
+        std::fclose(file);
+
+        return read == size;
+    #endif
+    }
+
+    sf::Uint32 rotate(sf::Uint32 value, int bits)
+    {
+        return (value << bits) | (value >> (32 - bits));
+    }
+
+    void quarterRound(sf::Uint32* x, int a, int b, int c, int d)
+    {
+        x[a] += x[b]; x[d] = rotate(x[d] ^ x[a], 16);
+        x[c] += x[d]; x[b] = rotate(x[b] ^ x[c], 12);
+        x[a] += x[b]; x[d] = rotate(x[d] ^ x[a], 8);
+        x[c] += x[d]; x[b] = rotate(x[b] ^ x[c], 7);
+    }
+
+    // Generate a 64-bytes block of ChaCha20 key stream
+    void chachaBlock(const sf::Uint32* key, sf::Uint32 counter, const sf::Uint32* nonce, sf::Uint8* output)
+    {
+        sf::Uint32 input[16] =
+        {
+            0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+            key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+            counter, nonce[0], nonce[1], nonce[2]
+        };
+
+        sf::Uint32 x[16];
+        std::memcpy(x, input, sizeof(x));
+
+        for (int i = 0; i < 10; ++i)
+        {
+            quarterRound(x, 0, 4,  8, 12);
+            quarterRound(x, 1, 5,  9, 13);
+            quarterRound(x, 2, 6, 10, 14);
+            quarterRound(x, 3, 7, 11, 15);
+            quarterRound(x, 0, 5, 10, 15);
+            quarterRound(x, 1, 6, 11, 12);
+            quarterRound(x, 2, 7,  8, 13);
+            quarterRound(x, 3, 4,  9, 14);
+        }
+
+        for (int i = 0; i < 16; ++i)
+            store32(output + i * 4, x[i] + input[i]);
+    }
+
+    // XOR data with the key stream, starting at block 1 (block 0 is used for the MAC key)
+    void chachaXor(const sf::Uint32* key, const sf::Uint32* nonce, const sf::Uint8* input, sf::Uint8* output, std::size_t size)
+    {
+        sf::Uint8 stream[blockSize];
+        sf::Uint32 counter = 1;
+
+        while (size > 0)
+        {
+            chachaBlock(key, counter++, nonce, stream);
+
+            std::size_t count = size < blockSize ? size : blockSize;
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = input[i] ^ stream[i];
+
+            input += count;
+            output += count;
+            size -= count;
+        }
+    }
+
+    // Poly1305 one-time authenticator, using 26-bits limbs
+    class Poly1305
+    {
+    public:
+
+        explicit Poly1305(const sf::Uint8* key) :
+        m_leftover(0)
+        {
+            m_r[0] = (load32(key + 0))      & 0x3ffffff;
+            m_r[1] = (load32(key + 3) >> 2) & 0x3ffff03;
+            m_r[2] = (load32(key + 6) >> 4) & 0x3ffc0ff;
+            m_r[3] = (load32(key + 9) >> 6) & 0x3f03fff;
+            m_r[4] = (load32(key + 12) >> 8) & 0x00fffff;
+
+            for (int i = 0; i < 5; ++i)
+                m_h[i] = 0;
+
+            for (int i = 0; i < 4; ++i)
+                m_pad[i] = load32(key + 16 + i * 4);
+        }
+
+        void update(const sf::Uint8* data, std::size_t size)
+        {
+            // Complete the pending block first
+            if (m_leftover > 0)
+            {
+                std::size_t count = tagSize - m_leftover;
+                if (count > size)
+                    count = size;
+                std::memcpy(m_buffer + m_leftover, data, count);
+                m_leftover += count;
+                data += count;
+                size -= count;
+
+                if (m_leftover < tagSize)
+                    return;
+
+                block(m_buffer, 1 << 24);
+                m_leftover = 0;
+            }
+
+            while (size >= tagSize)
+            {
+                block(data, 1 << 24);
+                data += tagSize;
+                size -= tagSize;
+            }
+
+            if (size > 0)
+            {
+                std::memcpy(m_buffer, data, size);
+                m_leftover = size;
+            }
+        }
+
+        // Pad the authenticated data to a multiple of 16 bytes, as required by the AEAD construction
+        void pad()
+        {
+            if (m_leftover > 0)
+            {
+                std::memset(m_buffer + m_leftover, 0, tagSize - m_leftover);
+                block(m_buffer, 1 << 24);
+                m_leftover = 0;
+            }
+        }
+
+        void finish(sf::Uint8* tag)
+        {
+            if (m_leftover > 0)
+            {
+                m_buffer[m_leftover] = 1;
+                std::memset(m_buffer + m_leftover + 1, 0, tagSize - m_leftover - 1);
+                block(m_buffer, 0);
+            }
+
+            sf::Uint32 h0 = m_h[0], h1 = m_h[1], h2 = m_h[2], h3 = m_h[3], h4 = m_h[4];
+
+            // Fully carry h
+            sf::Uint32 c;
+                         c = h1 >> 26; h1 &= 0x3ffffff;
+            h2 += c;     c = h2 >> 26; h2 &= 0x3ffffff;
+            h3 += c;     c = h3 >> 26; h3 &= 0x3ffffff;
+            h4 += c;     c = h4 >> 26; h4 &= 0x3ffffff;
+            h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+            h1 += c;
+
+            // Compute h + -p
+            sf::Uint32 g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3ffffff;
+            sf::Uint32 g1 = h1 + c; c = g1 >> 26; g1 &= 0x3ffffff;
+            sf::Uint32 g2 = h2 + c; c = g2 >> 26; g2 &= 0x3ffffff;
+            sf::Uint32 g3 = h3 + c; c = g3 >> 26; g3 &= 0x3ffffff;
+            sf::Uint32 g4 = h4 + c - (1UL << 26);
+
+            // Select h if h < p, or h + -p if h >= p, in constant time
+            sf::Uint32 mask = (g4 >> 31) - 1;
+            g0 &= mask; g1 &= mask; g2 &= mask; g3 &= mask; g4 &= mask;
+            mask = ~mask;
+            h0 = (h0 & mask) | g0;
+            h1 = (h1 & mask) | g1;
+            h2 = (h2 & mask) | g2;
+            h3 = (h3 & mask) | g3;
+            h4 = (h4 & mask) | g4;
+
+            // h = h % 2^128
+            h0 = h0         | (h1 << 26);
+            h1 = (h1 >> 6)  | (h2 << 20);
+            h2 = (h2 >> 12) | (h3 << 14);
+            h3 = (h3 >> 18) | (h4 << 8);
+
+            // tag = (h + pad) % 2^128
+            sf::Uint64 f;
+            f = static_cast<sf::Uint64>(h0) + m_pad[0];             h0 = static_cast<sf::Uint32>(f);
+            f = static_cast<sf::Uint64>(h1) + m_pad[1] + (f >> 32); h1 = static_cast<sf::Uint32>(f);
+            f = static_cast<sf::Uint64>(h2) + m_pad[2] + (f >> 32); h2 = static_cast<sf::Uint32>(f);
+            f = static_cast<sf::Uint64>(h3) + m_pad[3] + (f >> 32); h3 = static_cast<sf::Uint32>(f);
+
+            store32(tag + 0, h0);
+            store32(tag + 4, h1);
+            store32(tag + 8, h2);
+            store32(tag + 12, h3);
+        }
+
+    private:
+
+        void block(const sf::Uint8* data, sf::Uint32 highBit)
+        {
+            const sf::Uint32 r0 = m_r[0], r1 = m_r[1], r2 = m_r[2], r3 = m_r[3], r4 = m_r[4];
+            const sf::Uint32 s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+
+            sf::Uint32 h0 = m_h[0], h1 = m_h[1], h2 = m_h[2], h3 = m_h[3], h4 = m_h[4];
+
+            // h += m[i]
+            h0 += (load32(data + 0))       & 0x3ffffff;
+            h1 += (load32(data + 3)  >> 2) & 0x3ffffff;
+            h2 += (load32(data + 6)  >> 4) & 0x3ffffff;
+            h3 += (load32(data + 9)  >> 6) & 0x3ffffff;
+            h4 += (load32(data + 12) >> 8) | highBit;
+
+            // h *= r
+            sf::Uint64 d0 = static_cast<sf::Uint64>(h0) * r0 + static_cast<sf::Uint64>(h1) * s4 + static_cast<sf::Uint64>(h2) * s3 + static_cast<sf::Uint64>(h3) * s2 + static_cast<sf::Uint64>(h4) * s1;
+            sf::Uint64 d1 = static_cast<sf::Uint64>(h0) * r1 + static_cast<sf::Uint64>(h1) * r0 + static_cast<sf::Uint64>(h2) * s4 + static_cast<sf::Uint64>(h3) * s3 + static_cast<sf::Uint64>(h4) * s2;
+            sf::Uint64 d2 = static_cast<sf::Uint64>(h0) * r2 + static_cast<sf::Uint64>(h1) * r1 + static_cast<sf::Uint64>(h2) * r0 + static_cast<sf::Uint64>(h3) * s4 + static_cast<sf::Uint64>(h4) * s3;
+            sf::Uint64 d3 = static_cast<sf::Uint64>(h0) * r3 + static_cast<sf::Uint64>(h1) * r2 + static_cast<sf::Uint64>(h2) * r1 + static_cast<sf::Uint64>(h3) * r0 + static_cast<sf::Uint64>(h4) * s4;
+            sf::Uint64 d4 = static_cast<sf::Uint64>(h0) * r4 + static_cast<sf::Uint64>(h1) * r3 + static_cast<sf::Uint64>(h2) * r2 + static_cast<sf::Uint64>(h3) * r1 + static_cast<sf::Uint64>(h4) * r0;
+
+            // Partial reduction mod 2^130 - 5
+            sf::Uint32 c;
+            c = static_cast<sf::Uint32>(d0 >> 26); h0 = static_cast<sf::Uint32>(d0) & 0x3ffffff;
+            d1 += c;
+            c = static_cast<sf::Uint32>(d1 >> 26); h1 = static_cast<sf::Uint32>(d1) & 0x3ffffff;
+            d2 += c;
+            c = static_cast<sf::Uint32>(d2 >> 26); h2 = static_cast<sf::Uint32>(d2) & 0x3ffffff;
+            d3 += c;
+            c = static_cast<sf::Uint32>(d3 >> 26); h3 = static_cast<sf::Uint32>(d3) & 0x3ffffff;
+            d4 += c;
+            c = static_cast<sf::Uint32>(d4 >> 26); h4 = static_cast<sf::Uint32>(d4) & 0x3ffffff;
+            h0 += c * 5;
+            c = h0 >> 26; h0 &= 0x3ffffff;
+            h1 += c;
+
+            m_h[0] = h0; m_h[1] = h1; m_h[2] = h2; m_h[3] = h3; m_h[4] = h4;
+        }
+
+        sf::Uint32  m_r[5];
+        sf::Uint32  m_h[5];
+        sf::Uint32  m_pad[4];
+        sf::Uint8   m_buffer[16];
+        std::size_t m_leftover;
+    };
+
+    // Compute the AEAD tag of a ciphertext (without additional data)
+    void computeTag(const sf::Uint32* key, const sf::Uint32* nonce, const sf::Uint8* cipherText, std::size_t size, sf::Uint8* tag)
+    {
+        sf::Uint8 macKey[blockSize];
+        chachaBlock(key, 0, nonce, macKey);
+
+        Poly1305 mac(macKey);
+        mac.update(cipherText, size);
+        mac.pad();
+
+        sf::Uint8 lengths[16];
+        store64(lengths, 0);
+        store64(lengths + 8, size);
+        mac.update(lengths, sizeof(lengths));
+        mac.finish(tag);
+
+        std::memset(macKey, 0, sizeof(macKey));
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const std::size_t PacketCipher::KeySize;
+const std::size_t PacketCipher::Overhead;
+
+
+////////////////////////////////////////////////////////////
+PacketCipher::PacketCipher(const void* key) :
+m_counter  (0),
+m_hasPrefix(false)
+{
+    const Uint8* bytes = static_cast<const Uint8*>(key);
+    for (int i = 0; i < 8; ++i)
+        m_key[i] = load32(bytes + i * 4);
+
+    m_hasPrefix = generatePrefix();
+}
+
+
+////////////////////////////////////////////////////////////
+bool PacketCipher::encode(const char* data, std::size_t size, std::vector<char>& output)
+{
+    // A counter-only nonce would be reused by every session sharing the key
+    if (!m_hasPrefix)
+    {
+        err() << "Failed to encrypt packet (no random nonce prefix could be generated)" << std::endl;
+        return false;
+    }
+
+    output.resize(nonceSize + size + tagSize);
+    Uint8* out = reinterpret_cast<Uint8*>(&output[0]);
+
+    // Build a nonce that is never reused with this key: random session prefix + packet counter
+    Uint32 nonce[3] = {m_prefix[0], m_prefix[1], m_counter};
+
+    // Switch to a new prefix before the counter repeats
+    if (++m_counter == 0)
+        m_hasPrefix = generatePrefix();
+
+    for (int i = 0; i < 3; ++i)
+        store32(out + i * 4, nonce[i]);
+
+    chachaXor(m_key, nonce, reinterpret_cast<const Uint8*>(data), out + nonceSize, size);
+    computeTag(m_key, nonce, out + nonceSize, size, out + nonceSize + size);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PacketCipher::decode(const char* data, std::size_t size, std::vector<char>& output)
+{
+    if (size < nonceSize + tagSize)
+        return false;
+
+    const Uint8* in = reinterpret_cast<const Uint8*>(data);
+    const Uint8* cipherText = in + nonceSize;
+    std::size_t cipherSize = size - nonceSize - tagSize;
+
+    Uint32 nonce[3] = {load32(in), load32(in + 4), load32(in + 8)};
+
+    // Check the tag before decrypting anything, in constant time
+    Uint8 tag[tagSize];
+    computeTag(m_key, nonce, cipherText, cipherSize, tag);
+
+    Uint8 difference = 0;
+    for (std::size_t i = 0; i < tagSize; ++i)
+        difference |= tag[i] ^ cipherText[cipherSize + i];
+
+    if (difference != 0)
+        return false;
+
+    output.resize(cipherSize);
+    if (cipherSize > 0)
+        chachaXor(m_key, nonce, cipherText, reinterpret_cast<Uint8*>(&output[0]), cipherSize);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PacketCipher::generatePrefix()
+{
+    Uint8 bytes[8];
+    if (!generateRandom(bytes, sizeof(bytes)))
+    {
+        err() << "Failed to generate the nonce prefix of a packet cipher (the system's random generator failed)" << std::endl;
+        return false;
+    }
+
+    m_prefix[0] = load32(bytes);
+    m_prefix[1] = load32(bytes + 4);
+
+    return true;
+}
+
+} // namespace sf
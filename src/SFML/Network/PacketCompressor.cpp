@@ -0,0 +1,328 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/PacketCompressor.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Header written in front of the encoded data
+    const sf::Uint8   methodStored = 0;
+    const sf::Uint8   methodLz4    = 1;
+    const std::size_t headerSize   = 5; // method + original size (32 bits)
+
+    // Constants of the LZ4 block format
+    const unsigned int hashBits       = 12;
+    const std::size_t  minMatch       = 4;
+    const std::size_t  lastLiterals   = 5;
+    const std::size_t  matchFindLimit = 12;
+    const std::size_t  maxOffset      = 65535;
+    const std::size_t  maxRatio       = 255;
+
+    // Read 4 unaligned bytes
+    sf::Uint32 read32(const sf::Uint8* data)
+    {
+        sf::Uint32 value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    // Hash a 4-bytes sequence to an index in the match finder table
+    sf::Uint32 hashSequence(sf::Uint32 sequence)
+    {
+        return (sequence * 2654435761U) >> (32 - hashBits);
+    }
+
+    // Maximum size of the compressed representation of a block
+    std::size_t compressBound(std::size_t size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    // Write the token nibble and the extra bytes of a length
+    sf::Uint8* writeLength(sf::Uint8* output, std::size_t length)
+    {
+        while (length >= 255)
+        {
+            *output++ = 255;
+            length -= 255;
+        }
+        *output++ = static_cast<sf::Uint8>(length);
+
+        return output;
+    }
+
+    // Read the extra bytes of a length; return false if the input is truncated
+    bool readLength(const sf::Uint8*& input, const sf::Uint8* inputEnd, std::size_t& length)
+    {
+        sf::Uint8 byte;
+        do
+        {
+            if (input >= inputEnd)
+                return false;
+            byte = *input++;
+            length += byte;
+        }
+        while (byte == 255);
+
+        return true;
+    }
+
+    // Compress a block and return the number of bytes written to output
+    std::size_t compressBlock(const sf::Uint8* input, std::size_t size, sf::Uint8* output, sf::Uint32* table)
+    {
+        const sf::Uint8* ip     = input;
+        const sf::Uint8* anchor = input;
+        const sf::Uint8* end    = input + size;
+        sf::Uint8*       op     = output;
+
+        if (size > matchFindLimit)
+        {
+            const sf::Uint8* matchFindEnd = end - matchFindLimit;
+            const sf::Uint8* matchEnd     = end - lastLiterals;
+            std::size_t      misses       = 0;
+
+            while (ip < matchFindEnd)
+            {
+                sf::Uint32 sequence = read32(ip);
+                sf::Uint32 hash = hashSequence(sequence);
+                const sf::Uint8* ref = input + table[hash];
+                table[hash] = static_cast<sf::Uint32>(ip - input);
+
+                if ((ref >= ip) || (static_cast<std::size_t>(ip - ref) > maxOffset) || (read32(ref) != sequence))
+                {
+                    // Skip faster over data that doesn't compress
+                    ip += 1 + (misses++ >> 6);
+                    continue;
+                }
+
+                // Extend the match as far as possible
+                const sf::Uint8* matchPos = ip + minMatch;
+                const sf::Uint8* refPos = ref + minMatch;
+                while ((matchPos < matchEnd) && (*matchPos == *refPos))
+                {
+                    ++matchPos;
+                    ++refPos;
+                }
+
+                std::size_t literalLength = static_cast<std::size_t>(ip - anchor);
+                std::size_t matchLength = static_cast<std::size_t>(matchPos - ip) - minMatch;
+                std::size_t offset = static_cast<std::size_t>(ip - ref);
+
+                // Emit the sequence: token, literals, offset, match length
+                sf::Uint8* token = op++;
+                *token = static_cast<sf::Uint8>((std::min<std::size_t>(literalLength, 15) << 4) | std::min<std::size_t>(matchLength, 15));
+                if (literalLength >= 15)
+                    op = writeLength(op, literalLength - 15);
+                std::memcpy(op, anchor, literalLength);
+                op += literalLength;
+                *op++ = static_cast<sf::Uint8>(offset & 0xFF);
+                *op++ = static_cast<sf::Uint8>(offset >> 8);
+                if (matchLength >= 15)
+                    op = writeLength(op, matchLength - 15);
+
+                ip = matchPos;
+                anchor = ip;
+                misses = 0;
+            }
+        }
+
+        // Emit the remaining bytes as literals
+        std::size_t literalLength = static_cast<std::size_t>(end - anchor);
+        *op++ = static_cast<sf::Uint8>(std::min<std::size_t>(literalLength, 15) << 4);
+        if (literalLength >= 15)
+            op = writeLength(op, literalLength - 15);
+        std::memcpy(op, anchor, literalLength);
+        op += literalLength;
+
+        return static_cast<std::size_t>(op - output);
+    }
+
+    // Decompress a block, checking every access against the bounds of the buffers
+    bool decompressBlock(const sf::Uint8* input, std::size_t size, sf::Uint8* output, std::size_t outputSize)
+    {
+        const sf::Uint8* ip        = input;
+        const sf::Uint8* inputEnd  = input + size;
+        sf::Uint8*       op        = output;
+        sf::Uint8*       outputEnd = output + outputSize;
+
+        for (;;)
+        {
+            if (ip >= inputEnd)
+                return false;
+            sf::Uint8 token = *ip++;
+
+            // Copy the literals
+            std::size_t literalLength = token >> 4;
+            if ((literalLength == 15) && !readLength(ip, inputEnd, literalLength))
+                return false;
+            if ((literalLength > static_cast<std::size_t>(inputEnd - ip)) || (literalLength > static_cast<std::size_t>(outputEnd - op)))
+                return false;
+            std::memcpy(op, ip, literalLength);
+            op += literalLength;
+            ip += literalLength;
+
+            // The last sequence only contains literals
+            if (ip == inputEnd)
+                return op == outputEnd;
+
+            // Copy the match
+            if (inputEnd - ip < 2)
+                return false;
+            std::size_t offset = ip[0] | (ip[1] << 8);
+            ip += 2;
+            if ((offset == 0) || (offset > static_cast<std::size_t>(op - output)))
+                return false;
+
+            std::size_t matchLength = token & 15;
+            if ((matchLength == 15) && !readLength(ip, inputEnd, matchLength))
+                return false;
+            matchLength += minMatch;
+            if (matchLength > static_cast<std::size_t>(outputEnd - op))
+                return false;
+
+            const sf::Uint8* match = op - offset;
+            if (offset >= matchLength)
+            {
+                std::memcpy(op, match, matchLength);
+                op += matchLength;
+            }
+            else
+            {
+                // Overlapping copy, used to encode repetitions
+                for (std::size_t i = 0; i < matchLength; ++i)
+                    *op++ = *match++;
+            }
+        }
+    }
+
+    // Write the data as is, after a header byte
+    void store(const char* data, std::size_t size, std::vector<char>& output)
+    {
+        output.resize(size + 1);
+        output[0] = static_cast<char>(methodStored);
+        if (size > 0)
+            std::memcpy(&output[1], data, size);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PacketCompressor::PacketCompressor(std::size_t threshold) :
+m_threshold(threshold),
+m_table    (1 << hashBits)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketCompressor::setThreshold(std::size_t threshold)
+{
+    m_threshold = threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PacketCompressor::getThreshold() const
+{
+    return m_threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PacketCompressor::encode(const char* data, std::size_t size, std::vector<char>& output)
+{
+    // Small packets are not worth compressing; huge ones don't fit the header
+    if ((size < m_threshold) || (size <= matchFindLimit) || (size > 0x7FFFFFFF))
+    {
+        store(data, size, output);
+        return true;
+    }
+
+    output.resize(headerSize + compressBound(size));
+    std::fill(m_table.begin(), m_table.end(), 0);
+
+    const Uint8* input = reinterpret_cast<const Uint8*>(data);
+    Uint8* compressed = reinterpret_cast<Uint8*>(&output[0]);
+    std::size_t compressedSize = compressBlock(input, size, compressed + headerSize, &m_table[0]);
+
+    // Fall back to the raw data if compression didn't help
+    if (headerSize + compressedSize >= size + 1)
+    {
+        store(data, size, output);
+        return true;
+    }
+
+    compressed[0] = methodLz4;
+    compressed[1] = static_cast<Uint8>(size >> 24);
+    compressed[2] = static_cast<Uint8>(size >> 16);
+    compressed[3] = static_cast<Uint8>(size >> 8);
+    compressed[4] = static_cast<Uint8>(size);
+    output.resize(headerSize + compressedSize);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PacketCompressor::decode(const char* data, std::size_t size, std::vector<char>& output)
+{
+    if (size < 1)
+        return false;
+
+    const Uint8* input = reinterpret_cast<const Uint8*>(data);
+
+    if (input[0] == methodStored)
+    {
+        output.assign(data + 1, data + size);
+        return true;
+    }
+
+    if ((input[0] != methodLz4) || (size <= headerSize))
+        return false;
+
+    std::size_t originalSize = (static_cast<std::size_t>(input[1]) << 24) |
+                               (static_cast<std::size_t>(input[2]) << 16) |
+                               (static_cast<std::size_t>(input[3]) << 8)  |
+                               (static_cast<std::size_t>(input[4]));
+
+    // Reject sizes that the compressed data can't possibly expand to,
+    // so that a forged header can't make us allocate gigabytes
+    if ((originalSize == 0) || (originalSize > (size - headerSize) * maxRatio + 16))
+        return false;
+
+    output.resize(originalSize);
+
+    return decompressBlock(input + headerSize, size - headerSize, reinterpret_cast<Uint8*>(&output[0]), originalSize);
+}
+
+} // namespace sf
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/PacketPipeline.hpp>
+#include <SFML/Network/PacketTransform.hpp>
+
+
+namespace
+{
+    // Return a pointer to the first byte of a buffer, or NULL if it is empty
+    const char* dataOf(const std::vector<char>& buffer)
+    {
+        return !buffer.empty() ? &buffer[0] : NULL;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PacketPipeline::PacketPipeline()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPipeline::add(PacketTransform& transform)
+{
+    m_transforms.push_back(&transform);
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPipeline::clear()
+{
+    m_transforms.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool PacketPipeline::encode(const void* data, std::size_t size, std::vector<char>& output)
+{
+    const char* input = static_cast<const char*>(data);
+    std::size_t inputSize = size;
+
+    // Without any transform, the data is just copied
+    if (m_transforms.empty())
+    {
+        output.assign(input, input + size);
+        return true;
+    }
+
+    // Run the data through each stage, the last one writing directly to the output
+    for (std::size_t i = 0; i < m_transforms.size(); ++i)
+    {
+        std::vector<char>& stageOutput = (i + 1 == m_transforms.size()) ? output : m_buffers[i % 2];
+
+        if (!m_transforms[i]->encode(input, inputSize, stageOutput))
+            return false;
+
+        input = dataOf(stageOutput);
+        inputSize = stageOutput.size();
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PacketPipeline::decode(const void* data, std::size_t size, const char*& result, std::size_t& resultSize)
+{
+    const char* input = static_cast<const char*>(data);
+    std::size_t inputSize = size;
+
+    // Run the data through each stage, in reverse order
+    for (std::size_t i = 0; i < m_transforms.size(); ++i)
+    {
+        std::vector<char>& stageOutput = m_buffers[i % 2];
+
+        if (!m_transforms[m_transforms.size() - 1 - i]->decode(input, inputSize, stageOutput))
+            return false;
+
+        input = dataOf(stageOutput);
+        inputSize = stageOutput.size();
+    }
+
+    result = input;
+    resultSize = inputSize;
+
+    return true;
+}
+
+} // namespace sf
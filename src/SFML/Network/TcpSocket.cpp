@@ -310,6 +310,10 @@ Socket::Status TcpSocket::send(Packet& packet)
     std::size_t size = 0;
     const void* data = packet.onSend(size);
 
+    // Don't send anything if the pipeline of the packet failed to encode it
+    if (!data && packet.m_pipeline)
+        return Error;
+
     // First convert the packet size to network byte order
     Uint32 packetSize = htonl(static_cast<Uint32>(size));
 
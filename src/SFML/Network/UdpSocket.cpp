@@ -171,6 +171,10 @@ Socket::Status UdpSocket::send(Packet& packet, const IpAddress& remoteAddress, u
     std::size_t size = 0;
     const void* data = packet.onSend(size);
 
+    // Don't send anything if the pipeline of the packet failed to encode it
+    if (!data && packet.m_pipeline)
+        return Error;
+
     // Send it
     return send(data, size, remoteAddress, remotePort);
 }
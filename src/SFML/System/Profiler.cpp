@@ -0,0 +1,502 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/SpscRing.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <SFML/System/Err.hpp>
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+#endif
+
+
+namespace
+{
+    // Zone recorded by a thread, waiting to be collected
+    struct ZoneRecord
+    {
+        const char* name;
+        sf::Int64   begin;
+        sf::Int64   end;
+    };
+
+    // Buffer of the zones recorded by a thread; only this thread pushes, and
+    // only the collecting thread (holding the mutex) pops. When the thread
+    // exits, the buffer is released and given to the next new thread
+    struct ThreadData
+    {
+        ThreadData(unsigned int threadId) :
+        id          (threadId),
+        zones       (16384),
+        droppedZones(0),
+        released    (false)
+        {
+        }
+
+        unsigned int                   id;
+        sf::priv::SpscRing<ZoneRecord> zones;
+        sf::Int64                      droppedZones;
+        bool                           released;
+    };
+
+    // Event of the trace: a complete zone ('X') or a counter value ('C')
+    struct TraceEvent
+    {
+        char         phase;
+        const char*  name;
+        unsigned int thread;
+        sf::Int64    time;
+        sf::Int64    value; // duration of a zone, or value of a counter
+    };
+
+    const unsigned int maxCounters = 64;
+    const std::size_t maxTraceEvents = 1 << 20;
+
+    sf::Mutex                      mutex;   // protects everything below, except the atomic values
+    std::vector<ThreadData*>       threads; // never deleted, a thread may still be running when the program exits
+    sf::ThreadLocalPtr<ThreadData> currentThread;
+    unsigned int                   threadCount = 0;
+    std::vector<TraceEvent>        trace;
+    sf::Int64                      droppedEvents = 0;
+    sf::Int64                      frameStart = 0;
+
+    const char*  counterNames[maxCounters];
+    sf::Int64    counterValues[maxCounters];    // accumulated atomically during the current frame
+    sf::Int64    lastFrameValues[maxCounters];
+    unsigned int counterCount = 0;
+
+    int enabledFlag = 0;
+
+
+    // The atomic operations only need to be atomic, the mutex orders everything else
+    sf::Int64 atomicAdd(sf::Int64& variable, sf::Int64 value)
+    {
+    #if defined(_MSC_VER)
+        return _InterlockedExchangeAdd64(reinterpret_cast<volatile __int64*>(&variable), value);
+    #else
+        return __atomic_fetch_add(&variable, value, __ATOMIC_RELAXED);
+    #endif
+    }
+
+    sf::Int64 atomicExchange(sf::Int64& variable, sf::Int64 value)
+    {
+    #if defined(_MSC_VER)
+        return _InterlockedExchange64(reinterpret_cast<volatile __int64*>(&variable), value);
+    #else
+        return __atomic_exchange_n(&variable, value, __ATOMIC_RELAXED);
+    #endif
+    }
+
+    bool loadEnabled()
+    {
+    #if defined(_MSC_VER)
+        return *static_cast<volatile int*>(&enabledFlag) != 0;
+    #else
+        return __atomic_load_n(&enabledFlag, __ATOMIC_RELAXED) != 0;
+    #endif
+    }
+
+    void storeEnabled(bool enabled)
+    {
+    #if defined(_MSC_VER)
+        *static_cast<volatile int*>(&enabledFlag) = enabled ? 1 : 0;
+    #else
+        __atomic_store_n(&enabledFlag, enabled ? 1 : 0, __ATOMIC_RELAXED);
+    #endif
+    }
+
+    sf::Int64 now()
+    {
+        return sf::Clock::getCurrentTime().asMicroseconds();
+    }
+
+    // Append an event to the trace; the mutex must be locked
+    void addTraceEvent(char phase, const char* name, unsigned int thread, sf::Int64 time, sf::Int64 value)
+    {
+        if (trace.size() >= maxTraceEvents)
+        {
+            ++droppedEvents;
+            return;
+        }
+
+        TraceEvent event = {phase, name, thread, time, value};
+        trace.push_back(event);
+    }
+
+    // Move the zones recorded by a thread to the trace; the mutex must be locked
+    void collectZones(ThreadData& data)
+    {
+        ZoneRecord records[256];
+
+        std::size_t count;
+        while ((count = data.zones.pop(records, sizeof(records) / sizeof(*records))) > 0)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                addTraceEvent('X', records[i].name, data.id, records[i].begin, records[i].end - records[i].begin);
+        }
+    }
+
+    // Move the zones recorded by all the threads to the trace; the mutex must be locked
+    void collectZones()
+    {
+        for (std::vector<ThreadData*>::iterator it = threads.begin(); it != threads.end(); ++it)
+            collectZones(**it);
+    }
+
+    // Called on a thread that recorded zones when it exits
+    void releaseThreadData(void* pointer)
+    {
+        ThreadData* data = static_cast<ThreadData*>(pointer);
+
+        sf::Lock lock(mutex);
+
+        // Its last zones are collected now, so the buffer is empty when it is reused
+        collectZones(*data);
+        data->released = true;
+
+        // A zone ending after this point gets a new buffer
+        currentThread = NULL;
+    }
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    // Fiber local storage calls a function when a thread exits, unlike thread
+    // local storage; it is loaded dynamically since older systems don't have it
+    typedef DWORD (WINAPI* FlsAllocFuncType)(void (WINAPI*)(void*));
+    typedef BOOL (WINAPI* FlsSetValueFuncType)(DWORD, void*);
+
+    const DWORD invalidExitKey = 0xFFFFFFFF;
+    DWORD exitKey = invalidExitKey;
+    FlsSetValueFuncType FlsSetValueFunc = NULL;
+
+    void WINAPI onThreadExit(void* data)
+    {
+        releaseThreadData(data);
+    }
+
+    // Have releaseThreadData called when the calling thread exits; the mutex must be locked
+    void watchThreadExit(ThreadData* data)
+    {
+        static bool initialized = false;
+        if (!initialized)
+        {
+            initialized = true;
+
+            HMODULE kernel32Dll = GetModuleHandle(TEXT("kernel32.dll"));
+            if (kernel32Dll)
+            {
+                FlsAllocFuncType FlsAllocFunc = reinterpret_cast<FlsAllocFuncType>(GetProcAddress(kernel32Dll, "FlsAlloc"));
+                FlsSetValueFunc = reinterpret_cast<FlsSetValueFuncType>(GetProcAddress(kernel32Dll, "FlsSetValue"));
+                if (FlsAllocFunc && FlsSetValueFunc)
+                    exitKey = FlsAllocFunc(&onThreadExit);
+            }
+        }
+
+        if (exitKey != invalidExitKey)
+            FlsSetValueFunc(exitKey, data);
+    }
+
+#else
+
+    pthread_key_t exitKey;
+    bool exitKeyCreated = false;
+
+    void onThreadExit(void* data)
+    {
+        releaseThreadData(data);
+    }
+
+    // Have releaseThreadData called when the calling thread exits; the mutex must be locked
+    void watchThreadExit(ThreadData* data)
+    {
+        static bool initialized = false;
+        if (!initialized)
+        {
+            initialized = true;
+            exitKeyCreated = (pthread_key_create(&exitKey, &onThreadExit) == 0);
+        }
+
+        if (exitKeyCreated)
+            pthread_setspecific(exitKey, data);
+    }
+
+#endif
+
+    // Get the buffer of the calling thread, creating it the first time
+    ThreadData& getThreadData()
+    {
+        ThreadData* data = currentThread;
+        if (!data)
+        {
+            sf::Lock lock(mutex);
+
+            // Reuse the buffer of a thread that has exited, so that the memory
+            // doesn't grow with the number of threads created by the program
+            for (std::vector<ThreadData*>::iterator it = threads.begin(); it != threads.end(); ++it)
+            {
+                if ((*it)->released)
+                {
+                    data = *it;
+                    data->id = ++threadCount;
+                    data->released = false;
+                    break;
+                }
+            }
+
+            if (!data)
+            {
+                data = new ThreadData(++threadCount);
+                threads.push_back(data);
+            }
+
+            currentThread = data;
+            watchThreadExit(data);
+        }
+
+        return *data;
+    }
+
+    // Write a string as a JSON string literal
+    void writeString(std::ostream& stream, const char* string)
+    {
+        stream << '"';
+        for (; *string; ++string)
+        {
+            unsigned char character = static_cast<unsigned char>(*string);
+            if ((character == '"') || (character == '\\'))
+                stream << '\\' << *string;
+            else if (character < 0x20)
+                stream << ' ';
+            else
+                stream << *string;
+        }
+        stream << '"';
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Profiler::Zone::Zone(const char* name) :
+m_name (name),
+m_begin(loadEnabled() ? now() : -1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Profiler::Zone::~Zone()
+{
+    if (m_begin < 0)
+        return;
+
+    ZoneRecord record = {m_name, m_begin, now()};
+
+    // Never block the profiled thread: if the buffer is full, the zone is lost
+    ThreadData& data = getThreadData();
+    if (!data.zones.push(record))
+        atomicAdd(data.droppedZones, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::setEnabled(bool enabled)
+{
+    Lock lock(mutex);
+
+    // The first frame starts now
+    if (enabled && !loadEnabled())
+        frameStart = now();
+
+    storeEnabled(enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Profiler::isEnabled()
+{
+    return loadEnabled();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Profiler::getCounterId(const char* name)
+{
+    Lock lock(mutex);
+
+    for (unsigned int i = 0; i < counterCount; ++i)
+    {
+        if (std::strcmp(counterNames[i], name) == 0)
+            return i;
+    }
+
+    if (counterCount == maxCounters)
+    {
+        err() << "Failed to create profiler counter \"" << name << "\" (the maximum of " << maxCounters << " counters is reached)" << std::endl;
+        return maxCounters;
+    }
+
+    counterNames[counterCount] = name;
+    counterValues[counterCount] = 0;
+    lastFrameValues[counterCount] = 0;
+
+    return counterCount++;
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::addToCounter(unsigned int counter, Int64 value)
+{
+    if ((counter < maxCounters) && loadEnabled())
+        atomicAdd(counterValues[counter], value);
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 Profiler::getLastFrameCounter(const char* name)
+{
+    Lock lock(mutex);
+
+    for (unsigned int i = 0; i < counterCount; ++i)
+    {
+        if (std::strcmp(counterNames[i], name) == 0)
+            return lastFrameValues[i];
+    }
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::markFrame()
+{
+    if (!loadEnabled())
+        return;
+
+    Int64 time = now();
+    ThreadData& data = getThreadData();
+
+    Lock lock(mutex);
+
+    collectZones();
+    addTraceEvent('X', "Frame", data.id, frameStart, time - frameStart);
+
+    for (unsigned int i = 0; i < counterCount; ++i)
+    {
+        lastFrameValues[i] = atomicExchange(counterValues[i], 0);
+        addTraceEvent('C', counterNames[i], data.id, frameStart, lastFrameValues[i]);
+    }
+
+    frameStart = time;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Profiler::saveChromeTrace(const std::string& filename)
+{
+    Lock lock(mutex);
+
+    collectZones();
+
+    std::ofstream file(filename.c_str());
+    if (!file)
+    {
+        err() << "Failed to save profiler trace to \"" << filename << "\" (failed to open the file)" << std::endl;
+        return false;
+    }
+
+    file << "{\"traceEvents\":[\n";
+
+    // Name the threads, including those which have exited
+    for (unsigned int id = 1; id <= threadCount; ++id)
+    {
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id
+             << ",\"args\":{\"name\":\"Thread " << id << "\"}},\n";
+    }
+
+    // Report the zones that were lost
+    Int64 droppedZones = 0;
+    for (std::vector<ThreadData*>::const_iterator it = threads.begin(); it != threads.end(); ++it)
+        droppedZones += atomicAdd((*it)->droppedZones, 0);
+
+    for (std::vector<TraceEvent>::const_iterator it = trace.begin(); it != trace.end(); ++it)
+    {
+        file << "{\"name\":";
+        writeString(file, it->name);
+
+        if (it->phase == 'X')
+            file << ",\"cat\":\"sfml\",\"ph\":\"X\",\"ts\":" << it->time << ",\"dur\":" << it->value;
+        else
+            file << ",\"ph\":\"C\",\"ts\":" << it->time << ",\"args\":{\"value\":" << it->value << "}";
+
+        file << ",\"pid\":1,\"tid\":" << it->thread << "},\n";
+    }
+
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"SFML\"}}\n";
+    file << "]}\n";
+
+    if ((droppedZones > 0) || (droppedEvents > 0))
+        err() << "Profiler trace is incomplete: " << droppedZones << " zones and " << droppedEvents << " events were dropped" << std::endl;
+
+    if (!file)
+    {
+        err() << "Failed to save profiler trace to \"" << filename << "\" (failed to write the file)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::clear()
+{
+    Lock lock(mutex);
+
+    collectZones();
+    trace.clear();
+    droppedEvents = 0;
+
+    for (std::vector<ThreadData*>::iterator it = threads.begin(); it != threads.end(); ++it)
+        atomicExchange((*it)->droppedZones, 0);
+}
+
+} // namespace sf
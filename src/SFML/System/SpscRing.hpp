@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPSCRING_HPP
+#define SFML_SPSCRING_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Lock-free ring buffer for one producer thread
+///        and one consumer thread
+///
+/// The producer only writes the head index and the consumer
+/// only writes the tail index, so no lock is needed: each side
+/// publishes its index with release semantics once the items
+/// have been copied, and reads the other one with acquire
+/// semantics.
+/// The capacity is rounded up to a power of two.
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class SpscRing : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param capacity Minimum number of items that the ring can hold
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpscRing(std::size_t capacity = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the capacity and empty the ring
+    ///
+    /// This function must not be called while the ring is used
+    /// by the producer or the consumer.
+    ///
+    /// \param capacity Minimum number of items that the ring can hold
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of items in the ring
+    ///
+    /// \return Capacity of the ring
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of items that can be pushed (producer side)
+    ///
+    /// \return Free space in the ring
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFreeSpace() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of items that can be popped (consumer side)
+    ///
+    /// \return Number of items in the ring
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy items into the ring (producer side)
+    ///
+    /// \param items Items to push
+    /// \param count Number of items to push
+    ///
+    /// \return Number of items actually pushed, limited by the free space
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(const T* items, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Push a single item into the ring (producer side)
+    ///
+    /// \param item Item to push
+    ///
+    /// \return True if the item was pushed, false if the ring is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const T& item);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy items out of the ring (consumer side)
+    ///
+    /// \param items Array to fill
+    /// \param count Maximum number of items to pop
+    ///
+    /// \return Number of items actually popped
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t pop(T* items, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pop a single item from the ring (consumer side)
+    ///
+    /// \param item Item to fill
+    ///
+    /// \return True if an item was popped, false if the ring is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(T& item);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an index written by the other thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t loadAcquire(const std::size_t& index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Publish an index to the other thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static void storeRelease(std::size_t& index, std::size_t value);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<T> m_items; ///< Storage, its size is a power of two
+    std::size_t    m_mask;  ///< Size of the storage minus one, to wrap the indices
+    std::size_t    m_head;  ///< Number of items pushed so far (written by the producer)
+    char           m_padding[64 - sizeof(std::size_t)]; ///< Keeps the indices on separate cache lines
+    std::size_t    m_tail;  ///< Number of items popped so far (written by the consumer)
+};
+
+#include <SFML/System/SpscRing.inl>
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SPSCRING_HPP
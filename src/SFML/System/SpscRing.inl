@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+SpscRing<T>::SpscRing(std::size_t capacity) :
+m_items  (),
+m_mask   (0),
+m_head   (0),
+m_padding(),
+m_tail   (0)
+{
+    reset(capacity);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpscRing<T>::reset(std::size_t capacity)
+{
+    std::size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+
+    m_items.assign(size, T());
+    m_mask = size - 1;
+    m_head = 0;
+    m_tail = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscRing<T>::getCapacity() const
+{
+    return m_items.size();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscRing<T>::getFreeSpace() const
+{
+    return m_items.size() - (m_head - loadAcquire(m_tail));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscRing<T>::getSize() const
+{
+    return loadAcquire(m_head) - m_tail;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscRing<T>::push(const T* items, std::size_t count)
+{
+    std::size_t free = getFreeSpace();
+    if (count > free)
+        count = free;
+
+    // Copy the items, wrapping around the end of the storage
+    for (std::size_t i = 0; i < count; ++i)
+        m_items[(m_head + i) & m_mask] = items[i];
+
+    storeRelease(m_head, m_head + count);
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool SpscRing<T>::push(const T& item)
+{
+    return push(&item, 1) == 1;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscRing<T>::pop(T* items, std::size_t count)
+{
+    std::size_t size = getSize();
+    if (count > size)
+        count = size;
+
+    for (std::size_t i = 0; i < count; ++i)
+        items[i] = m_items[(m_tail + i) & m_mask];
+
+    storeRelease(m_tail, m_tail + count);
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool SpscRing<T>::pop(T& item)
+{
+    return pop(&item, 1) == 1;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscRing<T>::loadAcquire(const std::size_t& index)
+{
+#if defined(_MSC_VER)
+
+    // x86 and x64 loads already have acquire semantics, only the compiler must not reorder them
+    std::size_t value = *static_cast<const volatile std::size_t*>(&index);
+    _ReadWriteBarrier();
+    return value;
+
+#else
+
+    return __atomic_load_n(&index, __ATOMIC_ACQUIRE);
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpscRing<T>::storeRelease(std::size_t& index, std::size_t value)
+{
+#if defined(_MSC_VER)
+
+    // x86 and x64 stores already have release semantics, only the compiler must not reorder them
+    _ReadWriteBarrier();
+    *static_cast<volatile std::size_t*>(&index) = value;
+
+#else
+
+    __atomic_store_n(&index, value, __ATOMIC_RELEASE);
+
+#endif
+}
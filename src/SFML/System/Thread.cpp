@@ -77,6 +77,23 @@ void Thread::terminate()
 }
 
 
+////////////////////////////////////////////////////////////
+void Thread::setPriority(Priority priority)
+{
+    m_priority = priority;
+
+    if (m_impl)
+        m_impl->setPriority(priority);
+}
+
+
+////////////////////////////////////////////////////////////
+Thread::Priority Thread::getPriority() const
+{
+    return m_priority;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Thread::run()
 {
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/SignalImpl.hpp>
+#include <errno.h>
+#include <time.h>
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+    #include <sys/time.h>
+#endif
+
+
+namespace
+{
+    // Use the monotonic clock for timeouts when the condition variable supports it,
+    // so that changing the system time doesn't affect the waits
+    #if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_FREEBSD)
+        #define SFML_SIGNAL_MONOTONIC
+    #endif
+
+    timespec getDeadline(sf::Time timeout)
+    {
+        timespec now;
+
+    #if defined(SFML_SIGNAL_MONOTONIC)
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    #elif defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+        timeval current;
+        gettimeofday(&current, NULL);
+        now.tv_sec = current.tv_sec;
+        now.tv_nsec = current.tv_usec * 1000;
+    #else
+        clock_gettime(CLOCK_REALTIME, &now);
+    #endif
+
+        sf::Int64 usecs = timeout.asMicroseconds();
+        if (usecs < 0)
+            usecs = 0;
+
+        timespec deadline;
+        deadline.tv_sec  = now.tv_sec + static_cast<time_t>(usecs / 1000000);
+        deadline.tv_nsec = now.tv_nsec + static_cast<long>((usecs % 1000000) * 1000);
+        if (deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        return deadline;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SignalImpl::SignalImpl() :
+m_raised(false)
+{
+    pthread_mutex_init(&m_mutex, NULL);
+
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+#if defined(SFML_SIGNAL_MONOTONIC)
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+#endif
+    pthread_cond_init(&m_condition, &attributes);
+    pthread_condattr_destroy(&attributes);
+}
+
+
+////////////////////////////////////////////////////////////
+SignalImpl::~SignalImpl()
+{
+    pthread_cond_destroy(&m_condition);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+void SignalImpl::notify()
+{
+    pthread_mutex_lock(&m_mutex);
+    m_raised = true;
+    pthread_cond_signal(&m_condition);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+void SignalImpl::wait()
+{
+    pthread_mutex_lock(&m_mutex);
+
+    // Loop to ignore spurious wake-ups
+    while (!m_raised)
+        pthread_cond_wait(&m_condition, &m_mutex);
+
+    m_raised = false;
+    pthread_mutex_unlock(&m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SignalImpl::wait(Time timeout)
+{
+    timespec deadline = getDeadline(timeout);
+
+    pthread_mutex_lock(&m_mutex);
+
+    int result = 0;
+    while (!m_raised && (result != ETIMEDOUT))
+        result = pthread_cond_timedwait(&m_condition, &m_mutex, &deadline);
+
+    bool raised = m_raised;
+    m_raised = false;
+    pthread_mutex_unlock(&m_mutex);
+
+    return raised;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -28,6 +28,7 @@
 #include <SFML/System/Unix/ThreadImpl.hpp>
 #include <SFML/System/Thread.hpp>
 #include <iostream>
+#include <sched.h>
 #include <cassert>
 
 
@@ -43,6 +44,8 @@ m_isActive(true)
 
     if (!m_isActive)
         std::cerr << "Failed to create thread" << std::endl;
+    else if (owner->m_priority != Thread::Normal)
+        setPriority(owner->m_priority);
 }
 
 
@@ -72,6 +75,33 @@ void ThreadImpl::terminate()
 }
 
 
+////////////////////////////////////////////////////////////
+bool ThreadImpl::setPriority(Thread::Priority priority)
+{
+    if (!m_isActive)
+        return false;
+
+    int policy = SCHED_OTHER;
+    sched_param parameters;
+    parameters.sched_priority = 0;
+
+    if (priority == Thread::High)
+    {
+        policy = SCHED_RR;
+        parameters.sched_priority = sched_get_priority_min(SCHED_RR);
+    }
+    else if (priority == Thread::Realtime)
+    {
+        policy = SCHED_FIFO;
+        parameters.sched_priority = (sched_get_priority_min(SCHED_FIFO) + sched_get_priority_max(SCHED_FIFO)) / 2;
+    }
+
+    // Realtime policies usually require privileges (root, CAP_SYS_NICE or an RLIMIT_RTPRIO limit);
+    // failing is expected and harmless, the thread then keeps its current priority
+    return pthread_setschedparam(m_thread, policy, &parameters) == 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 void* ThreadImpl::entryPoint(void* userData)
 {
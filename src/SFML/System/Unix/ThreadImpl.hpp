@@ -30,13 +30,12 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Config.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
 #include <pthread.h>
 
 
 namespace sf
 {
-class Thread;
-
 namespace priv
 {
 ////////////////////////////////////////////////////////////
@@ -66,6 +65,16 @@ public:
     ////////////////////////////////////////////////////////////
     void terminate();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the scheduling priority of the thread
+    ///
+    /// \param priority New priority
+    ///
+    /// \return True if the priority was changed, false if it is not permitted
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setPriority(Thread::Priority priority);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Win32/SignalImpl.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SignalImpl::SignalImpl()
+{
+    // An auto-reset event behaves exactly like our signals
+    m_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+SignalImpl::~SignalImpl()
+{
+    CloseHandle(m_event);
+}
+
+
+////////////////////////////////////////////////////////////
+void SignalImpl::notify()
+{
+    SetEvent(m_event);
+}
+
+
+////////////////////////////////////////////////////////////
+void SignalImpl::wait()
+{
+    WaitForSingleObject(m_event, INFINITE);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SignalImpl::wait(Time timeout)
+{
+    Int32 milliseconds = timeout.asMilliseconds();
+    if (milliseconds < 0)
+        milliseconds = 0;
+
+    return WaitForSingleObject(m_event, static_cast<DWORD>(milliseconds)) == WAIT_OBJECT_0;
+}
+
+} // namespace priv
+
+} // namespace sf
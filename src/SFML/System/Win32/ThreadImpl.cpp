@@ -43,6 +43,8 @@ ThreadImpl::ThreadImpl(Thread* owner)
 
     if (!m_thread)
         err() << "Failed to create thread" << std::endl;
+    else if (owner->m_priority != Thread::Normal)
+        setPriority(owner->m_priority);
 }
 
 
@@ -73,6 +75,22 @@ void ThreadImpl::terminate()
 }
 
 
+////////////////////////////////////////////////////////////
+bool ThreadImpl::setPriority(Thread::Priority priority)
+{
+    if (!m_thread)
+        return false;
+
+    int value = THREAD_PRIORITY_NORMAL;
+    if (priority == Thread::High)
+        value = THREAD_PRIORITY_ABOVE_NORMAL;
+    else if (priority == Thread::Realtime)
+        value = THREAD_PRIORITY_TIME_CRITICAL;
+
+    return SetThreadPriority(m_thread, value) != 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int __stdcall ThreadImpl::entryPoint(void* userData)
 {
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
 #include <windows.h>
 
 // Fix for unaligned stack with clang and GCC on Windows XP 32-bit
@@ -45,8 +46,6 @@
 
 namespace sf
 {
-class Thread;
-
 namespace priv
 {
 ////////////////////////////////////////////////////////////
@@ -82,6 +81,16 @@ public:
     ////////////////////////////////////////////////////////////
     void terminate();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the scheduling priority of the thread
+    ///
+    /// \param priority New priority
+    ///
+    /// \return True if the priority was changed, false if it is not permitted
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setPriority(Thread::Priority priority);
+
 private:
 
     ////////////////////////////////////////////////////////////
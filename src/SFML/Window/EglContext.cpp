@@ -33,6 +33,7 @@
 #include <SFML/System/Sleep.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Profiler.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/Activity.hpp>
 #endif
@@ -51,9 +52,15 @@
 #include <drm/drm_fourcc.h>
 //#include <cstring>
 #include <gbm.h>
+#include <cstdlib>
+#include <cstring>
 
 #define BUFFER_MAX (3)
 
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+    #define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
 
 
 
@@ -93,6 +100,41 @@ GLuint fbo;
 
 namespace
 {
+    typedef EGLDisplay (EGLAPIENTRY *GetPlatformDisplayFuncType)(EGLenum, void*, const EGLint*);
+
+    // Check whether contexts must be created without the display hardware, to run
+    // the graphics code where there's no screen (for example with Mesa's llvmpipe
+    // software renderer); this is selected by setting the SFML_HEADLESS environment
+    // variable to a non-zero value. Headless contexts render to off-screen surfaces
+    bool isHeadless()
+    {
+        static const char* value = std::getenv("SFML_HEADLESS");
+        static const bool headless = value && *value && (std::strcmp(value, "0") != 0);
+
+        return headless;
+    }
+
+    // Check whether the EGL implementation supports a client extension
+    bool isClientExtensionAvailable(const char* name)
+    {
+        // EGL < 1.5 implementations without client extensions fail with EGL_BAD_DISPLAY
+        const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if (!extensions)
+        {
+            eglGetError();
+            return false;
+        }
+
+        std::size_t length = std::strlen(name);
+        for (const char* found = std::strstr(extensions, name); found; found = std::strstr(found + length, name))
+        {
+            if (((found == extensions) || (found[-1] == ' ')) && ((found[length] == ' ') || (found[length] == '\0')))
+                return true;
+        }
+
+        return false;
+    }
+
     EGLDisplay getInitializedDisplay()
     {
 #if defined(SFML_SYSTEM_LINUX)
@@ -101,7 +143,22 @@ namespace
 
         if (display == EGL_NO_DISPLAY)
         {
-            display = eglCheck(eglGetDisplay(EGL_DEFAULT_DISPLAY));
+            // Headless contexts prefer Mesa's surfaceless platform, that needs
+            // neither a window system nor a GPU
+            if (isHeadless() && isClientExtensionAvailable("EGL_MESA_platform_surfaceless"))
+            {
+                GetPlatformDisplayFuncType getPlatformDisplay = reinterpret_cast<GetPlatformDisplayFuncType>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+                if (getPlatformDisplay)
+                {
+                    display = eglCheck(getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL));
+                }
+            }
+
+            if (display == EGL_NO_DISPLAY)
+            {
+                display = eglCheck(eglGetDisplay(EGL_DEFAULT_DISPLAY));
+            }
+
             eglCheck(eglInitialize(display, NULL, NULL));
         }
 
@@ -131,6 +188,21 @@ m_context (EGL_NO_CONTEXT),
 m_surface (EGL_NO_SURFACE),
 m_config  (NULL)
 {
+    if (isHeadless())
+    {
+        // Get the initialized EGL display
+        m_display = getInitializedDisplay();
+
+        // Get the best EGL config for an off-screen surface, there's no desktop mode to match
+        m_config = getBestConfig(m_display, 32, ContextSettings(), EGL_PBUFFER_BIT);
+        updateSettings();
+
+        createContext(shared);
+        createPbufferSurface(1, 1);
+
+        return;
+    }
+
     // Get the initialized EGL display
     //m_display = getInitializedDisplay();
 	createContext(shared);
@@ -139,15 +211,7 @@ m_config  (NULL)
     m_config = getBestConfig(m_display, VideoMode::getDesktopMode().bitsPerPixel, ContextSettings());
     updateSettings();
 
-    // Note: The EGL specs say that attrib_list can be NULL when passed to eglCreatePbufferSurface,
-    // but this is resulting in a segfault. Bug in Android?
-    EGLint attrib_list[] = {
-        EGL_WIDTH, 1,
-        EGL_HEIGHT,1,
-        EGL_NONE
-    };
-
-    m_surface = eglCheck(eglCreatePbufferSurface(m_display, m_config, attrib_list));
+    createPbufferSurface(1, 1);
 
     // Create EGL context
     //createContext(shared);
@@ -197,6 +261,19 @@ m_context (EGL_NO_CONTEXT),
 m_surface (EGL_NO_SURFACE),
 m_config  (NULL)
 {
+    // Use the display of the window contexts if there's one, so that the contexts can be shared
+    if (go2_context3D && !isHeadless())
+        m_display = go2_context3D->eglDisplay;
+    else
+        m_display = getInitializedDisplay();
+
+    // Get the best EGL config for an off-screen surface
+    m_config = getBestConfig(m_display, 32, settings, EGL_PBUFFER_BIT);
+    updateSettings();
+
+    // Create EGL context and its surface
+    createContext(shared);
+    createPbufferSurface(width, height);
 }
 
 
@@ -272,14 +349,20 @@ bool EglContext::makeCurrent(bool current)
 ////////////////////////////////////////////////////////////
 void EglContext::display()
 {
-    int w, h;
-    w = go2_display_height_get(go2_display);
-    h = go2_display_width_get(go2_display);
+    SFML_PROFILE_ZONE("EglContext::display");
 
     if (m_surface != EGL_NO_SURFACE)
 	{
         eglCheck(eglSwapBuffers(m_display, m_surface));
-		
+
+        // Off-screen surfaces have nothing to present
+        if (!go2_context3D || (m_surface != go2_context3D->eglSurface))
+            return;
+
+        int w, h;
+        w = go2_display_height_get(go2_display);
+        h = go2_display_width_get(go2_display);
+
         //go2_context_swap_buffers(go2_context3D);
 
         go2_surface_t* gles_surface = go2_context_surface_lock(go2_context3D);
@@ -377,7 +460,25 @@ void EglContext::destroySurface()
 
 
 ////////////////////////////////////////////////////////////
-EGLConfig EglContext::getBestConfig(EGLDisplay display, unsigned int bitsPerPixel, const ContextSettings& settings)
+void EglContext::createPbufferSurface(unsigned int width, unsigned int height)
+{
+    if (!m_config)
+        return;
+
+    // Note: The EGL specs say that attrib_list can be NULL when passed to eglCreatePbufferSurface,
+    // but this is resulting in a segfault. Bug in Android?
+    EGLint attrib_list[] = {
+        EGL_WIDTH, static_cast<EGLint>(width),
+        EGL_HEIGHT, static_cast<EGLint>(height),
+        EGL_NONE
+    };
+
+    m_surface = eglCheck(eglCreatePbufferSurface(m_display, m_config, attrib_list));
+}
+
+
+////////////////////////////////////////////////////////////
+EGLConfig EglContext::getBestConfig(EGLDisplay display, unsigned int bitsPerPixel, const ContextSettings& settings, EGLint surfaceType)
 {
     // Set our video settings constraint
     const EGLint attributes[] = {
@@ -385,7 +486,7 @@ EGLConfig EglContext::getBestConfig(EGLDisplay display, unsigned int bitsPerPixe
         EGL_DEPTH_SIZE, settings.depthBits,
         EGL_STENCIL_SIZE, settings.stencilBits,
         EGL_SAMPLE_BUFFERS, settings.antialiasingLevel,
-        EGL_SURFACE_TYPE, EGL_WINDOW_BIT /*| EGL_PBUFFER_BIT*/, // by trngaje
+        EGL_SURFACE_TYPE, surfaceType,
         EGL_RENDERABLE_TYPE, EGL_OPENGL_ES_BIT,
         EGL_NONE
     };
@@ -396,6 +497,12 @@ EGLConfig EglContext::getBestConfig(EGLDisplay display, unsigned int bitsPerPixe
     // Ask EGL for the best config matching our video settings
     eglCheck(eglChooseConfig(display, attributes, configs, 1, &configCount));
 
+    if (configCount == 0)
+    {
+        err() << "No EGL config matches the requested settings. You should check your graphics driver" << std::endl;
+        return NULL;
+    }
+
     // TODO: This should check EGL_CONFORMANT and pick the first conformant configuration.
 
     return configs[0];
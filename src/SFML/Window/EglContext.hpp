@@ -145,11 +145,12 @@ public:
     /// \param display      EGL display
     /// \param bitsPerPixel Pixel depth, in bits per pixel
     /// \param settings     Requested context settings
+    /// \param surfaceType  Type of surface the config must support (EGL_WINDOW_BIT or EGL_PBUFFER_BIT)
     ///
-    /// \return The best EGL config
+    /// \return The best EGL config, or NULL if none matches
     ///
     ////////////////////////////////////////////////////////////
-    static EGLConfig getBestConfig(EGLDisplay display, unsigned int bitsPerPixel, const ContextSettings& settings);
+    static EGLConfig getBestConfig(EGLDisplay display, unsigned int bitsPerPixel, const ContextSettings& settings, EGLint surfaceType = EGL_WINDOW_BIT);
 
 #if defined(SFML_SYSTEM_LINUX) && !defined(SFML_RPI)
     ////////////////////////////////////////////////////////////
@@ -172,6 +173,15 @@ private:
     ////////////////////////////////////////////////////////////
     void updateSettings();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create an off-screen EGL surface
+    ///
+    /// \param width  Width of the surface, in pixels
+    /// \param height Height of the surface, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void createPbufferSurface(unsigned int width, unsigned int height);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -36,6 +36,7 @@
 #include <vector>
 #include <string>
 #include <set>
+#include <utility>
 #include <cstdlib>
 #include <cstring>
 #include <cassert>
@@ -139,6 +140,9 @@ namespace
     // OpenGL resources counter
     unsigned int resourceCount = 0;
 
+    // Identifier given to the next created context
+    sf::Uint64 nextContextId = 1;
+
     // This per-thread variable holds the current context for each thread
     sf::ThreadLocalPtr<sf::priv::GlContext> currentContext(NULL);
 
@@ -199,6 +203,17 @@ namespace
 
     // Supported OpenGL extensions
     std::vector<std::string> extensions;
+
+    // Functions called when a context is destroyed, protected by the mutex
+    std::vector<std::pair<sf::ContextDestroyCallback, void*> > contextDestroyCallbacks;
+
+    // Get a new unique context identifier
+    sf::Uint64 getNextContextId()
+    {
+        sf::Lock lock(mutex);
+
+        return nextContextId++;
+    }
 }
 
 
@@ -456,6 +471,22 @@ GlFunctionPointer GlContext::getFunction(const char* name)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 GlContext::getActiveContextId()
+{
+    return currentContext ? currentContext->m_id : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlContext::registerContextDestroyCallback(ContextDestroyCallback callback, void* userData)
+{
+    Lock lock(mutex);
+
+    contextDestroyCallbacks.push_back(std::make_pair(callback, userData));
+}
+
+
 ////////////////////////////////////////////////////////////
 GlContext::~GlContext()
 {
@@ -465,6 +496,11 @@ GlContext::~GlContext()
         if (this == currentContext)
             currentContext = NULL;
     }
+
+    // Let the users of the context release what they associated with it
+    Lock lock(mutex);
+    for (std::vector<std::pair<ContextDestroyCallback, void*> >::const_iterator it = contextDestroyCallbacks.begin(); it != contextDestroyCallbacks.end(); ++it)
+        it->first(m_id, it->second);
 }
 
 
@@ -529,9 +565,9 @@ bool GlContext::setActive(bool active)
 
 
 ////////////////////////////////////////////////////////////
-GlContext::GlContext()
+GlContext::GlContext() :
+m_id(getNextContextId())
 {
-    // Nothing to do
 }
 
 
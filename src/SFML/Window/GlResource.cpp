@@ -45,6 +45,13 @@ GlResource::~GlResource()
 }
 
 
+////////////////////////////////////////////////////////////
+void GlResource::registerContextDestroyCallback(ContextDestroyCallback callback, void* userData)
+{
+    priv::GlContext::registerContextDestroyCallback(callback, userData);
+}
+
+
 ////////////////////////////////////////////////////////////
 GlResource::TransientContextLock::TransientContextLock()
 {
@@ -73,6 +73,13 @@ Joystick::Identification Joystick::getIdentification(unsigned int joystick)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Joystick::setVibration(unsigned int joystick, float strong, float weak, Time duration)
+{
+    return priv::JoystickManager::getInstance().setVibration(joystick, strong, weak, duration);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Joystick::update()
 {
@@ -31,6 +31,7 @@
 #include <SFML/Config.hpp>
 #include <SFML/Window/Joystick.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Time.hpp>
 #include <algorithm>
 
 
@@ -66,11 +67,15 @@ struct JoystickState
         connected = false;
         std::fill(axes, axes + Joystick::AxisCount, 0.f);
         std::fill(buttons, buttons + Joystick::ButtonCount, false);
+        std::fill(axisTimes, axisTimes + Joystick::AxisCount, Time::Zero);
+        std::fill(buttonTimes, buttonTimes + Joystick::ButtonCount, Time::Zero);
     }
 
-    bool  connected;                      ///< Is the joystick currently connected?
-    float axes[Joystick::AxisCount];      ///< Position of each axis, in range [-100, 100]
-    bool  buttons[Joystick::ButtonCount]; ///< Status of each button (true = pressed)
+    bool  connected;                          ///< Is the joystick currently connected?
+    float axes[Joystick::AxisCount];          ///< Position of each axis, in range [-100, 100]
+    bool  buttons[Joystick::ButtonCount];     ///< Status of each button (true = pressed)
+    Time  axisTimes[Joystick::AxisCount];     ///< Time of the last change of each axis, zero if unknown
+    Time  buttonTimes[Joystick::ButtonCount]; ///< Time of the last change of each button, zero if unknown
 };
 
 } // namespace priv
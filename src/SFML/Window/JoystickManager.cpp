@@ -26,6 +26,19 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickManager.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Check if two joystick states are equal
+    bool isSameState(const sf::priv::JoystickState& left, const sf::priv::JoystickState& right)
+    {
+        return (left.connected == right.connected) &&
+               std::equal(left.axes, left.axes + sf::Joystick::AxisCount, right.axes) &&
+               std::equal(left.buttons, left.buttons + sf::Joystick::ButtonCount, right.buttons);
+    }
+}
 
 
 namespace sf
@@ -61,28 +74,82 @@ const Joystick::Identification& JoystickManager::getIdentification(unsigned int
 }
 
 
+////////////////////////////////////////////////////////////
+Uint32 JoystickManager::getChangeCount(unsigned int joystick) const
+{
+    return m_joysticks[joystick].changeCount;
+}
+
+
+////////////////////////////////////////////////////////////
+bool JoystickManager::setVibration(unsigned int joystick, float strong, float weak, Time duration)
+{
+    if (!m_joysticks[joystick].state.connected)
+        return false;
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    strong = std::min(std::max(strong, 0.f), 100.f);
+    weak = std::min(std::max(weak, 0.f), 100.f);
+    return m_joysticks[joystick].joystick.setVibration(strong, weak, duration);
+
+#else
+
+    // Force feedback is not implemented on the other platforms
+    (void)strong;
+    (void)weak;
+    (void)duration;
+    return false;
+
+#endif
+}
+
+
 ////////////////////////////////////////////////////////////
 void JoystickManager::update()
 {
+#if defined(SFML_SYSTEM_LINUX)
+
+    // The system tells which joysticks have pending input, and whether
+    // the connections have to be checked
+    bool connectionsChanged = false;
+    Uint32 pendingJoysticks = JoystickImpl::pollChanges(connectionsChanged);
+
+#else
+
+    bool connectionsChanged = true;
+    Uint32 pendingJoysticks = 0xFFFFFFFF;
+
+#endif
+
     for (int i = 0; i < Joystick::Count; ++i)
     {
         Item& item = m_joysticks[i];
 
         if (item.state.connected)
         {
+            if (!(pendingJoysticks & (1u << i)))
+                continue;
+
             // Get the current state of the joystick
-            item.state = item.joystick.update();
+            JoystickState state = item.joystick.update();
 
             // Check if it's still connected
-            if (!item.state.connected)
+            if (!state.connected)
             {
                 item.joystick.close();
                 item.capabilities   = JoystickCaps();
                 item.state          = JoystickState();
                 item.identification = Joystick::Identification();
+                item.changeCount++;
+            }
+            else if (!isSameState(state, item.state))
+            {
+                item.state = state;
+                item.changeCount++;
             }
         }
-        else
+        else if (connectionsChanged)
         {
             // Check if the joystick was connected since last update
             if (JoystickImpl::isConnected(i))
@@ -92,6 +159,7 @@ void JoystickManager::update()
                     item.capabilities   = item.joystick.getCapabilities();
                     item.state          = item.joystick.update();
                     item.identification = item.joystick.getIdentification();
+                    item.changeCount++;
                 }
             }
         }
@@ -102,6 +170,9 @@ void JoystickManager::update()
 ////////////////////////////////////////////////////////////
 JoystickManager::JoystickManager()
 {
+    for (int i = 0; i < Joystick::Count; ++i)
+        m_joysticks[i].changeCount = 0;
+
     JoystickImpl::initialize();
 }
 
@@ -83,9 +83,38 @@ public:
     ////////////////////////////////////////////////////////////
     const Joystick::Identification& getIdentification(unsigned int joystick) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of times the state of a joystick has changed
+    ///
+    /// This allows to compare the state of a joystick only when
+    /// it has changed since the last comparison.
+    ///
+    /// \param joystick Index of the joystick
+    ///
+    /// \return Number of changes of the joystick state
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getChangeCount(unsigned int joystick) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make an open joystick vibrate
+    ///
+    /// \param joystick Index of the joystick
+    /// \param strong   Magnitude of the strong motor, in range [0 .. 100]
+    /// \param weak     Magnitude of the weak motor, in range [0 .. 100]
+    /// \param duration Duration of the vibration, Time::Zero for no limit
+    ///
+    /// \return True on success, false if the joystick can't vibrate
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setVibration(unsigned int joystick, float strong, float weak, Time duration);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the state of all the joysticks
     ///
+    /// Only the joysticks that have pending input are updated,
+    /// when the platform can tell which ones.
+    ///
     ////////////////////////////////////////////////////////////
     void update();
 
@@ -113,6 +142,7 @@ private:
         JoystickState            state;          ///< The current joystick state
         JoystickCaps             capabilities;   ///< The joystick capabilities
         Joystick::Identification identification; ///< The joystick identification
+        Uint32                   changeCount;    ///< Number of times the state has changed
     };
 
     ////////////////////////////////////////////////////////////
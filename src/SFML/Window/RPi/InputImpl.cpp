@@ -32,19 +32,26 @@
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/SpscRing.hpp>
 
-#include <sstream>
 #include <string>
 #include <vector>
-#include <queue>
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
 #include <sys/stat.h>
+#include <dirent.h>
 #include <fcntl.h>
 #include <termios.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <linux/input.h>
@@ -56,6 +63,7 @@ namespace
         int oldId;
         int id;
         sf::Vector2i pos;
+        sf::Vector2i oldPos;
 
         TouchSlot ()
         {
@@ -66,10 +74,32 @@ namespace
         }
     };
 
+    // What an input device can be used for
+    enum DeviceCapability
+    {
+        KeyboardDevice = 1 << 0,
+        MouseDevice    = 1 << 1,
+        TouchDevice    = 1 << 2
+    };
+
+    struct InputDevice {
+        int fd;                                                // file descriptor of the device, registered in epollFd
+        std::string path;                                      // path of the device node in /dev/input
+        std::string name;                                      // name reported by the driver
+        unsigned int capabilities;                             // combination of DeviceCapability flags
+        bool monotonicTime;                                    // are the events stamped with the monotonic clock?
+    };
+
     sf::Mutex         inpMutex;                                // threadsafe? maybe...
     sf::Vector2i      mousePos;                                // current mouse position
+    bool              mouseMoved = false;                      // has mousePos changed since the last SYN_REPORT?
+
+    std::vector<InputDevice> devices;                          // keyboards, mice and touchscreens in /dev/input
+    int epollFd = -1;                                          // epoll instance watching the devices, inotifyFd and stdin
+    int inotifyFd = -1;                                        // inotify instance watching /dev/input for hotplug
+    bool terminalModified = false;                             // did we switch stdin to non-canonical mode?
+    struct termios oldTerminal;                                // stdin mode to restore on exit
 
-    std::vector<int>  fds;                                     // list of open file descriptors for /dev/input
     std::vector<bool> mouseMap(sf::Mouse::ButtonCount, false); // track whether keys are down
     std::vector<bool> keyMap(sf::Keyboard::KeyCount, false);   // track whether mouse buttons are down
 
@@ -77,52 +107,25 @@ namespace
     std::vector<TouchSlot> touchSlots;                         // track the state of each touch "slot"
     int currentSlot = 0;                                       // which slot are we currently updating?
 
-    std::queue<sf::Event> eventQueue;                          // events received and waiting to be consumed
-    const int MAX_QUEUE = 64;                                  // The maximum size we let eventQueue grow to
+    sf::priv::SpscRing<sf::Event> eventRing( 512 );            // events received and waiting to be consumed
+    unsigned int pushedEvents = 0;                             // events pushed into eventRing so far
+    sf::Uint64 droppedEvents = 0;                              // events lost because eventRing was full
+    sf::Uint64 reportedDrops = 0;                              // value of droppedEvents when last reported
+    sf::Time eventTime;                                        // timestamp of the events being generated
+
+#ifdef SFML_RPI_INPUT_THREAD
+    sf::Thread* inputThread = NULL;                            // reads the devices as soon as they are ready
+    int stopFd = -1;                                           // eventfd in the epoll set, signaled to stop inputThread
+    int notifyFd = -1;                                         // eventfd signaled by inputThread when it pushes events
+#endif
+
+    const int EVENT_BATCH = 64;                                // number of input_events read at once from a device
 
     bool altDown() { return ( keyMap[sf::Keyboard::LAlt] || keyMap[sf::Keyboard::RAlt] ); }
     bool controlDown() { return ( keyMap[sf::Keyboard::LControl] || keyMap[sf::Keyboard::RControl] ); }
     bool shiftDown() { return ( keyMap[sf::Keyboard::LShift] || keyMap[sf::Keyboard::RShift] ); }
     bool systemDown() { return ( keyMap[sf::Keyboard::LSystem] || keyMap[sf::Keyboard::RSystem] ); }
 
-    void uninit( void )
-    {
-        for ( std::vector<int>::iterator itr=fds.begin(); itr != fds.end(); ++itr )
-            close( *itr );
-    }
-
-    void init()
-    {
-        for ( int i=0; i<32; i++ )
-        {
-            std::string name( "/dev/input/event" );
-            std::ostringstream ss;
-            ss << i;
-            name += ss.str();
-
-            int temp_fd = open( name.c_str(), O_RDONLY | O_NONBLOCK );
-
-            if ( temp_fd < 0 )
-            {
-                if ( errno != ENOENT )
-                    sf::err() << "Error opening " << name << ": " << strerror( errno ) << std::endl;
-
-                continue;
-            }
-
-            // TODO:
-            //
-            // For now we blindly keep all file descriptors open... maybe try
-            // to figure out if fd is a mouse or keyboard and close the rest?
-            //
-            // see: ioctl( fd, EVIOCGNAME( sizeof(buff), buff );
-            //
-            fds.push_back( temp_fd );
-        }
-
-        atexit( uninit );
-    }
-
     sf::Mouse::Button toMouseButton( int c )
     {
         switch ( c )
@@ -257,10 +260,240 @@ namespace
 
     void pushEvent( sf::Event& ev )
     {
-        if ( eventQueue.size() >= MAX_QUEUE )
-            eventQueue.pop();
+        ev.timestamp = eventTime;
+
+        if ( eventRing.push( ev ))
+            ++pushedEvents;
+        else
+            ++droppedEvents;
+    }
+
+    // assumes inpMutex is locked
+    void reportDroppedEvents()
+    {
+        if ( droppedEvents != reportedDrops )
+        {
+            sf::err() << ( droppedEvents - reportedDrops ) << " input events were dropped, the event queue is full" << std::endl;
+            reportedDrops = droppedEvents;
+        }
+    }
+
+    // Convert the kernel timestamp of an input_event
+    sf::Time toTime( const struct input_event& ie )
+    {
+#if defined( input_event_sec )
+        return sf::microseconds( static_cast<sf::Int64>( ie.input_event_sec ) * 1000000 + ie.input_event_usec );
+#else
+        return sf::microseconds( static_cast<sf::Int64>( ie.time.tv_sec ) * 1000000 + ie.time.tv_usec );
+#endif
+    }
+
+    bool testBit( const unsigned long* bits, int bit )
+    {
+        const int bitsPerLong = sizeof( unsigned long ) * 8;
+        return ( bits[bit / bitsPerLong] >> ( bit % bitsPerLong ) ) & 1;
+    }
+
+    // Find out whether a device is a keyboard, a mouse or a touchscreen, from
+    // the event types and codes it reports. Other devices (joysticks, power
+    // buttons, accelerometers...) are of no use here.
+    //
+    unsigned int classifyDevice( int fd )
+    {
+        const int bitsPerLong = sizeof( unsigned long ) * 8;
+        unsigned long evBits[EV_MAX / bitsPerLong + 1] = {0};
+        unsigned long keyBits[KEY_MAX / bitsPerLong + 1] = {0};
+        unsigned long relBits[REL_MAX / bitsPerLong + 1] = {0};
+        unsigned long absBits[ABS_MAX / bitsPerLong + 1] = {0};
+
+        if ( ioctl( fd, EVIOCGBIT( 0, sizeof( evBits ) ), evBits ) < 0 )
+            return 0;
+
+        unsigned int capabilities = 0;
+
+        if ( testBit( evBits, EV_KEY ) && ( ioctl( fd, EVIOCGBIT( EV_KEY, sizeof( keyBits ) ), keyBits ) >= 0 ))
+        {
+            for ( int code = KEY_ESC; code < BTN_MISC; ++code )
+            {
+                if ( testBit( keyBits, code ) && ( toKey( code ) != sf::Keyboard::Unknown ))
+                {
+                    capabilities |= KeyboardDevice;
+                    break;
+                }
+            }
+
+            if ( testBit( keyBits, BTN_LEFT ))
+                capabilities |= MouseDevice;
+        }
+
+        if ( testBit( evBits, EV_REL ) && ( ioctl( fd, EVIOCGBIT( EV_REL, sizeof( relBits ) ), relBits ) >= 0 ))
+        {
+            if ( testBit( relBits, REL_X ) || testBit( relBits, REL_WHEEL ))
+                capabilities |= MouseDevice;
+        }
+
+        if ( testBit( evBits, EV_ABS ) && ( ioctl( fd, EVIOCGBIT( EV_ABS, sizeof( absBits ) ), absBits ) >= 0 ))
+        {
+            if ( testBit( absBits, ABS_MT_POSITION_X ))
+                capabilities |= TouchDevice;
+        }
+
+        return capabilities;
+    }
+
+    void openDevice( const std::string& path )
+    {
+        for ( std::vector<InputDevice>::iterator itr=devices.begin(); itr != devices.end(); ++itr )
+        {
+            if ( itr->path == path )
+                return;
+        }
+
+        int fd = open( path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC );
+        if ( fd < 0 )
+        {
+            // Freshly plugged devices may not have their permissions set yet,
+            // we'll try again when their attributes change
+            if (( errno != ENOENT ) && ( errno != EACCES ))
+                sf::err() << "Error opening " << path << ": " << strerror( errno ) << std::endl;
+
+            return;
+        }
+
+        InputDevice device;
+        device.fd = fd;
+        device.path = path;
+        device.capabilities = classifyDevice( fd );
+
+        if ( device.capabilities == 0 )
+        {
+            close( fd );
+            return;
+        }
+
+        char name[256] = "Unknown";
+        ioctl( fd, EVIOCGNAME( sizeof( name ) ), name );
+        name[sizeof( name ) - 1] = 0;
+        device.name = name;
+
+        // Have the kernel stamp the events with the clock of sf::Clock (it
+        // uses the realtime clock by default); old kernels can't do it
+        //
+        int clockId = CLOCK_MONOTONIC;
+        device.monotonicTime = ( ioctl( fd, EVIOCSCLOCKID, &clockId ) == 0 );
+
+        struct epoll_event ee;
+        memset( &ee, 0, sizeof( ee ));
+        ee.events = EPOLLIN;
+        ee.data.fd = fd;
+        if ( epoll_ctl( epollFd, EPOLL_CTL_ADD, fd, &ee ) < 0 )
+        {
+            sf::err() << "Error watching " << path << " (" << device.name << "): " << strerror( errno ) << std::endl;
+            close( fd );
+            return;
+        }
+
+        devices.push_back( device );
+    }
+
+    void closeDevice( std::size_t index )
+    {
+        // Closing the file descriptor also removes it from the epoll set
+        if ( devices[index].fd == touchFd )
+        {
+            touchFd = -1;
+            touchSlots.clear();
+        }
+
+        close( devices[index].fd );
+        devices.erase( devices.begin() + index );
+    }
+
+    bool isEventDevice( const char* name )
+    {
+        return strncmp( name, "event", 5 ) == 0;
+    }
+
+#ifdef SFML_RPI_INPUT_THREAD
+    void stopInputThread();
+#endif
+
+    void uninit( void )
+    {
+#ifdef SFML_RPI_INPUT_THREAD
+        stopInputThread();
+#endif
+
+        while ( !devices.empty() )
+            closeDevice( devices.size() - 1 );
+
+        if ( inotifyFd >= 0 )
+            close( inotifyFd );
+
+        if ( epollFd >= 0 )
+            close( epollFd );
+
+        if ( terminalModified )
+            tcsetattr( STDIN_FILENO, TCSANOW, &oldTerminal );
+    }
+
+    void init()
+    {
+        epollFd = epoll_create1( EPOLL_CLOEXEC );
+        if ( epollFd < 0 )
+        {
+            sf::err() << "Error creating the input epoll instance: " << strerror( errno ) << std::endl;
+            return;
+        }
+
+        struct epoll_event ee;
+        memset( &ee, 0, sizeof( ee ));
+        ee.events = EPOLLIN;
+
+        // Watch /dev/input for devices being plugged and unplugged. IN_ATTRIB
+        // catches the devices that were not accessible yet when created.
+        //
+        inotifyFd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+        if (( inotifyFd >= 0 ) && ( inotify_add_watch( inotifyFd, "/dev/input", IN_CREATE | IN_ATTRIB | IN_DELETE ) >= 0 ))
+        {
+            ee.data.fd = inotifyFd;
+            epoll_ctl( epollFd, EPOLL_CTL_ADD, inotifyFd, &ee );
+        }
+        else
+        {
+            sf::err() << "Error watching /dev/input, input devices won't be hotplugged: " << strerror( errno ) << std::endl;
+        }
+
+        // Open the devices already plugged
+        //
+        DIR* dir = opendir( "/dev/input" );
+        if ( dir )
+        {
+            while ( struct dirent* entry = readdir( dir ))
+            {
+                if ( isEventDevice( entry->d_name ))
+                    openDevice( std::string( "/dev/input/" ) + entry->d_name );
+            }
+
+            closedir( dir );
+        }
 
-        eventQueue.push( ev );
+        // Text is read from stdin; switch the terminal to non-canonical mode
+        // once, so that the characters are available as soon as they are typed
+        //
+        if ( isatty( STDIN_FILENO ) && ( tcgetattr( STDIN_FILENO, &oldTerminal ) == 0 ))
+        {
+            struct termios newt = oldTerminal;
+            newt.c_lflag &= ~( ICANON | ECHO );
+            newt.c_cc[VMIN] = 0;
+            newt.c_cc[VTIME] = 0;
+            terminalModified = ( tcsetattr( STDIN_FILENO, TCSANOW, &newt ) == 0 );
+
+            ee.data.fd = STDIN_FILENO;
+            epoll_ctl( epollFd, EPOLL_CTL_ADD, STDIN_FILENO, &ee );
+        }
+
+        atexit( uninit );
     }
 
     TouchSlot& atSlot( int idx )
@@ -281,9 +514,13 @@ namespace
 
             if ( slot->oldId == slot->id )
             {
-                ev.type = sf::Event::TouchMoved;
-                ev.touch.finger = slot->id;
-                pushEvent( ev );
+                // Only the slots that actually moved are reported
+                if (( slot->id != -1 ) && ( slot->pos != slot->oldPos ))
+                {
+                    ev.type = sf::Event::TouchMoved;
+                    ev.touch.finger = slot->id;
+                    pushEvent( ev );
+                }
             }
             else
             {
@@ -302,231 +539,388 @@ namespace
 
                 slot->oldId = slot->id;
             }
+
+            slot->oldPos = slot->pos;
         }
     }
 
-    bool eventProcess( sf::Event &ev )
+    // Translate an input_event read from the device fd, and queue the resulting events
+    void processInputEvent( const struct input_event& ie, int fd )
     {
-        sf::Lock lock( inpMutex );
+        sf::Event ev;
 
-        // Ensure that we are initialized
-        //
-        static bool initialized = false;
-        if ( !initialized )
+        if ( ie.type == EV_KEY )
         {
-            init();
-            initialized = true;
-        }
+            sf::Mouse::Button mb = toMouseButton( ie.code );
+            if ( mb != sf::Mouse::ButtonCount )
+            {
+                ev.type = ie.value ? sf::Event::MouseButtonPressed : sf::Event::MouseButtonReleased;
+                ev.mouseButton.button = mb;
+                ev.mouseButton.x = mousePos.x;
+                ev.mouseButton.y = mousePos.y;
 
-        // This is for handling the Backspace and DEL text events, which we
-        // generate based on keystrokes (and not stdin)
-        //
-        static int doDeferredText=0;
-        if ( doDeferredText )
+                mouseMap[mb] = ie.value;
+                pushEvent( ev );
+            }
+            else
+            {
+                sf::Keyboard::Key kb = toKey( ie.code );
+
+                // Backspace and DEL text events are generated from the
+                // keystrokes (and not stdin)
+                //
+                int special = 0;
+                if (( kb == sf::Keyboard::Delete )
+                        || ( kb == sf::Keyboard::BackSpace ))
+                    special = ( kb == sf::Keyboard::Delete ) ? 127 : 8;
+
+                if ( ie.value == 2 )
+                {
+                    // key repeat events
+                    //
+                    if ( special )
+                    {
+                        ev.type = sf::Event::TextEntered;
+                        ev.text.unicode = special;
+                        pushEvent( ev );
+                    }
+                }
+                else if ( kb != sf::Keyboard::Unknown )
+                {
+                    // key down and key up events
+                    //
+                    ev.type = ie.value ? sf::Event::KeyPressed : sf::Event::KeyReleased;
+                    ev.key.code = kb;
+                    ev.key.alt = altDown();
+                    ev.key.control = controlDown();
+                    ev.key.shift = shiftDown();
+                    ev.key.system = systemDown();
+
+                    keyMap[kb] = ie.value;
+                    pushEvent( ev );
+
+                    if ( special && ie.value )
+                    {
+                        ev.type = sf::Event::TextEntered;
+                        ev.text.unicode = special;
+                        pushEvent( ev );
+                    }
+                }
+            }
+        }
+        else if ( ie.type == EV_REL )
         {
-            ev.type = sf::Event::TextEntered;
-            ev.text.unicode = doDeferredText;
-            doDeferredText = 0;
-            return true;
+            switch ( ie.code )
+            {
+            case REL_X:
+                mousePos.x += ie.value;
+                mouseMoved = true;
+                break;
+
+            case REL_Y:
+                mousePos.y += ie.value;
+                mouseMoved = true;
+                break;
+
+            case REL_WHEEL:
+                ev.type = sf::Event::MouseWheelMoved;
+                ev.mouseWheel.delta = ie.value;
+                ev.mouseWheel.x = mousePos.x;
+                ev.mouseWheel.y = mousePos.y;
+                pushEvent( ev );
+                break;
+            }
+        }
+        else if ( ie.type == EV_ABS )
+        {
+            switch ( ie.code )
+            {
+            case ABS_MT_SLOT:
+                currentSlot = ie.value;
+                touchFd = fd;
+                break;
+            case ABS_MT_TRACKING_ID:
+                atSlot(currentSlot).id = ie.value;
+                touchFd = fd;
+                break;
+            case ABS_MT_POSITION_X:
+                atSlot(currentSlot).pos.x = ie.value;
+                touchFd = fd;
+                break;
+            case ABS_MT_POSITION_Y:
+                atSlot(currentSlot).pos.y = ie.value;
+                touchFd = fd;
+                break;
+            }
+        }
+        else if ( ie.type == EV_SYN && ie.code == SYN_REPORT )
+        {
+            // A report groups the changes of both axes, so that a diagonal
+            // motion generates a single event
+            if ( mouseMoved )
+            {
+                ev.type = sf::Event::MouseMoved;
+                ev.mouseMove.x = mousePos.x;
+                ev.mouseMove.y = mousePos.y;
+                pushEvent( ev );
+                mouseMoved = false;
+            }
+
+            if ( fd == touchFd )
+                processSlots();
         }
+    }
 
-        // Check all the open file descriptors for the next event
-        //
-        for ( std::vector<int>::iterator itr=fds.begin(); itr != fds.end(); ++itr )
+    // Read all the pending input_events of a device, a batch at a time
+    void readDevice( std::size_t index )
+    {
+        int fd = devices[index].fd;
+        bool monotonicTime = devices[index].monotonicTime;
+        struct input_event buffer[EVENT_BATCH];
+
+        for (;;)
         {
-            struct input_event ie;
-            int rd = read(
-                *itr,
-                &ie,
-                sizeof( ie ) );
+            ssize_t rd = read( fd, buffer, sizeof( buffer ));
 
-            while ( rd > 0 )
+            if ( rd < 0 )
             {
-                if ( ie.type == EV_KEY )
-                {
-                    sf::Mouse::Button mb = toMouseButton( ie.code );
-                    if ( mb != sf::Mouse::ButtonCount )
-                    {
-                        ev.type = ie.value ? sf::Event::MouseButtonPressed : sf::Event::MouseButtonReleased;
-                        ev.mouseButton.button = mb;
-                        ev.mouseButton.x = mousePos.x;
-                        ev.mouseButton.y = mousePos.y;
+                if ( errno == ENODEV )
+                    closeDevice( index ); // unplugged
+                else if (( errno != EAGAIN ) && ( errno != EINTR ))
+                    sf::err() << " Error: " << strerror( errno ) << std::endl;
 
-                        mouseMap[mb] = ie.value;
-                        return true;
-                    }
-                    else
-                    {
-                        sf::Keyboard::Key kb = toKey( ie.code );
+                return;
+            }
 
-                        int special = 0;
-                        if (( kb == sf::Keyboard::Delete )
-                                || ( kb == sf::Keyboard::BackSpace ))
-                            special = ( kb == sf::Keyboard::Delete ) ? 127 : 8;
+            if ( !monotonicTime )
+                eventTime = sf::Clock::getCurrentTime();
 
-                        if ( ie.value == 2 )
-                        {
-                            // key repeat events
-                            //
-                            if ( special )
-                            {
-                                ev.type = sf::Event::TextEntered;
-                                ev.text.unicode = special;
-                                return true;
-                            }
-                        }
-                        else if ( kb != sf::Keyboard::Unknown )
-                        {
-                            // key down and key up events
-                            //
-                            ev.type = ie.value ? sf::Event::KeyPressed : sf::Event::KeyReleased;
-                            ev.key.code = kb;
-                            ev.key.alt = altDown();
-                            ev.key.control = controlDown();
-                            ev.key.shift = shiftDown();
-                            ev.key.system = systemDown();
+            int count = rd / sizeof( struct input_event );
+            for ( int i = 0; i < count; ++i )
+            {
+                if ( monotonicTime )
+                    eventTime = toTime( buffer[i] );
 
-                            keyMap[kb] = ie.value;
+                processInputEvent( buffer[i], fd );
+            }
 
-                            if ( special && ie.value )
-                                doDeferredText = special;
+            if ( count < EVENT_BATCH )
+                return;
+        }
+    }
 
-                            return true;
-                        }
-                    }
-                }
-                else if ( ie.type == EV_REL )
-                {
-                    bool posChange = false;
-                    switch ( ie.code )
-                    {
-                    case REL_X:
-                        mousePos.x += ie.value;
-                        posChange = true;
-                        break;
-
-                    case REL_Y:
-                        mousePos.y += ie.value;
-                        posChange = true;
-                        break;
-
-                    case REL_WHEEL:
-                        ev.type = sf::Event::MouseWheelMoved;
-                        ev.mouseWheel.delta = ie.value;
-                        ev.mouseWheel.x = mousePos.x;
-                        ev.mouseWheel.y = mousePos.y;
-                        return true;
-                    }
+    // Open and close the devices plugged and unplugged since the last call
+    void readHotplug()
+    {
+        char buffer[4096] __attribute__(( aligned( __alignof__( struct inotify_event ))));
 
-                    if ( posChange )
-                    {
-                        ev.type = sf::Event::MouseMoved;
-                        ev.mouseMove.x = mousePos.x;
-                        ev.mouseMove.y = mousePos.y;
-                        return true;
-                    }
-                }
-                else if ( ie.type == EV_ABS )
+        for (;;)
+        {
+            ssize_t rd = read( inotifyFd, buffer, sizeof( buffer ));
+            if ( rd <= 0 )
+                return;
+
+            for ( char* ptr = buffer; ptr < buffer + rd; )
+            {
+                const struct inotify_event* ie = reinterpret_cast<const struct inotify_event*>( ptr );
+                ptr += sizeof( struct inotify_event ) + ie->len;
+
+                if (( ie->len == 0 ) || !isEventDevice( ie->name ))
+                    continue;
+
+                std::string path = std::string( "/dev/input/" ) + ie->name;
+
+                if ( ie->mask & IN_DELETE )
                 {
-                    switch ( ie.code )
+                    for ( std::size_t i = 0; i < devices.size(); ++i )
                     {
-                    case ABS_MT_SLOT:
-                        currentSlot = ie.value;
-                        touchFd = *itr;
-                        break;
-                    case ABS_MT_TRACKING_ID:
-                        atSlot(currentSlot).id = ie.value;
-                        touchFd = *itr;
-                        break;
-                    case ABS_MT_POSITION_X:
-                        atSlot(currentSlot).pos.x = ie.value;
-                        touchFd = *itr;
-                        break;
-                    case ABS_MT_POSITION_Y:
-                        atSlot(currentSlot).pos.y = ie.value;
-                        touchFd = *itr;
-                        break;
+                        if ( devices[i].path == path )
+                        {
+                            closeDevice( i );
+                            break;
+                        }
                     }
                 }
-                else if ( ie.type == EV_SYN && ie.code == SYN_REPORT &&
-                          *itr == touchFd)
+                else
                 {
-                    // This pushes events directly to the queue, because it
-                    // can generate more than one event.
-                    processSlots();
+                    openDevice( path );
                 }
-
-                rd = read( *itr, &ie, sizeof( ie ) );
             }
-
-            if (( rd < 0 ) && ( errno != EAGAIN ))
-                sf::err() << " Error: " << strerror( errno ) << std::endl;
         }
+    }
 
-        // Finally check if there is a Text event on stdin
-        //
-        struct termios newt, oldt;
-        tcgetattr( STDIN_FILENO, &oldt );
+    // Generate text events from the characters typed on stdin
+    void readText()
+    {
+        unsigned char buffer[16];
+        ssize_t rd = read( STDIN_FILENO, buffer, sizeof( buffer ));
+        eventTime = sf::Clock::getCurrentTime();
 
-        newt = oldt;
-        newt.c_lflag &= ~( ICANON | ECHO );
-        tcsetattr( STDIN_FILENO, TCSANOW, &newt );
+        for ( ssize_t i = 0; i < rd; ++i )
+        {
+            unsigned char c = buffer[i];
 
-        struct timeval tv;
-        tv.tv_sec = 0;
-        tv.tv_usec = 0;
+            // Suppress ANSI escape sequences (the rest of the buffer)
+            if ( c == 27 )
+                break;
 
-        unsigned char c=0;
+            // Suppress 127 (DEL) and 8 (BACKSPACE), generated from the keystrokes
+            if (( c == 127 ) || ( c == 8 ))
+                continue;
 
-        fd_set rdfs;
-        FD_ZERO( &rdfs );
-        FD_SET( STDIN_FILENO, &rdfs );
-        int sel = select( STDIN_FILENO+1, &rdfs, NULL, NULL, &tv );
+            // TODO: Proper unicode handling
+            sf::Event ev;
+            ev.type = sf::Event::TextEntered;
+            ev.text.unicode = c;
+            pushEvent( ev );
+        }
+    }
 
-        if ( sel > 0 && FD_ISSET( STDIN_FILENO, &rdfs ) )
-            read( STDIN_FILENO, &c, 1 );
+    // Read the file descriptor reported as ready by epollFd
+    // assumes inpMutex is locked
+    void readReady( int fd )
+    {
+        if ( fd == inotifyFd )
+        {
+            readHotplug();
+        }
+        else if ( fd == STDIN_FILENO )
+        {
+            readText();
+        }
+        else
+        {
+            // The device may have been closed by a previous hotplug event
+            for ( std::size_t i = 0; i < devices.size(); ++i )
+            {
+                if ( devices[i].fd == fd )
+                {
+                    readDevice( i );
+                    break;
+                }
+            }
+        }
+    }
 
-        if (( c == 127 ) || ( c == 8 ))  // Suppress 127 (DEL) to 8 (BACKSPACE)
-            c = 0;
-        else if ( c == 27 )  // ESC
+#ifdef SFML_RPI_INPUT_THREAD
+    // Read the devices as soon as they are ready, so that the events are
+    // timestamped and queued even when the application is busy rendering
+    void runInputThread()
+    {
+        for (;;)
         {
-            // Suppress ANSI escape sequences
-            //
-            FD_ZERO( &rdfs );
-            FD_SET( STDIN_FILENO, &rdfs );
-            sel = select( STDIN_FILENO+1, &rdfs, NULL, NULL, &tv );
-            if ( sel > 0 && FD_ISSET( STDIN_FILENO, &rdfs ) )
+            struct epoll_event ready[16];
+            int count = epoll_wait( epollFd, ready, 16, -1 );
+            if ( count < 0 )
             {
-                unsigned char buff[16];
-                int rd = read( STDIN_FILENO, buff, 16 );
-                c = 0;
+                if ( errno == EINTR )
+                    continue;
+
+                sf::err() << "Error waiting for input: " << strerror( errno ) << std::endl;
+                return;
             }
+
+            sf::Lock lock( inpMutex );
+            unsigned int previouslyPushed = pushedEvents;
+
+            for ( int i = 0; i < count; ++i )
+            {
+                if ( ready[i].data.fd == stopFd )
+                    return;
+
+                readReady( ready[i].data.fd );
+            }
+
+            // Wake up the window waiting for events
+            if ( pushedEvents != previouslyPushed )
+            {
+                if ( eventfd_write( notifyFd, 1 ) < 0 )
+                    sf::err() << "Error notifying input events: " << strerror( errno ) << std::endl;
+            }
+        }
+    }
+
+    void stopInputThread()
+    {
+        if ( inputThread )
+        {
+            if ( eventfd_write( stopFd, 1 ) == 0 )
+                inputThread->wait();
+            else
+                inputThread->terminate();
+
+            delete inputThread;
+            inputThread = NULL;
         }
 
-        tcsetattr( STDIN_FILENO, TCSANOW, &oldt );
+        if ( stopFd >= 0 )
+            close( stopFd );
+
+        if ( notifyFd >= 0 )
+            close( notifyFd );
+    }
 
-        if ( c > 0 )
+    void startInputThread()
+    {
+        stopFd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+        notifyFd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+        if (( stopFd < 0 ) || ( notifyFd < 0 ))
         {
-            // TODO: Proper unicode handling
-            ev.type = sf::Event::TextEntered;
-            ev.text.unicode = c;
-            return true;
+            sf::err() << "Error creating the input thread events: " << strerror( errno ) << std::endl;
+            return;
         }
 
-        // No events available
-        //
-        return false;
+        struct epoll_event ee;
+        memset( &ee, 0, sizeof( ee ));
+        ee.events = EPOLLIN;
+        ee.data.fd = stopFd;
+        epoll_ctl( epollFd, EPOLL_CTL_ADD, stopFd, &ee );
+
+        inputThread = new sf::Thread( &runInputThread );
+        inputThread->launch();
     }
+#endif
 
     // assumes inpMutex is locked
-    void update()
+    void ensureInitialized()
     {
-        sf::Event ev;
-        while ( eventProcess( ev ) )
+        static bool initialized = false;
+        if ( !initialized )
         {
-            pushEvent( ev );
+            init();
+            initialized = true;
+
+#ifdef SFML_RPI_INPUT_THREAD
+            if ( epollFd >= 0 )
+                startInputThread();
+#endif
         }
     }
+
+    // assumes inpMutex is locked
+    void update()
+    {
+        ensureInitialized();
+
+        if ( epollFd < 0 )
+            return;
+
+#ifdef SFML_RPI_INPUT_THREAD
+        // The devices are read by the input thread, nothing to do here
+        //
+        if ( inputThread )
+            return;
+#endif
+
+        // Only the file descriptors that have something to read are reported,
+        // so polling costs a single syscall when no input is pending
+        //
+        struct epoll_event ready[16];
+        int count = epoll_wait( epollFd, ready, 16, 0 );
+
+        for ( int i = 0; i < count; ++i )
+            readReady( ready[i].data.fd );
+    }
 };
 
 namespace sf
@@ -597,6 +991,7 @@ void InputImpl::setMousePosition(const Vector2i& position, const Window& relativ
 ////////////////////////////////////////////////////////////
 bool InputImpl::isTouchDown(unsigned int finger)
 {
+    Lock lock( inpMutex );
     for ( std::vector<TouchSlot>::iterator slot=touchSlots.begin(); slot != touchSlots.end(); ++slot )
     {
         if ( slot->id == finger )
@@ -610,6 +1005,7 @@ bool InputImpl::isTouchDown(unsigned int finger)
 ////////////////////////////////////////////////////////////
 Vector2i InputImpl::getTouchPosition(unsigned int finger)
 {
+    Lock lock( inpMutex );
     for ( std::vector<TouchSlot>::iterator slot=touchSlots.begin(); slot != touchSlots.end(); ++slot )
     {
         if ( slot->id == finger )
@@ -629,34 +1025,56 @@ Vector2i InputImpl::getTouchPosition(unsigned int finger, const Window& /*relati
 ////////////////////////////////////////////////////////////
 bool InputImpl::checkEvent( sf::Event &ev )
 {
-    Lock lock( inpMutex );
-    if ( !eventQueue.empty() )
-    {
-        ev = eventQueue.front();
-        eventQueue.pop();
-
+    // This is the only consumer of eventRing, so it can be read without locking
+    if ( eventRing.pop( ev ))
         return true;
-    }
 
-    if ( eventProcess( ev ) )
+    Lock lock( inpMutex );
+    reportDroppedEvents();
+    update();
+
+#ifdef SFML_RPI_INPUT_THREAD
+    // Acknowledge the notifications of the input thread only here: waitEvent
+    // blocks on them, so isKeyPressed & co. must not consume them
+    if ( inputThread )
     {
-        return true;
+        eventfd_t notifications;
+        eventfd_read( notifyFd, &notifications );
     }
-    else
-    {
-        // In the case of multitouch, eventProcess() could have returned false
-        // but added events directly to the queue.  (This is ugly, but I'm not
-        // sure of a good way to handle generating multiple events at once.)
-        if ( !eventQueue.empty() )
-        {
-            ev = eventQueue.front();
-            eventQueue.pop();
+#endif
 
-            return true;
-        }
-    }
+    return eventRing.pop( ev );
+}
 
-    return false;
+
+////////////////////////////////////////////////////////////
+int InputImpl::getFileDescriptor()
+{
+    Lock lock( inpMutex );
+    ensureInitialized();
+
+#ifdef SFML_RPI_INPUT_THREAD
+    if ( inputThread )
+        return notifyFd;
+#endif
+
+    return epollFd;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 InputImpl::getDroppedEventCount()
+{
+    Lock lock( inpMutex );
+    return droppedEvents;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t InputImpl::getPendingEventCount()
+{
+    // Called by the thread that consumes eventRing, so its size can be read without locking
+    return eventRing.getSize();
 }
 
 } // namespace priv
@@ -165,6 +165,34 @@ public:
     ////////////////////////////////////////////////////////////
     ////////////////////////////////////////////////////////////
     static bool checkEvent( sf::Event &ev );
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a file descriptor that becomes readable on input activity
+    ///
+    /// The descriptor is an epoll instance watching the input
+    /// devices, their hotplug notifications and the terminal,
+    /// so it can itself be waited for with poll().
+    ///
+    /// \return File descriptor, or -1 if input is not available
+    ///
+    ////////////////////////////////////////////////////////////
+    static int getFileDescriptor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of events lost because the event queue was full
+    ///
+    /// \return Number of dropped events since the initialization
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getDroppedEventCount();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of events waiting in the event queue
+    ///
+    /// \return Number of events not yet returned by checkEvent
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getPendingEventCount();
 };
 
 } // namespace priv
@@ -31,8 +31,11 @@
 #include <SFML/Window/WindowStyle.hpp> // important to be included first (conflict with None)
 #include <SFML/Window/RPi/WindowImplRPi.hpp>
 #include <SFML/Window/RPi/InputImpl.hpp>
+#include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/System/Err.hpp>
+#include <vector>
+#include <poll.h>
 
 ////////////////////////////////////////////////////////////
 // Private data
@@ -207,6 +210,20 @@ bool WindowImplRPi::hasFocus() const
     return true;
 }
 
+
+////////////////////////////////////////////////////////////
+Uint64 WindowImplRPi::getDroppedEventCount() const
+{
+    return InputImpl::getDroppedEventCount();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t WindowImplRPi::getSystemPendingEventCount() const
+{
+    return InputImpl::getPendingEventCount();
+}
+
 void WindowImplRPi::processEvents()
 {
     sf::Event ev;
@@ -214,6 +231,33 @@ void WindowImplRPi::processEvents()
         pushEvent( ev );
 }
 
+void WindowImplRPi::waitForEvents(Time timeout)
+{
+    std::vector<int> descriptors;
+    if ( !JoystickImpl::getFileDescriptors( descriptors ) )
+    {
+        // Joystick connections are only detected by polling
+        if (( timeout < Time::Zero ) || ( timeout > milliseconds( 10 ) ))
+            timeout = milliseconds( 10 );
+    }
+
+    int inputFd = InputImpl::getFileDescriptor();
+    if ( inputFd >= 0 )
+        descriptors.push_back( inputFd );
+
+    std::vector<pollfd> fds( descriptors.size() );
+    for ( std::size_t i = 0; i < descriptors.size(); ++i )
+    {
+        fds[i].fd = descriptors[i];
+        fds[i].events = POLLIN;
+        fds[i].revents = 0;
+    }
+
+    // Round up, so that the deadline is not reached by spinning on a null timeout
+    int ms = ( timeout < Time::Zero ) ? -1 : static_cast<int>( ( timeout.asMicroseconds() + 999 ) / 1000 );
+    poll( fds.empty() ? NULL : &fds[0], fds.size(), ms );
+}
+
 void WindowImplRPi::setMouseCursorGrabbed(bool grabbed)
 {
     //TODO: not implemented
@@ -180,6 +180,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual bool hasFocus() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of events lost because the input queue was full
+    ///
+    /// \return Number of dropped events
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 getDroppedEventCount() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -188,6 +196,22 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the input devices or joysticks are ready
+    ///
+    /// \param timeout Maximum time to wait, negative to wait without limit
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitForEvents(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of events waiting in the input queue
+    ///
+    /// \return Number of events read from the devices but not yet processed
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual std::size_t getSystemPendingEventCount() const;
+
 private:
  // by trngaje
     //DISPMANX_DISPLAY_HANDLE_T m_display;
@@ -27,14 +27,19 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/System/Err.hpp>
-#include <linux/joystick.h>
+#include <SFML/System/Clock.hpp>
 #include <libudev.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <time.h>
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cstring>
+#include <cmath>
 
 namespace
 {
@@ -51,10 +56,15 @@ namespace
     typedef std::vector<JoystickRecord> JoystickList;
     JoystickList joystickList;
 
+    // epoll instance watching the opened joysticks (tagged by their index) and the udev monitor
+    int epollFd = -1;
+    const sf::Uint32 monitorTag = sf::Joystick::Count;
+
+    // The joysticks plugged before the initialization have not been notified by the udev monitor
+    bool initialScanPending = false;
+
     bool isJoystick(udev_device* udevDevice)
     {
-        // If anything goes wrong, we go safe and return true
-
         // No device to check, assume not a joystick
         if (!udevDevice)
             return false;
@@ -65,51 +75,21 @@ namespace
         if (!devnode)
             return false;
 
-        // SFML doesn't support evdev yet, so make sure we only handle /js nodes
-        if (!std::strstr(devnode, "/js"))
+        // Joysticks are read through evdev, so make sure we only handle /event nodes
+        // (the /js nodes of the legacy joystick interface are the same devices)
+        if (!std::strstr(devnode, "/event"))
             return false;
 
-        // Check if this device is a joystick
+        // Every input device has an /event node, including keyboards, mice and the
+        // sensors of laptops, so the device must be explicitly classified as a joystick
         if (udev_device_get_property_value(udevDevice, "ID_INPUT_JOYSTICK"))
             return true;
 
-        // Check if this device is something that isn't a joystick
-        // We do this because the absence of any ID_INPUT_ property doesn't
-        // necessarily mean that the device isn't a joystick, whereas the
-        // presence of any ID_INPUT_ property that isn't ID_INPUT_JOYSTICK does
-        if (udev_device_get_property_value(udevDevice, "ID_INPUT_ACCELEROMETER") ||
-            udev_device_get_property_value(udevDevice, "ID_INPUT_KEY") ||
-            udev_device_get_property_value(udevDevice, "ID_INPUT_KEYBOARD") ||
-            udev_device_get_property_value(udevDevice, "ID_INPUT_MOUSE") ||
-            udev_device_get_property_value(udevDevice, "ID_INPUT_TABLET") ||
-            udev_device_get_property_value(udevDevice, "ID_INPUT_TOUCHPAD") ||
-            udev_device_get_property_value(udevDevice, "ID_INPUT_TOUCHSCREEN"))
-            return false;
-
         // On some platforms (older udev), ID_INPUT_ properties are not present, instead
         // the system makes use of the ID_CLASS property to identify the device class
         const char* idClass = udev_device_get_property_value(udevDevice, "ID_CLASS");
 
-        if (idClass)
-        {
-            // Check if the device class matches joystick
-            if (std::strstr(idClass, "joystick"))
-                return true;
-
-            // Check if the device class matches something that isn't a joystick
-            // Rationale same as above
-            if (std::strstr(idClass, "accelerometer") ||
-                std::strstr(idClass, "key") ||
-                std::strstr(idClass, "keyboard") ||
-                std::strstr(idClass, "mouse") ||
-                std::strstr(idClass, "tablet") ||
-                std::strstr(idClass, "touchpad") ||
-                std::strstr(idClass, "touchscreen"))
-                return false;
-        }
-
-        // At this point, assume it is a joystick
-        return true;
+        return idClass && std::strstr(idClass, "joystick");
     }
 
     void updatePluggedList(udev_device* udevDevice = NULL)
@@ -262,6 +242,23 @@ namespace
                FD_ISSET(monitorFd, &descriptorSet);
     }
 
+    // Apply all the pending udev monitor events to the list of joysticks
+    void processMonitorEvents()
+    {
+        while (hasMonitorEvent())
+        {
+            // Check if new joysticks were added/removed since last update
+            udev_device* udevDevice = udev_monitor_receive_device(udevMonitor);
+
+            // If we can get the specific device, we check that,
+            // otherwise just do a full scan if udevDevice == NULL
+            updatePluggedList(udevDevice);
+
+            if (udevDevice)
+                udev_device_unref(udevDevice);
+        }
+    }
+
     // Get a property value from a udev device
     const char* getUdevAttribute(udev_device* udevDevice, const std::string& attributeName)
     {
@@ -396,7 +393,7 @@ namespace
     {
         std::string devnode = joystickList[index].deviceNode;
 
-        // First try using ioctl with JSIOCGNAME
+        // First try using ioctl with EVIOCGNAME
         int fd = ::open(devnode.c_str(), O_RDONLY | O_NONBLOCK);
 
         if (fd >= 0)
@@ -405,7 +402,7 @@ namespace
             char name[128];
             std::memset(name, 0, sizeof(name));
 
-            int result = ioctl(fd, JSIOCGNAME(sizeof(name)), name);
+            int result = ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name);
 
             ::close(fd);
 
@@ -432,6 +429,45 @@ namespace
 
         return std::string("Unknown Joystick");
     }
+
+    // Check if a bit is set in an array of bits returned by an evdev ioctl
+    bool testBit(const unsigned long* bits, int bit)
+    {
+        const int bitsPerLong = sizeof(unsigned long) * 8;
+        return (bits[bit / bitsPerLong] >> (bit % bitsPerLong)) & 1;
+    }
+
+    // Number of unsigned longs needed to store a bit per code, up to maxCode
+    #define BITS_ARRAY_SIZE(maxCode) ((maxCode) / (sizeof(unsigned long) * 8) + 1)
+
+    // Get the SFML axis reported by an absolute axis code, -1 if there is none
+    int toAxis(int code)
+    {
+        switch (code)
+        {
+            case ABS_X:        return sf::Joystick::X;
+            case ABS_Y:        return sf::Joystick::Y;
+            case ABS_Z:
+            case ABS_THROTTLE: return sf::Joystick::Z;
+            case ABS_RZ:
+            case ABS_RUDDER:   return sf::Joystick::R;
+            case ABS_RX:       return sf::Joystick::U;
+            case ABS_RY:       return sf::Joystick::V;
+            case ABS_HAT0X:    return sf::Joystick::PovX;
+            case ABS_HAT0Y:    return sf::Joystick::PovY;
+            default:           return -1;
+        }
+    }
+
+    // Get the time of an event reported by the kernel
+    sf::Time getEventTime(const input_event& event)
+    {
+    #if defined(input_event_sec)
+        return sf::microseconds(static_cast<sf::Int64>(event.input_event_sec) * 1000000 + event.input_event_usec);
+    #else
+        return sf::microseconds(static_cast<sf::Int64>(event.time.tv_sec) * 1000000 + event.time.tv_usec);
+    #endif
+    }
 }
 
 
@@ -441,9 +477,14 @@ namespace priv
 {
 ////////////////////////////////////////////////////////////
 JoystickImpl::JoystickImpl() :
-m_file(-1)
+m_file           (-1),
+m_monotonicTime  (false),
+m_rumbleSupported(false),
+m_effectId       (-1)
 {
-    std::fill(m_mapping, m_mapping + ABS_MAX + 1, 0);
+    std::fill(m_axisMapping, m_axisMapping + ABS_MAX + 1, -1);
+    std::fill(m_buttonMapping, m_buttonMapping + KEY_MAX + 1, static_cast<Uint8>(Joystick::ButtonCount));
+    std::memset(m_axisInfo, 0, sizeof(m_axisInfo));
 }
 
 
@@ -489,14 +530,36 @@ void JoystickImpl::initialize()
         }
     }
 
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+    if (epollFd < 0)
+    {
+        err() << "Failed to create epoll instance, all the joysticks will be polled: " << errno << std::endl;
+    }
+    else if (udevMonitor)
+    {
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.u32 = monitorTag;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, udev_monitor_get_fd(udevMonitor), &event);
+    }
+
     // Do an initial scan
     updatePluggedList();
+    initialScanPending = true;
 }
 
 
 ////////////////////////////////////////////////////////////
 void JoystickImpl::cleanup()
 {
+    if (epollFd >= 0)
+    {
+        ::close(epollFd);
+        epollFd = -1;
+    }
+
     // Unreference the udev monitor to destroy it
     if (udevMonitor)
     {
@@ -522,17 +585,9 @@ bool JoystickImpl::isConnected(unsigned int index)
         // udev monitor is not available, perform a scan every query
         updatePluggedList();
     }
-    else if (hasMonitorEvent())
+    else
     {
-        // Check if new joysticks were added/removed since last update
-        udev_device* udevDevice = udev_monitor_receive_device(udevMonitor);
-
-        // If we can get the specific device, we check that,
-        // otherwise just do a full scan if udevDevice == NULL
-        updatePluggedList(udevDevice);
-
-        if (udevDevice)
-            udev_device_unref(udevDevice);
+        processMonitorEvents();
     }
 
     if (index >= joystickList.size())
@@ -542,6 +597,52 @@ bool JoystickImpl::isConnected(unsigned int index)
     return joystickList[index].plugged;
 }
 
+
+////////////////////////////////////////////////////////////
+bool JoystickImpl::getFileDescriptors(std::vector<int>& descriptors)
+{
+    if (epollFd < 0)
+        return false;
+
+    descriptors.push_back(epollFd);
+
+    // Without a udev monitor, connections are only detected by scanning the devices
+    return udevMonitor != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 JoystickImpl::pollChanges(bool& connectionsChanged)
+{
+    if (epollFd < 0)
+    {
+        connectionsChanged = true;
+        return 0xFFFFFFFF;
+    }
+
+    connectionsChanged = !udevMonitor || initialScanPending;
+    initialScanPending = false;
+    Uint32 pendingJoysticks = 0;
+
+    epoll_event ready[Joystick::Count + 1];
+    int count = epoll_wait(epollFd, ready, Joystick::Count + 1, 0);
+
+    for (int i = 0; i < count; ++i)
+    {
+        if (ready[i].data.u32 == monitorTag)
+        {
+            // Drain the monitor here: it is only read again by isConnected for the
+            // free slots, and while it stays readable epoll keeps reporting it
+            processMonitorEvents();
+            connectionsChanged = true;
+        }
+        else
+            pendingJoysticks |= 1u << ready[i].data.u32;
+    }
+
+    return pendingJoysticks;
+}
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::open(unsigned int index)
 {
@@ -552,24 +653,94 @@ bool JoystickImpl::open(unsigned int index)
     {
         std::string devnode = joystickList[index].deviceNode;
 
-        // Open the joystick's file descriptor (read-only and non-blocking)
-        m_file = ::open(devnode.c_str(), O_RDONLY | O_NONBLOCK);
+        // Open the joystick's file descriptor (non-blocking), with write access if possible
+        // since it is needed to play force feedback effects
+        m_file = ::open(devnode.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        bool writable = (m_file >= 0);
+        if (!writable)
+            m_file = ::open(devnode.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+
         if (m_file >= 0)
         {
-            // Retrieve the axes mapping
-            ioctl(m_file, JSIOCGAXMAP, m_mapping);
+            unsigned long keyBits[BITS_ARRAY_SIZE(KEY_MAX)];
+            unsigned long absBits[BITS_ARRAY_SIZE(ABS_MAX)];
+            unsigned long ffBits[BITS_ARRAY_SIZE(FF_MAX)];
+            std::memset(keyBits, 0, sizeof(keyBits));
+            std::memset(absBits, 0, sizeof(absBits));
+            std::memset(ffBits, 0, sizeof(ffBits));
+            ioctl(m_file, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits);
+            ioctl(m_file, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits);
+            ioctl(m_file, EVIOCGBIT(EV_FF, sizeof(ffBits)), ffBits);
+
+            // Map the buttons in the same order as the legacy joystick interface:
+            // joystick and gamepad buttons first, then the miscellaneous ones
+            m_capabilities = JoystickCaps();
+            for (int code = BTN_JOYSTICK; (code <= KEY_MAX) && (m_capabilities.buttonCount < Joystick::ButtonCount); ++code)
+            {
+                if (testBit(keyBits, code))
+                    m_buttonMapping[code] = static_cast<Uint8>(m_capabilities.buttonCount++);
+            }
+            for (int code = BTN_MISC; (code < BTN_JOYSTICK) && (m_capabilities.buttonCount < Joystick::ButtonCount); ++code)
+            {
+                if (testBit(keyBits, code))
+                    m_buttonMapping[code] = static_cast<Uint8>(m_capabilities.buttonCount++);
+            }
+
+            // Map the axes, and get their range and dead zone
+            for (int code = 0; code <= ABS_MAX; ++code)
+            {
+                int axis = toAxis(code);
+                if ((axis < 0) || m_capabilities.axes[axis] || !testBit(absBits, code))
+                    continue;
+
+                input_absinfo& info = m_axisInfo[axis];
+                if ((ioctl(m_file, EVIOCGABS(code), &info) < 0) || (info.maximum <= info.minimum))
+                    continue;
+
+                // A dead zone covering the whole range would hide the axis
+                if (info.flat * 2 >= info.maximum - info.minimum)
+                    info.flat = 0;
+
+                m_axisMapping[code] = axis;
+                m_capabilities.axes[axis] = true;
+            }
+
+            // Effects can't be played without write access to the device
+            m_rumbleSupported = writable && testBit(ffBits, FF_RUMBLE);
+            m_effectId = -1;
+
+            // Have the kernel stamp the events with the clock of sf::Clock
+            int clockId = CLOCK_MONOTONIC;
+            m_monotonicTime = (ioctl(m_file, EVIOCSCLOCKID, &clockId) == 0);
 
             // Get info
             m_identification.name = getJoystickName(index);
 
-            if (udevContext)
+            input_id id;
+            if ((ioctl(m_file, EVIOCGID, &id) == 0) && id.vendor && id.product)
+            {
+                m_identification.vendorId  = id.vendor;
+                m_identification.productId = id.product;
+            }
+            else if (udevContext)
             {
                 m_identification.vendorId  = getJoystickVendorId(index);
                 m_identification.productId = getJoystickProductId(index);
             }
 
-            // Reset the joystick state
+            // Reset the joystick state, evdev only reports changes so the current one must be read
             m_state = JoystickState();
+            synchronize();
+
+            // Watch the joystick, an error also makes it ready to be updated
+            if (epollFd >= 0)
+            {
+                epoll_event event;
+                std::memset(&event, 0, sizeof(event));
+                event.events = EPOLLIN;
+                event.data.u32 = index;
+                epoll_ctl(epollFd, EPOLL_CTL_ADD, m_file, &event);
+            }
 
             return true;
         }
@@ -586,48 +757,27 @@ bool JoystickImpl::open(unsigned int index)
 ////////////////////////////////////////////////////////////
 void JoystickImpl::close()
 {
+    if (epollFd >= 0)
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, m_file, NULL);
+
+    // Remove the rumble effect, the device may be shared with other applications
+    if (m_effectId >= 0)
+        ioctl(m_file, EVIOCRMFF, m_effectId);
+
     ::close(m_file);
     m_file = -1;
+    m_effectId = -1;
+
+    std::fill(m_axisMapping, m_axisMapping + ABS_MAX + 1, -1);
+    std::fill(m_buttonMapping, m_buttonMapping + KEY_MAX + 1, static_cast<Uint8>(Joystick::ButtonCount));
+    m_capabilities = JoystickCaps();
 }
 
 
 ////////////////////////////////////////////////////////////
 JoystickCaps JoystickImpl::getCapabilities() const
 {
-    JoystickCaps caps;
-
-    if (m_file < 0)
-        return caps;
-
-    // Get the number of buttons
-    char buttonCount;
-    ioctl(m_file, JSIOCGBUTTONS, &buttonCount);
-    caps.buttonCount = buttonCount;
-    if (caps.buttonCount > Joystick::ButtonCount)
-        caps.buttonCount = Joystick::ButtonCount;
-
-    // Get the supported axes
-    char axesCount;
-    ioctl(m_file, JSIOCGAXES, &axesCount);
-    for (int i = 0; i < axesCount; ++i)
-    {
-        switch (m_mapping[i])
-        {
-            case ABS_X:        caps.axes[Joystick::X]    = true; break;
-            case ABS_Y:        caps.axes[Joystick::Y]    = true; break;
-            case ABS_Z:
-            case ABS_THROTTLE: caps.axes[Joystick::Z]    = true; break;
-            case ABS_RZ:
-            case ABS_RUDDER:   caps.axes[Joystick::R]    = true; break;
-            case ABS_RX:       caps.axes[Joystick::U]    = true; break;
-            case ABS_RY:       caps.axes[Joystick::V]    = true; break;
-            case ABS_HAT0X:    caps.axes[Joystick::PovX] = true; break;
-            case ABS_HAT0Y:    caps.axes[Joystick::PovY] = true; break;
-            default:           break;
-        }
-    }
-
-    return caps;
+    return m_capabilities;
 }
 
 
@@ -647,50 +797,45 @@ JoystickState JoystickImpl::JoystickImpl::update()
         return m_state;
     }
 
-    // pop events from the joystick file
-    js_event joyState;
-    int result = read(m_file, &joyState, sizeof(joyState));
+    // pop events from the joystick file, a batch at a time
+    input_event events[32];
+    bool eventsDropped = false;
+    int result = read(m_file, events, sizeof(events));
     while (result > 0)
     {
-        switch (joyState.type & ~JS_EVENT_INIT)
+        Time readTime = m_monotonicTime ? Time::Zero : Clock::getCurrentTime();
+
+        int count = result / static_cast<int>(sizeof(input_event));
+        for (int i = 0; i < count; ++i)
         {
-            // An axis was moved
-            case JS_EVENT_AXIS:
-            {
-                float value = joyState.value * 100.f / 32767.f;
+            const input_event& event = events[i];
 
-                if (joyState.number < ABS_MAX + 1)
+            if ((event.type == EV_SYN) && (event.code == SYN_DROPPED))
+            {
+                // The kernel buffer overflowed: ignore the events until the
+                // next report, and read the whole state instead
+                eventsDropped = true;
+            }
+            else if (eventsDropped)
+            {
+                if ((event.type == EV_SYN) && (event.code == SYN_REPORT))
                 {
-                    switch (m_mapping[joyState.number])
-                    {
-                        case ABS_X:        m_state.axes[Joystick::X]    = value; break;
-                        case ABS_Y:        m_state.axes[Joystick::Y]    = value; break;
-                        case ABS_Z:
-                        case ABS_THROTTLE: m_state.axes[Joystick::Z]    = value; break;
-                        case ABS_RZ:
-                        case ABS_RUDDER:   m_state.axes[Joystick::R]    = value; break;
-                        case ABS_RX:       m_state.axes[Joystick::U]    = value; break;
-                        case ABS_RY:       m_state.axes[Joystick::V]    = value; break;
-                        case ABS_HAT0X:    m_state.axes[Joystick::PovX] = value; break;
-                        case ABS_HAT0Y:    m_state.axes[Joystick::PovY] = value; break;
-                        default:           break;
-                    }
+                    synchronize();
+                    eventsDropped = false;
                 }
-                break;
             }
-
-            // A button was pressed
-            case JS_EVENT_BUTTON:
+            else
             {
-                if (joyState.number < Joystick::ButtonCount)
-                    m_state.buttons[joyState.number] = (joyState.value != 0);
-                break;
+                processEvent(event, m_monotonicTime ? getEventTime(event) : readTime);
             }
         }
 
-        result = read(m_file, &joyState, sizeof(joyState));
+        result = read(m_file, events, sizeof(events));
     }
 
+    if (eventsDropped)
+        synchronize();
+
     // Check the connection state of the joystick
     // read() returns -1 and errno != EGAIN if it's no longer connected
     // We need to check the result of read() as well, since errno could
@@ -703,6 +848,132 @@ JoystickState JoystickImpl::JoystickImpl::update()
     return m_state;
 }
 
+
+////////////////////////////////////////////////////////////
+bool JoystickImpl::setVibration(float strong, float weak, Time duration)
+{
+    if ((m_file < 0) || !m_rumbleSupported)
+        return false;
+
+    ff_effect effect;
+    std::memset(&effect, 0, sizeof(effect));
+    effect.type = FF_RUMBLE;
+    effect.id = static_cast<Int16>(m_effectId);
+    effect.u.rumble.strong_magnitude = static_cast<Uint16>(strong * 655.35f);
+    effect.u.rumble.weak_magnitude   = static_cast<Uint16>(weak * 655.35f);
+
+    // A null length plays the effect until it is stopped
+    if (duration > Time::Zero)
+        effect.replay.length = static_cast<Uint16>(std::min(std::max(duration.asMilliseconds(), 1), 0xFFFF));
+
+    // Upload the effect, or update the one uploaded by a previous call
+    if (ioctl(m_file, EVIOCSFF, &effect) < 0)
+    {
+        err() << "Failed to upload rumble effect to joystick: " << errno << std::endl;
+        return false;
+    }
+
+    m_effectId = effect.id;
+
+    // Start the effect, or stop it if both magnitudes are null
+    input_event play;
+    std::memset(&play, 0, sizeof(play));
+    play.type = EV_FF;
+    play.code = static_cast<Uint16>(m_effectId);
+    play.value = ((strong > 0.f) || (weak > 0.f)) ? 1 : 0;
+
+    if (write(m_file, &play, sizeof(play)) != static_cast<ssize_t>(sizeof(play)))
+    {
+        err() << "Failed to play rumble effect on joystick: " << errno << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void JoystickImpl::processEvent(const input_event& event, Time time)
+{
+    if ((event.type == EV_ABS) && (event.code <= ABS_MAX))
+    {
+        int axis = m_axisMapping[event.code];
+        if (axis >= 0)
+        {
+            m_state.axes[axis] = normalizeAxis(axis, event.value);
+            m_state.axisTimes[axis] = time;
+        }
+    }
+    else if ((event.type == EV_KEY) && (event.code <= KEY_MAX) && (event.value != 2))
+    {
+        // Value 2 is an autorepeat, which doesn't change the state of the button
+        unsigned int button = m_buttonMapping[event.code];
+        if (button < Joystick::ButtonCount)
+        {
+            m_state.buttons[button] = (event.value != 0);
+            m_state.buttonTimes[button] = time;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void JoystickImpl::synchronize()
+{
+    Time now = Clock::getCurrentTime();
+
+    unsigned long keyStates[BITS_ARRAY_SIZE(KEY_MAX)];
+    std::memset(keyStates, 0, sizeof(keyStates));
+    if (ioctl(m_file, EVIOCGKEY(sizeof(keyStates)), keyStates) >= 0)
+    {
+        for (int code = 0; code <= KEY_MAX; ++code)
+        {
+            unsigned int button = m_buttonMapping[code];
+            bool pressed = testBit(keyStates, code);
+            if ((button < Joystick::ButtonCount) && (m_state.buttons[button] != pressed))
+            {
+                m_state.buttons[button] = pressed;
+                m_state.buttonTimes[button] = now;
+            }
+        }
+    }
+
+    for (int code = 0; code <= ABS_MAX; ++code)
+    {
+        int axis = m_axisMapping[code];
+        input_absinfo info;
+        if ((axis >= 0) && (ioctl(m_file, EVIOCGABS(code), &info) >= 0))
+        {
+            float position = normalizeAxis(axis, info.value);
+            if (m_state.axes[axis] != position)
+            {
+                m_state.axes[axis] = position;
+                m_state.axisTimes[axis] = now;
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float JoystickImpl::normalizeAxis(int axis, int value) const
+{
+    const input_absinfo& info = m_axisInfo[axis];
+
+    float center = (info.minimum + info.maximum) / 2.f;
+    float halfRange = (info.maximum - info.minimum) / 2.f;
+    float offset = value - center;
+    float distance = std::abs(offset);
+
+    // Positions in the dead zone are centered, the rest of the range is
+    // stretched so that the position doesn't jump at the edge of the zone
+    if (distance <= info.flat)
+        return 0.f;
+
+    float position = std::min((distance - info.flat) * 100.f / (halfRange - info.flat), 100.f);
+    return (offset < 0.f) ? -position : position;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickImpl.hpp>
 #include <linux/input.h>
+#include <vector>
 
 
 namespace sf
@@ -72,6 +73,30 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isConnected(unsigned int index);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the file descriptors that become readable on joystick activity
+    ///
+    /// A descriptor watching the opened joysticks and the udev
+    /// monitor is appended to \a descriptors, so that a caller
+    /// can wait for joystick events and connections with poll().
+    ///
+    /// \param descriptors Array to fill
+    ///
+    /// \return False if the connections can only be detected by polling
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getFileDescriptors(std::vector<int>& descriptors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check which joysticks have pending input, without blocking
+    ///
+    /// \param connectionsChanged Set to true if joysticks may have been connected or disconnected
+    ///
+    /// \return Bit mask of the opened joysticks that have pending input
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint32 pollChanges(bool& connectionsChanged);
+
     ////////////////////////////////////////////////////////////
     /// \brief Open the joystick
     ///
@@ -112,15 +137,62 @@ public:
     ////////////////////////////////////////////////////////////
     JoystickState update();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the joystick vibrate with a rumble effect
+    ///
+    /// \param strong   Magnitude of the strong motor, in range [0 .. 100]
+    /// \param weak     Magnitude of the weak motor, in range [0 .. 100]
+    /// \param duration Duration of the vibration, Time::Zero for no limit
+    ///
+    /// \return True on success, false if the joystick can't vibrate
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setVibration(float strong, float weak, Time duration);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply an event read from the device to the state
+    ///
+    /// \param event Event to process
+    /// \param time  Time at which the event happened
+    ///
+    ////////////////////////////////////////////////////////////
+    void processEvent(const input_event& event, Time time);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the current state of all the axes and buttons
+    ///
+    /// This is needed when the joystick is opened, and when
+    /// events were dropped by the kernel.
+    ///
+    ////////////////////////////////////////////////////////////
+    void synchronize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the raw value of an axis to the range [-100, 100]
+    ///
+    /// \param axis  Axis
+    /// \param value Raw value reported by the device
+    ///
+    /// \return Position of the axis, with the dead zone removed
+    ///
+    ////////////////////////////////////////////////////////////
+    float normalizeAxis(int axis, int value) const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    int                          m_file;                 ///< File descriptor of the joystick
-    char                         m_mapping[ABS_MAX + 1]; ///< Axes mapping (index to axis id)
-    JoystickState                m_state;                ///< Current state of the joystick
-    sf::Joystick::Identification m_identification;       ///< Identification of the joystick
+    int                          m_file;                          ///< File descriptor of the joystick
+    int                          m_axisMapping[ABS_MAX + 1];      ///< Axis of each absolute axis code, -1 if it's not mapped
+    Uint8                        m_buttonMapping[KEY_MAX + 1];    ///< Button of each key code, Joystick::ButtonCount if it's not mapped
+    input_absinfo                m_axisInfo[Joystick::AxisCount]; ///< Range and flat (dead zone) of each axis
+    JoystickCaps                 m_capabilities;                  ///< Capabilities of the joystick
+    JoystickState                m_state;                         ///< Current state of the joystick
+    sf::Joystick::Identification m_identification;                ///< Identification of the joystick
+    bool                         m_monotonicTime;                 ///< Are the events stamped with the clock of sf::Clock?
+    bool                         m_rumbleSupported;               ///< Does the device support rumble effects?
+    int                          m_effectId;                      ///< Identifier of the rumble effect uploaded to the device, -1 if none
 };
 
 } // namespace priv
@@ -29,6 +29,7 @@
 #include <SFML/Window/Unix/WindowImplX11.hpp>
 #include <SFML/Window/Unix/Display.hpp>
 #include <SFML/Window/Unix/InputImpl.hpp>
+#include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/System/Utf.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/System/Mutex.hpp>
@@ -44,6 +45,7 @@
 #include <unistd.h>
 #include <libgen.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <algorithm>
 #include <vector>
 #include <string>
@@ -672,6 +674,43 @@ void WindowImplX11::processEvents()
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplX11::waitForEvents(Time timeout)
+{
+    // Send the pending requests, the server may not reply until then
+    XFlush(m_display);
+
+    // Events of other windows sharing the display may already have been
+    // read from the connection, which would then not become readable
+    bool mustPoll = (XEventsQueued(m_display, QueuedAlready) > 0);
+
+    std::vector<int> descriptors(1, ConnectionNumber(m_display));
+
+#if defined(SFML_SYSTEM_LINUX)
+    if (!JoystickImpl::getFileDescriptors(descriptors))
+        mustPoll = true;
+#else
+    // The joysticks can only be polled
+    mustPoll = true;
+#endif
+
+    if (mustPoll && ((timeout < Time::Zero) || (timeout > milliseconds(10))))
+        timeout = milliseconds(10);
+
+    std::vector<pollfd> fds(descriptors.size());
+    for (std::size_t i = 0; i < descriptors.size(); ++i)
+    {
+        fds[i].fd = descriptors[i];
+        fds[i].events = POLLIN;
+        fds[i].revents = 0;
+    }
+
+    // Round up, so that the deadline is not reached by spinning on a null timeout
+    int milliseconds = (timeout < Time::Zero) ? -1 : static_cast<int>((timeout.asMicroseconds() + 999) / 1000);
+    poll(&fds[0], fds.size(), milliseconds);
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i WindowImplX11::getPosition() const
 {
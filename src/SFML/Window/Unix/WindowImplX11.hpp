@@ -185,6 +185,14 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the X server connection or the joysticks are ready
+    ///
+    /// \param timeout Maximum time to wait, negative to wait without limit
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitForEvents(Time timeout);
+
 private:
 
     ////////////////////////////////////////////////////////////
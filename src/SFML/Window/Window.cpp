@@ -30,6 +30,8 @@
 #include <SFML/Window/WindowImpl.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <algorithm>
 
 
 namespace
@@ -209,6 +211,51 @@ bool Window::waitEvent(Event& event)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Window::waitEvent(Event& event, Time timeout)
+{
+    if (m_impl && m_impl->popEvent(event, std::max(timeout, Time::Zero)))
+    {
+        return filterEvent(event);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::setEventCompressionEnabled(bool enabled)
+{
+    if (m_impl)
+        m_impl->setEventCompressionEnabled(enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<Event>& Window::getEventHistory() const
+{
+    static const std::vector<Event> empty;
+
+    return m_impl ? m_impl->getEventHistory() : empty;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Window::getPendingEventCount() const
+{
+    return m_impl ? m_impl->getPendingEventCount() : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Window::getDroppedEventCount() const
+{
+    return m_impl ? m_impl->getDroppedEventCount() : 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i Window::getPosition() const
 {
@@ -373,6 +420,8 @@ void Window::display()
         sleep(m_frameTimeLimit - m_clock.getElapsedTime());
         m_clock.restart();
     }
+
+    SFML_PROFILE_FRAME();
 }
 
 
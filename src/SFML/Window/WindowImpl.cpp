@@ -29,6 +29,7 @@
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/JoystickManager.hpp>
 #include <SFML/Window/SensorManager.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <algorithm>
 #include <cmath>
@@ -66,6 +67,13 @@
 #endif
 
 
+namespace
+{
+    // Maximum number of events merged into a single one that are kept in its history
+    const std::size_t maxHistorySize = 1024;
+}
+
+
 namespace sf
 {
 namespace priv
@@ -86,12 +94,16 @@ WindowImpl* WindowImpl::create(WindowHandle handle)
 
 ////////////////////////////////////////////////////////////
 WindowImpl::WindowImpl() :
+m_eventCompression (false),
 m_joystickThreshold(0.1f)
 {
     // Get the initial joystick states
     JoystickManager::getInstance().update();
     for (unsigned int i = 0; i < Joystick::Count; ++i)
+    {
         m_joystickStates[i] = JoystickManager::getInstance().getState(i);
+        m_joystickChanges[i] = JoystickManager::getInstance().getChangeCount(i);
+    }
 
     // Get the initial sensor states
     for (unsigned int i = 0; i < Sensor::Count; ++i)
@@ -113,8 +125,50 @@ void WindowImpl::setJoystickThreshold(float threshold)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImpl::setEventCompressionEnabled(bool enabled)
+{
+    m_eventCompression = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<Event>& WindowImpl::getEventHistory() const
+{
+    return m_eventHistory;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t WindowImpl::getPendingEventCount() const
+{
+    return m_events.size() + getSystemPendingEventCount();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 WindowImpl::getDroppedEventCount() const
+{
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t WindowImpl::getSystemPendingEventCount() const
+{
+    return 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool WindowImpl::popEvent(Event& event, bool block)
+{
+    return popEvent(event, block ? microseconds(-1) : Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::popEvent(Event& event, Time timeout)
 {
     // If the event queue is empty, let's first check if new events are available from the OS
     if (m_events.empty())
@@ -125,14 +179,31 @@ bool WindowImpl::popEvent(Event& event, bool block)
         processEvents();
 
         // In blocking mode, we must process events until one is triggered
-        if (block)
+        if (timeout != Time::Zero)
         {
-            // Here we use a manual wait loop instead of the optimized
-            // wait-event provided by the OS, so that we don't skip joystick
-            // events (which require polling)
+            Clock clock;
             while (m_events.empty())
             {
-                sleep(milliseconds(10));
+                Time remaining = timeout;
+                if (timeout > Time::Zero)
+                {
+                    remaining = timeout - clock.getElapsedTime();
+                    if (remaining <= Time::Zero)
+                        break;
+                }
+
+                // The sensors can only be polled
+                for (unsigned int i = 0; i < Sensor::Count; ++i)
+                {
+                    if (SensorManager::getInstance().isEnabled(static_cast<Sensor::Type>(i)))
+                    {
+                        if ((remaining < Time::Zero) || (remaining > milliseconds(10)))
+                            remaining = milliseconds(10);
+                        break;
+                    }
+                }
+
+                waitForEvents(remaining);
                 processJoystickEvents();
                 processSensorEvents();
                 processEvents();
@@ -143,8 +214,17 @@ bool WindowImpl::popEvent(Event& event, bool block)
     // Pop the first event of the queue, if it is not empty
     if (!m_events.empty())
     {
-        event = m_events.front();
-        m_events.pop();
+        // Keep the storage of the previous history, for the next merged events
+        QueuedEvent& front = m_events.front();
+        event = front.event;
+        m_eventHistory.swap(front.history);
+        if (front.history.capacity() > 0)
+        {
+            front.history.clear();
+            m_spareHistories.push_back(std::vector<Event>());
+            m_spareHistories.back().swap(front.history);
+        }
+        m_events.pop_front();
 
         return true;
     }
@@ -156,7 +236,49 @@ bool WindowImpl::popEvent(Event& event, bool block)
 ////////////////////////////////////////////////////////////
 void WindowImpl::pushEvent(const Event& event)
 {
-    m_events.push(event);
+    Event stampedEvent = event;
+
+    // The events not stamped by the implementation are stamped when they are received
+    if (stampedEvent.timestamp == Time::Zero)
+        stampedEvent.timestamp = Clock::getCurrentTime();
+
+    // A motion event replaces the last one of the same kind, if no other event
+    // was pushed after it; pending moves of other fingers are skipped since
+    // their order doesn't matter
+    if (m_eventCompression && ((event.type == Event::MouseMoved) || (event.type == Event::TouchMoved)))
+    {
+        for (std::deque<QueuedEvent>::reverse_iterator it = m_events.rbegin(); (it != m_events.rend()) && (it->event.type == event.type); ++it)
+        {
+            if ((event.type == Event::MouseMoved) || (it->event.touch.finger == event.touch.finger))
+            {
+                if ((it->history.capacity() == 0) && !m_spareHistories.empty())
+                {
+                    it->history.swap(m_spareHistories.back());
+                    m_spareHistories.pop_back();
+                }
+
+                if (it->history.size() < maxHistorySize)
+                    it->history.push_back(it->event);
+
+                it->event = stampedEvent;
+                return;
+            }
+        }
+    }
+
+    m_events.push_back(QueuedEvent());
+    m_events.back().event = stampedEvent;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::waitForEvents(Time timeout)
+{
+    // Without a way to wait for the system events, poll them regularly
+    if ((timeout < Time::Zero) || (timeout > milliseconds(10)))
+        timeout = milliseconds(10);
+
+    sleep(timeout);
 }
 
 
@@ -168,10 +290,17 @@ void WindowImpl::processJoystickEvents()
 
     for (unsigned int i = 0; i < Joystick::Count; ++i)
     {
+        // Skip the joysticks whose state has not changed since the last comparison
+        Uint32 changeCount = JoystickManager::getInstance().getChangeCount(i);
+        if (changeCount == m_joystickChanges[i])
+            continue;
+
+        m_joystickChanges[i] = changeCount;
+
         // Copy the previous state of the joystick and get the new one
         JoystickState previousState = m_joystickStates[i];
         m_joystickStates[i] = JoystickManager::getInstance().getState(i);
-        JoystickCaps caps = JoystickManager::getInstance().getCapabilities(i);
+        const JoystickCaps& caps = JoystickManager::getInstance().getCapabilities(i);
 
         // Connection state
         bool connected = m_joystickStates[i].connected;
@@ -200,6 +329,7 @@ void WindowImpl::processJoystickEvents()
                         event.joystickMove.joystickId = i;
                         event.joystickMove.axis = axis;
                         event.joystickMove.position = currPos;
+                        event.timestamp = m_joystickStates[i].axisTimes[axis];
                         pushEvent(event);
                     }
                 }
@@ -217,6 +347,7 @@ void WindowImpl::processJoystickEvents()
                     event.type = currPressed ? Event::JoystickButtonPressed : Event::JoystickButtonReleased;
                     event.joystickButton.joystickId = i;
                     event.joystickButton.button = j;
+                    event.timestamp = m_joystickStates[i].buttonTimes[j];
                     pushEvent(event);
                 }
             }
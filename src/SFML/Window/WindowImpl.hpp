@@ -31,6 +31,7 @@
 #include <SFML/Config.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Time.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/Joystick.hpp>
 #include <SFML/Window/JoystickImpl.hpp>
@@ -39,8 +40,9 @@
 #include <SFML/Window/VideoMode.hpp>
 #include <SFML/Window/WindowHandle.hpp>
 #include <SFML/Window/ContextSettings.hpp>
-#include <queue>
+#include <deque>
 #include <set>
+#include <vector>
 
 namespace sf
 {
@@ -96,6 +98,44 @@ public:
     ////////////////////////////////////////////////////////////
     void setJoystickThreshold(float threshold);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the merging of motion events
+    ///
+    /// \param enabled True to merge the consecutive motion events
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEventCompressionEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the events merged into the last returned event
+    ///
+    /// \return Merged events, oldest first
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Event>& getEventHistory() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of events waiting in the queue
+    ///
+    /// This includes the events buffered by the system, see
+    /// getSystemPendingEventCount.
+    ///
+    /// \return Number of pending events
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingEventCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of events lost by the system
+    ///
+    /// The default implementation returns 0, for the systems
+    /// that never drop events.
+    ///
+    /// \return Number of dropped events
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 getDroppedEventCount() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the next window event available
     ///
@@ -112,6 +152,19 @@ public:
     ////////////////////////////////////////////////////////////
     bool popEvent(Event& event, bool block);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the next window event available, waiting
+    ///        for it at most for a given time
+    ///
+    /// \param event   Event to be returned
+    /// \param timeout Maximum time to wait; Time::Zero doesn't wait,
+    ///                and a negative time waits until an event arrives
+    ///
+    /// \return True if an event was returned, false if the timeout expired
+    ///
+    ////////////////////////////////////////////////////////////
+    bool popEvent(Event& event, Time timeout);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the OS-specific handle of the window
     ///
@@ -230,7 +283,9 @@ protected:
     ///
     /// This function is to be used by derived classes, to
     /// notify the SFML window that a new event was triggered
-    /// by the system.
+    /// by the system. Events with a null timestamp are stamped
+    /// with the current time. When compression is enabled, a
+    /// motion event replaces the pending one of the same kind.
     ///
     /// \param event Event to push
     ///
@@ -243,6 +298,32 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents() = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until new events may be available
+    ///
+    /// This function is called by popEvent in blocking mode when
+    /// the event queue is empty; it may return early, without
+    /// any event. The default implementation sleeps for at most
+    /// 10 milliseconds; the implementations should rather wait
+    /// for their input sources to become ready.
+    ///
+    /// \param timeout Maximum time to wait, negative to wait without limit
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitForEvents(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of events received from the system
+    ///        but not yet pushed to the window
+    ///
+    /// The default implementation returns 0, for the systems
+    /// that don't buffer events before processEvents is called.
+    ///
+    /// \return Number of events buffered by the system
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual std::size_t getSystemPendingEventCount() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -257,13 +338,27 @@ private:
     ////////////////////////////////////////////////////////////
     void processSensorEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Event waiting in the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    struct QueuedEvent
+    {
+        Event              event;   ///< The event
+        std::vector<Event> history; ///< Older events merged into it, oldest first
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::queue<Event> m_events;                          ///< Queue of available events
-    JoystickState     m_joystickStates[Joystick::Count]; ///< Previous state of the joysticks
-    Vector3f          m_sensorValue[Sensor::Count];      ///< Previous value of the sensors
-    float             m_joystickThreshold;               ///< Joystick threshold (minimum motion for "move" event to be generated)
+    std::deque<QueuedEvent>          m_events;                           ///< Queue of available events
+    std::vector<Event>               m_eventHistory;                     ///< Events merged into the last popped event
+    std::vector<std::vector<Event> > m_spareHistories;                   ///< Emptied histories, whose storage is reused by the next merges
+    bool                             m_eventCompression;                 ///< Are the motion events merged?
+    JoystickState                    m_joystickStates[Joystick::Count];  ///< Previous state of the joysticks
+    Uint32                           m_joystickChanges[Joystick::Count]; ///< Change counts of the joysticks when their state was last compared
+    Vector3f                         m_sensorValue[Sensor::Count];       ///< Previous value of the sensors
+    float                            m_joystickThreshold;                ///< Joystick threshold (minimum motion for "move" event to be generated)
 };
 
 } // namespace priv